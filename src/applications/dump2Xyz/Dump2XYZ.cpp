@@ -42,13 +42,16 @@
  
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <algorithm>
 
 #include "Dump2XYZCmd.hpp"
 #include "brains/Register.hpp"
 #include "brains/SimCreator.hpp"
 #include "brains/SimInfo.hpp"
 #include "brains/ForceManager.hpp"
+#include "brains/RigidBodyBatch.hpp"
 #include "io/DumpReader.hpp"
 #include "utils/simError.h"
 #include "visitors/AtomVisitor.hpp"
@@ -62,48 +65,44 @@
 #include "visitors/LipidTransVisitor.hpp"
 #include "visitors/AtomNameVisitor.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMD;
 
 using namespace std;
-int main(int argc, char* argv[]){
-  
-  gengetopt_args_info args_info;
-  string dumpFileName;
-  string xyzFileName;
 
-  bool printVel(false);
-  bool printFrc(false);
-  bool printVec(false);
-  bool printChrg(false);
-  bool printField(false);
-  bool printGlobalID(false);
-  
-  //parse the command line option
-  if (cmdline_parser (argc, argv, &args_info) != 0) {
-    exit(1) ;
-  }
-  
-  //get the dumpfile name and meta-data file name
-  if (args_info.input_given){
-    dumpFileName = args_info.input_arg;
-  } else {
-    strcpy( painCave.errMsg,
-            "No input file name was specified.\n" );
-    painCave.isFatal = 1;
-    simError();
-  }
-  
-  if (args_info.output_given){
-    xyzFileName = args_info.output_arg;
-  } else {
-    xyzFileName = dumpFileName;
-    xyzFileName = xyzFileName.substr(0, xyzFileName.rfind(".")) + ".xyz";
-  }
-  
+/**
+ * Everything needed to turn one frame of the dump file into xyz
+ * text.  The visitors attach their data to the atoms of the SimInfo
+ * they were built with, so each worker thread owns a complete copy
+ * of the system, its own reader, and its own visitor chain.
+ */
+struct FrameConverter {
+  SimInfo* info;
+  DumpReader* dumpReader;
+  ForceManager* forceMan;
+  CompositeVisitor* compositeVisitor;
+  XYZVisitor* xyzVisitor;
+  PrepareVisitor* prepareVisitor;
+  RigidBodyBatch* rbBatch;
+};
+
+FrameConverter* createConverter(const string& dumpFileName,
+                                gengetopt_args_info& args_info) {
+  FrameConverter* fc = new FrameConverter;
+
   //parse md file and set up the system
   SimCreator creator;
-  SimInfo* info = creator.createSim(dumpFileName, false);
-  ForceManager* forceMan = new ForceManager(info);
+  fc->info = creator.createSim(dumpFileName, false);
+  SimInfo* info = fc->info;
+
+  fc->forceMan = NULL;
+  if (args_info.forces_flag) {
+    fc->forceMan = new ForceManager(info);
+    fc->forceMan->initialize();
+  }
   
   //create visitor list
   CompositeVisitor* compositeVisitor = new CompositeVisitor();
@@ -134,7 +133,7 @@ int main(int argc, char* argv[]){
   if (!args_info.water_given) {
     //create waterType visitor
     if(args_info.watertype_flag){
-      WaterTypeVisitor* waterTypeVisitor = new WaterTypeVisitor;
+      WaterTypeVisitor* waterTypeVisitor = new WaterTypeVisitor(info);
       compositeVisitor->addVisitor(waterTypeVisitor, 600);
     }
   } 
@@ -200,128 +199,177 @@ int main(int argc, char* argv[]){
     xyzVisitor = new XYZVisitor(info);
   }
 
-  if(args_info.velocities_flag){
-    printVel = true;
-    xyzVisitor->doVelocities(printVel);
-  }
-  if(args_info.forces_flag){
-    printFrc = true;
-    xyzVisitor->doForces(printFrc);
-  }
-  if(args_info.vectors_flag){
-    printVec = true;
-    xyzVisitor->doVectors(printVec);
-  }
-  if(args_info.charges_flag){
-    printChrg = true;
-    xyzVisitor->doCharges(printChrg);
-  }
-  if(args_info.efield_flag){
-    printField = true;
-    xyzVisitor->doElectricFields(printField);
-  }
-  if(args_info.globalID_flag){
-    printGlobalID = true;
-    xyzVisitor->doGlobalIDs(printGlobalID);
-  }
+  xyzVisitor->doVelocities(args_info.velocities_flag);
+  xyzVisitor->doForces(args_info.forces_flag);
+  xyzVisitor->doVectors(args_info.vectors_flag);
+  xyzVisitor->doCharges(args_info.charges_flag);
+  xyzVisitor->doElectricFields(args_info.efield_flag);
+  xyzVisitor->doGlobalIDs(args_info.globalID_flag);
 
   compositeVisitor->addVisitor(xyzVisitor, 200); 
+
+  fc->compositeVisitor = compositeVisitor;
+  fc->xyzVisitor = xyzVisitor;
   
   //create prepareVisitor
-  PrepareVisitor* prepareVisitor = new PrepareVisitor();
+  fc->prepareVisitor = new PrepareVisitor(info);
   
   //open dump file
-  DumpReader* dumpReader = new DumpReader(info, dumpFileName);
-  int nframes = dumpReader->getNFrames();
-  
-  ofstream xyzStream(xyzFileName.c_str());
-  
+  fc->dumpReader = new DumpReader(info, dumpFileName);
+
+  fc->rbBatch = new RigidBodyBatch(info);
+  fc->rbBatch->build();
+
+  return fc;
+}
+
+void deleteConverter(FrameConverter* fc) {
+  delete fc->dumpReader;
+  delete fc->rbBatch;
+  delete fc->prepareVisitor;
+  delete fc->compositeVisitor;
+  delete fc->forceMan;
+  delete fc->info;
+  delete fc;
+}
+
+// Reads, visits and formats one frame; the xyz text ends up in os.
+void convertFrame(FrameConverter* fc, int whichFrame,
+                  gengetopt_args_info& args_info, std::ostream& os) {
+  SimInfo* info = fc->info;
   SimInfo::MoleculeIterator miter;
   Molecule::IntegrableObjectIterator  iiter;
-  Molecule::RigidBodyIterator rbIter;
   Molecule* mol;
   StuntDouble* sd;
-  RigidBody* rb;
   Vector3d molCom;
   Vector3d newMolCom;
   Vector3d displacement;
-  Mat3x3d hmat;
   Snapshot* currentSnapshot;
-       
-  for (int i = 0; i < nframes; i += args_info.frame_arg){
-    dumpReader->readFrame(i);
+
+  fc->dumpReader->readFrame(whichFrame);
     
-    if (printFrc) forceMan->calcForces();
+  if (fc->forceMan != NULL) fc->forceMan->calcForces();
     
-    //wrapping the molecule
-    if(args_info.periodicBox_flag) {
-      currentSnapshot = info->getSnapshotManager()->getCurrentSnapshot();    
-      for (mol = info->beginMolecule(miter); mol != NULL; 
-           mol = info->nextMolecule(miter)) {
+  //wrapping the molecule
+  if(args_info.periodicBox_flag) {
+    currentSnapshot = info->getSnapshotManager()->getCurrentSnapshot();    
+    for (mol = info->beginMolecule(miter); mol != NULL; 
+         mol = info->nextMolecule(miter)) {
         
-        molCom = mol->getCom();
-        newMolCom = molCom;
-        currentSnapshot->wrapVector(newMolCom);
-        displacement = newMolCom - molCom;
+      molCom = mol->getCom();
+      newMolCom = molCom;
+      currentSnapshot->wrapVector(newMolCom);
+      displacement = newMolCom - molCom;
 
-        for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-             sd = mol->nextIntegrableObject(iiter)) {  
+      for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
+           sd = mol->nextIntegrableObject(iiter)) {  
 
-          sd->setPos(sd->getPos() + displacement);
+        sd->setPos(sd->getPos() + displacement);
           
-        }
-      }    
-    }
+      }
+    }    
+  }
 
-    //update atoms of rigidbody
-    for (mol = info->beginMolecule(miter); mol != NULL; 
-         mol = info->nextMolecule(miter)) {
-      
-      //change the positions of atoms which belong to the rigidbodies
-      for (rb = mol->beginRigidBody(rbIter); rb != NULL; 
-           rb = mol->nextRigidBody(rbIter)) {
+  //update atoms of rigidbody
+  fc->rbBatch->updateAtoms();
+  if (args_info.velocities_flag) fc->rbBatch->updateAtomVel();
+    
+  //discard the sites of the previous frame
+  fc->prepareVisitor->update();
+    
+  //update visitor
+  fc->compositeVisitor->update();
 
-        rb->updateAtoms();
-        if (printVel) rb->updateAtomVel();
 
-      }
-    }
-    
-    //prepare visit
-    for (mol = info->beginMolecule(miter); mol != NULL; 
-         mol = info->nextMolecule(miter)) {
+  //visit stuntdouble
+  for (mol = info->beginMolecule(miter); mol != NULL; 
+       mol = info->nextMolecule(miter)) {
 
-      for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-           sd = mol->nextIntegrableObject(iiter)) {
+    for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
+         sd = mol->nextIntegrableObject(iiter)) {
 
-        sd->accept(prepareVisitor);
+      sd->accept(fc->compositeVisitor);
 
-      }
     }
+  }
     
-    //update visitor
-    compositeVisitor->update();
+  fc->xyzVisitor->writeFrame(os);
+  fc->xyzVisitor->clear();
+}
+
+int main(int argc, char* argv[]){
+  
+  gengetopt_args_info args_info;
+  string dumpFileName;
+  string xyzFileName;
+  
+  //parse the command line option
+  if (cmdline_parser (argc, argv, &args_info) != 0) {
+    exit(1) ;
+  }
+  
+  //get the dumpfile name and meta-data file name
+  if (args_info.input_given){
+    dumpFileName = args_info.input_arg;
+  } else {
+    strcpy( painCave.errMsg,
+            "No input file name was specified.\n" );
+    painCave.isFatal = 1;
+    simError();
+  }
+  
+  if (args_info.output_given){
+    xyzFileName = args_info.output_arg;
+  } else {
+    xyzFileName = dumpFileName;
+    xyzFileName = xyzFileName.substr(0, xyzFileName.rfind(".")) + ".xyz";
+  }
 
+  if (args_info.frame_arg < 1) {
+    strcpy( painCave.errMsg,
+            "The frame stride (-n) must be at least 1.\n" );
+    painCave.isFatal = 1;
+    simError();
+  }
 
-    //visit stuntdouble
-    for (mol = info->beginMolecule(miter); mol != NULL; 
-         mol = info->nextMolecule(miter)) {
+  FrameConverter* master = createConverter(dumpFileName, args_info);
+  int nframes = master->dumpReader->getNFrames();
+  int stride = args_info.frame_arg;
+  int nOutput = (nframes + stride - 1) / stride;
 
-      for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-           sd = mol->nextIntegrableObject(iiter)) {
+  // Frames are read, visited and formatted concurrently, one frame
+  // per worker at a time, and appended to the xyz file in their
+  // original order.  Every worker shares the master's frame index so
+  // the dump file is only scanned once.
+  int nWorkers = 1;
+#ifdef _OPENMP
+  nWorkers = std::max(1, std::min(omp_get_max_threads(), nOutput));
+#endif
+  std::vector<FrameConverter*> workers(nWorkers, master);
+  for (int w = 1; w < nWorkers; w++) {
+    workers[w] = createConverter(dumpFileName, args_info);
+    workers[w]->dumpReader->setFrameIndex(master->dumpReader->getFrameIndex());
+  }
+  
+  ofstream xyzStream(xyzFileName.c_str());
 
-        sd->accept(compositeVisitor);
+#pragma omp parallel for ordered schedule(static, 1) num_threads(nWorkers)
+  for (int k = 0; k < nOutput; k++) {
+    int w = 0;
+#ifdef _OPENMP
+    w = omp_get_thread_num();
+#endif
+    std::ostringstream frameText;
+    convertFrame(workers[w], k * stride, args_info, frameText);
 
-      }
-    }
-    
-    xyzVisitor->writeFrame(xyzStream);
-    xyzVisitor->clear();
-    
-  }//end for (int i = 0; i < nframes; i += args_info.frame_arg)
+#pragma omp ordered
+    xyzStream << frameText.str();
+  }
  
   xyzStream.close();
-  delete prepareVisitor; 
-  delete compositeVisitor;
-  delete info;
+
+  for (int w = 1; w < nWorkers; w++) {
+    deleteConverter(workers[w]);
+  }
+  deleteConverter(master);
 }
@@ -112,6 +112,9 @@ namespace OpenMD {
 
       for (int j = i; j < nblocks; ++j) {
 	bsMan_->loadBlock(j);
+	// start reading the block the next pass will need while this
+	// pair is being correlated:
+	bsMan_->prefetchBlock(j + 1 < nblocks ? j + 1 : i + 1);
 	correlateBlocks(i, j);
 	bsMan_->unloadBlock(j);
       }
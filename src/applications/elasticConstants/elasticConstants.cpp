@@ -71,6 +71,10 @@
 #include "optimization/Problem.hpp"
 #include "optimization/BoxObjectiveFunction.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMD;
 using namespace JAMA;
 #include <algorithm>
@@ -388,6 +392,156 @@ void writeMaterialProperties(DynamicRectMatrix<RealType> C,
   //RealType kT_111 = (C11 - C12 + C44) / 3.0;
    
 }
+/**
+ * Everything needed to evaluate the energy or stress of one strained
+ * configuration.  Each worker thread owns a complete copy of the
+ * system so that strain states can be evaluated independently.
+ */
+struct StrainEvaluator {
+  SimInfo* info;
+  ForceManager* forceMan;
+  Shake* shake;
+  FluctuatingChargePropagator* flucQ;
+  Thermo* thermo;
+  bool hasFlucQ;
+};
+
+StrainEvaluator* createEvaluator(const std::string& inputFileName) {
+  StrainEvaluator* ev = new StrainEvaluator;
+
+  // Parse the input file, set up the system, and read the last frame:
+  SimCreator creator;
+  ev->info = creator.createSim(inputFileName, true);
+  ev->forceMan = new ForceManager(ev->info);
+
+  ev->forceMan->initialize();
+  ev->info->update();
+
+  ev->shake = new Shake(ev->info);
+  ev->hasFlucQ = false;
+  ev->flucQ = new FluctuatingChargeDamped(ev->info);
+
+  if (ev->info->usesFluctuatingCharges()) {
+    if (ev->info->getNFluctuatingCharges() > 0) {
+      ev->hasFlucQ = true;
+      ev->flucQ->setForceManager(ev->forceMan);
+      ev->flucQ->initialize();
+    }
+  }
+
+  // Important utility classes for computing system properties:
+  ev->thermo = new Thermo(ev->info);
+  return ev;
+}
+
+void deleteEvaluator(StrainEvaluator* ev) {
+  delete ev->thermo;
+  delete ev->flucQ;
+  delete ev->shake;
+  delete ev->forceMan;
+  delete ev->info;
+  delete ev;
+}
+
+// Copies the (possibly box-optimized) reference configuration from
+// one evaluator to another.  Both systems were created from the same
+// input file, so molecules and integrable objects appear in the same
+// order.
+void copyConfiguration(StrainEvaluator* from, StrainEvaluator* to) {
+  SimInfo::MoleculeIterator mi, mj;
+  Molecule::IntegrableObjectIterator ii, ij;
+  Molecule::AtomIterator ai, aj;
+  Molecule* mol1;
+  Molecule* mol2;
+  StuntDouble* sd1;
+  StuntDouble* sd2;
+  Atom* atom1;
+  Atom* atom2;
+
+  to->info->getSnapshotManager()->getCurrentSnapshot()->setHmat(from->info->getSnapshotManager()->getCurrentSnapshot()->getHmat());
+
+  for (mol1 = from->info->beginMolecule(mi), mol2 = to->info->beginMolecule(mj);
+       mol1 != NULL && mol2 != NULL;
+       mol1 = from->info->nextMolecule(mi), mol2 = to->info->nextMolecule(mj)) {
+
+    for (sd1 = mol1->beginIntegrableObject(ii), sd2 = mol2->beginIntegrableObject(ij);
+         sd1 != NULL && sd2 != NULL;
+         sd1 = mol1->nextIntegrableObject(ii), sd2 = mol2->nextIntegrableObject(ij)) {
+      sd2->setPos(sd1->getPos());
+      sd2->setVel(sd1->getVel());
+      if (sd1->isDirectional()) {
+        sd2->setA(sd1->getA());
+        sd2->setJ(sd1->getJ());
+      }
+      if (sd2->isRigidBody()) {
+        static_cast<RigidBody*>(sd2)->updateAtoms();
+      }
+    }
+
+    if (from->hasFlucQ) {
+      for (atom1 = mol1->beginAtom(ai), atom2 = mol2->beginAtom(aj);
+           atom1 != NULL && atom2 != NULL;
+           atom1 = mol1->nextAtom(ai), atom2 = mol2->nextAtom(aj)) {
+        atom2->setFlucQPos(atom1->getFlucQPos());
+      }
+    }
+  }
+  to->info->update();
+}
+
+// Deforms the reference configuration of one evaluator, computes the
+// energy or the Lagrangian stress, and restores the reference
+// configuration.
+void evaluateStrain(StrainEvaluator* ev, const Mat3x3d& deformation,
+                    const Mat3x3d& refHmat, bool useEnergy,
+                    RealType& energy, Vector6d& lstress) {
+  SimInfo* info = ev->info;
+  SimInfo::MoleculeIterator miter;
+  Molecule* mol;
+  Vector3d pos;
+  Vector3d delta;
+
+  info->getSnapshotManager()->advance();
+  Snapshot* snap = info->getSnapshotManager()->getCurrentSnapshot();
+  for (mol = info->beginMolecule(miter); mol != NULL;
+       mol = info->nextMolecule(miter)) {
+    pos = mol->getCom();
+    delta = deformation * pos;
+    mol->moveCom(delta - pos);
+  }
+  Mat3x3d Hmat = deformation * refHmat;
+  snap->setHmat(Hmat);
+  ev->shake->constraintR();
+  ev->forceMan->calcForces();
+  if (ev->hasFlucQ) ev->flucQ->applyConstraints();
+  ev->shake->constraintF();
+
+  if (useEnergy) {
+    energy = ev->thermo->getPotential();
+  } else {
+
+    // Find the Lagragian stress tensor, τ, from the physical
+    // stress tensor, σ, that was computed from the pressureTensor
+    // in this code.
+    // τ = det(1+ε) (1+ε)^−1 · σ · (1+ε)^−1
+    // (Note that 1+ε is the deformation tensor computed above.)
+
+    Mat3x3d idm = deformation.inverse();
+    RealType ddm = deformation.determinant();
+
+    Mat3x3d pressureTensor = ev->thermo->getPressureTensor();
+    pressureTensor.negate();
+    pressureTensor *= Constants::elasticConvert;
+
+    Mat3x3d tao = idm * (pressureTensor * idm);
+    tao *= ddm;
+
+    lstress = tao.toVoigtTensor();
+  }
+
+  info->getSnapshotManager()->resetToPrevious();
+}
+
 int main(int argc, char *argv []) {
   std::string method;
   std::string inputFileName;
@@ -569,30 +723,12 @@ int main(int argc, char *argv []) {
   //register forcefields, integrators and minimizers
   registerAll();
 
-  // Parse the input file, set up the system, and read the last frame:
-  SimCreator creator;
-  SimInfo* info = creator.createSim(inputFileName, true);
+  StrainEvaluator* master = createEvaluator(inputFileName);
+  SimInfo* info = master->info;
   Globals* simParams = info->getSimParams();
-  ForceManager* forceMan = new ForceManager(info);
+  ForceManager* forceMan = master->forceMan;
   Velocitizer* veloSet = new Velocitizer(info);
-
-  forceMan->initialize();
-  info->update();
-  
-  Shake* shake = new Shake(info);
-  bool hasFlucQ = false;
-  FluctuatingChargePropagator* flucQ = new FluctuatingChargeDamped(info);
-    
-  if (info->usesFluctuatingCharges()) {
-    if (info->getNFluctuatingCharges() > 0) {
-      hasFlucQ = true;
-      flucQ->setForceManager(forceMan);
-      flucQ->initialize();
-    }
-  }    
-  
-  // Important utility classes for computing system properties:
-  Thermo thermo(info);
+  Thermo& thermo = *(master->thermo);
 
   // Just in case we were passed a system that is on the move:
   veloSet->removeComDrift();
@@ -644,10 +780,7 @@ int main(int argc, char *argv []) {
   ptRef.negate();
   ptRef *= Constants::elasticConvert;
   
-  Vector6d stress(0.0);
   Vector6d strain(0.0);
-  Vector6d lstress(0.0);
-  Mat3x3d epsilon(0.0);
 
   std::vector<std::vector<RealType> > stressStrain;
   std::vector<RealType> strainValues;
@@ -657,34 +790,29 @@ int main(int argc, char *argv []) {
   DynamicVector<RealType> ci(21, 0.0);
   DynamicVector<RealType> sigma(36, 0.0);
   
-  Vector3d pos;
-  SimInfo::MoleculeIterator miter;
-  Molecule * mol;
   RealType de;
-  Vector3d delta;
-
   Vector6d L(0.0);
   Mat3x3d eta(0.0);
   Mat3x3d eps(0.0);
   Mat3x3d x(0.0);
   Mat3x3d test(0.0);
-  Mat3x3d deformation(0.0);
   std::vector<RealType> A2;
   RealType norm;
   RealType a, b, c;
-  RealType energy;
-  Mat3x3d pressureTensor;
-  
-  for(std::vector<Vector6d>::iterator it = strainBasis.begin();
-      it != strainBasis.end(); ++it) {
-    
-    strain = *it;
-    int ii = std::distance(strainBasis.begin(), it);
 
-    strainValues.clear();
-    energyValues.clear();
-    stressStrain.clear();
-    stressStrain.resize(6);
+  bool useEnergy = !method.compare("energy");
+
+  // Every (strain, magnitude) pair is an independent deformation of
+  // the reference configuration.  Set up all of the deformation
+  // tensors first, so that the evaluations can be farmed out.
+  int nStrains = strainBasis.size();
+  int nTasks = nStrains * nMax;
+  std::vector<Mat3x3d> deformations(nTasks);
+  std::vector<RealType> taskEnergy(nTasks, 0.0);
+  std::vector<Vector6d> taskStress(nTasks, Vector6d(0.0));
+
+  for (int ii = 0; ii < nStrains; ii++) {
+    strain = strainBasis[ii];
     
     for (int n = 0; n < nMax; n++) {
 
@@ -710,61 +838,64 @@ int main(int argc, char *argv []) {
         norm = test.frobeniusNorm();       
         eps = x;
       }
-      deformation = SquareMatrix3<RealType>::identity() + eps;
-
-      // Second, do the deformation and compute the energy or stress
-      // tensor for this deformation:
-      info->getSnapshotManager()->advance();            
-      for (mol = info->beginMolecule(miter); mol != NULL; 
-           mol = info->nextMolecule(miter)) {
-        pos = mol->getCom();
-        delta = deformation * pos;
-        mol->moveCom(delta - pos);
-      }
-      Mat3x3d Hmat = deformation * refHmat;
-      snap->setHmat(Hmat);
-      shake->constraintR();
-      forceMan->calcForces();
-      if (hasFlucQ) flucQ->applyConstraints();
-      shake->constraintF();
-
-      // Third, record the energy or the stress:
-      if (!method.compare("energy")) {
-        energy = thermo.getPotential();
-        energyValues.push_back(energy);
+      deformations[ii*nMax + n] = SquareMatrix3<RealType>::identity() + eps;
+    }
+  }
 
-      } else {
-        
-        // Find the Lagragian stress tensor, τ, from the physical
-        // stress tensor, σ, that was computed from the pressureTensor
-        // in this code.       
-        // τ = det(1+ε) (1+ε)^−1 · σ · (1+ε)^−1
-        // (Note that 1+ε is the deformation tensor computed above.)
-
-        Mat3x3d idm = deformation.inverse();
-        RealType ddm = deformation.determinant();
-
-        pressureTensor = thermo.getPressureTensor();        
-        pressureTensor.negate();
-        pressureTensor *= Constants::elasticConvert;
-        
-        Mat3x3d tao = idm * (pressureTensor * idm);
-        tao *= ddm;                    
-        
-        lstress = tao.toVoigtTensor();
+  // Second, do the deformations and compute the energy or stress
+  // tensor for each one.  Every worker thread gets its own copy of
+  // the system, which starts from the master's reference
+  // configuration.
+  int nWorkers = 1;
+#ifdef _OPENMP
+  nWorkers = std::max(1, std::min(omp_get_max_threads(), nTasks));
+#endif
+  std::vector<StrainEvaluator*> workers(nWorkers, master);
+  if (nWorkers > 1) {
+    std::cout << "Evaluating " << nTasks << " strain states on "
+              << nWorkers << " threads\n\n";
+    for (int w = 1; w < nWorkers; w++) {
+      workers[w] = createEvaluator(inputFileName);
+      copyConfiguration(master, workers[w]);
+    }
+  }
 
+#pragma omp parallel for schedule(dynamic) num_threads(nWorkers)
+  for (int t = 0; t < nTasks; t++) {
+    int w = 0;
+#ifdef _OPENMP
+    w = omp_get_thread_num();
+#endif
+    evaluateStrain(workers[w], deformations[t], refHmat, useEnergy,
+                   taskEnergy[t], taskStress[t]);
+  }
+
+  for (int w = 1; w < nWorkers; w++) {
+    deleteEvaluator(workers[w]);
+  }
+
+  // Third, fit the energy vs. strain (quadratic) or stress
+  // vs. strain (linear) for each of the strains in the basis:
+  for (int ii = 0; ii < nStrains; ii++) {
+
+    strainValues.clear();
+    energyValues.clear();
+    stressStrain.clear();
+    stressStrain.resize(6);
+
+    for (int n = 0; n < nMax; n++) {
+      de = -0.5*dmax + dmax * RealType(n) / RealType(nMax-1);
+      strainValues.push_back(de);
+      if (useEnergy) {
+        energyValues.push_back(taskEnergy[ii*nMax + n]);
+      } else {
         for (int j = 0; j < 6; j++) {
-          stressStrain[j].push_back(lstress[j]);
+          stressStrain[j].push_back(taskStress[ii*nMax + n][j]);
         }
-
       }
-      
-      strainValues.push_back(de);
-      info->getSnapshotManager()->resetToPrevious();
     }
     
-    // Fit the energy vs. strain (quadratic)  or stress vs. strain (linear)
-    if (!method.compare("energy")) {
+    if (useEnergy) {
       quadraticFit(strainValues, energyValues, a, b, c);
       A2.push_back( a * Constants::energyElasticConvert / V0 );
     } else {
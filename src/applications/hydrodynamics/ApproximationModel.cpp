@@ -48,9 +48,10 @@
 #include "hydrodynamics/Sphere.hpp"
 #include "hydrodynamics/Ellipsoid.hpp"
 #include "applications/hydrodynamics/CompositeShape.hpp"
-#include "math/LU.hpp"
 #include "utils/simError.h"
 
+#include <algorithm>
+
 
 
 namespace OpenMD {
@@ -81,7 +82,7 @@ namespace OpenMD {
    *
    **/
   ApproximationModel::ApproximationModel(StuntDouble* sd, SimInfo* info) :
-    HydrodynamicsModel(sd, info){
+    HydrodynamicsModel(sd, info), solver_(hsCholesky) {
   }
 
   void ApproximationModel::init() {
@@ -106,6 +107,400 @@ namespace OpenMD {
     return true;
   }
 
+  /**
+   * Computes the 3x3 mobility tensor coupling beads i and j.  The
+   * return value classifies the pair: 0 for non-overlapping beads
+   * (or the self term), 1 for partially overlapping beads, 2 if bead
+   * j is inside bead i, and 3 if bead i is inside bead j.  The
+   * overlapping volume of the pair is added to volume_overlap.
+   */
+  int ApproximationModel::calcTij(std::vector<BeadParam>& beads,
+                                  std::size_t i, std::size_t j,
+                                  RealType viscosity, Mat3x3d& Tij,
+                                  RealType& volume_overlap) {
+    Mat3x3d I;
+    I(0, 0) = 1.0;
+    I(1, 1) = 1.0;
+    I(2, 2) = 1.0;
+
+    Tij = Mat3x3d(0.0);
+
+    if (i == j) {   //self interaction, there is no overlapping volume (volume_overlap)
+      RealType constant = 1.0 / (6.0 * Constants::PI * viscosity * beads[i].radius);
+      Tij(0, 0) = constant;
+      Tij(1, 1) = constant;
+      Tij(2, 2) = constant;
+      return 0;
+    }
+
+    //non-self interaction: divided in overlapping and non-overlapping beads; the transitions among them are continuous
+    Vector3d Rij = beads[i].pos - beads[j].pos;
+    RealType rij = Rij.length();
+    RealType rij2 = rij * rij;
+
+    if (rij >= (beads[i].radius + beads[j].radius)) {      //non-overlapping beads
+      RealType sumSigma2OverRij2 = ((beads[i].radius*beads[i].radius) +
+                                    (beads[j].radius*beads[j].radius)) / rij2;
+      Mat3x3d tmpMat;
+      tmpMat = outProduct(Rij, Rij) / rij2;
+      RealType constant = 8.0 * Constants::PI * viscosity * rij;
+      RealType tmp1 = 1.0 + sumSigma2OverRij2/3.0;
+      RealType tmp2 = 1.0 - sumSigma2OverRij2;
+      Tij = (tmp1 * I + tmp2 * tmpMat ) / constant;
+      return 0;
+    }
+
+    //overlapping beads, part I
+    if ( rij > fabs(beads[i].radius - beads[j].radius) ) {
+      RealType sum_sigma = (beads[i].radius + beads[j].radius);
+      RealType subtr_sigma = (beads[i].radius - beads[j].radius);
+      RealType subtr_sigma_sqr = subtr_sigma * subtr_sigma;
+
+      RealType constant = 6.0 * Constants::PI * viscosity * (beads[i].radius * beads[j].radius);
+
+      RealType rij3 = rij2 * rij;
+
+      Mat3x3d tmpMat;
+      tmpMat = outProduct(Rij, Rij) / rij2;
+
+      RealType tmp_var1 = subtr_sigma_sqr + 3.0 * rij2;
+      RealType tmp1overlap = ( 16.0 * rij3 * sum_sigma - tmp_var1 * tmp_var1 )/( 32.0 * rij3 );
+
+      RealType tmp_var2 = subtr_sigma_sqr - rij2;
+      RealType tmp2overlap = ( 3.0 * tmp_var2 * tmp_var2 )/( 32.0 * rij3 );
+
+      Tij = (tmp1overlap * I + tmp2overlap * tmpMat) / constant;
+
+      RealType volumetmp1 = (-rij + sum_sigma) * (-rij + sum_sigma);
+      RealType volumetmp2 = (rij2 + 2.0 * (rij * beads[i].radius) - 3.0 * (beads[i].radius * beads[i].radius) +
+                             2 * (rij * beads[j].radius) + 6 * (beads[i].radius * beads[j].radius) - 3 * (beads[j].radius * beads[j].radius));
+      volume_overlap += (Constants::PI/(12.0 * rij)) * volumetmp1 * volumetmp2;
+      return 1;
+    }
+
+    //overlapping beads, part II: one bead inside the other
+    std::size_t outer = (beads[i].radius >= beads[j].radius) ? i : j;
+    std::size_t inner = (outer == i) ? j : i;
+
+    RealType constant = 1.0 / (6.0 * Constants::PI * viscosity * beads[outer].radius);
+    Tij(0, 0) = constant;
+    Tij(1, 1) = constant;
+    Tij(2, 2) = constant;
+
+    RealType bead_rad_cub = beads[inner].radius * beads[inner].radius * beads[inner].radius;
+    volume_overlap += (4.0/3.0) * Constants::PI * bead_rad_cub;
+
+    return (outer == i) ? 2 : 3;
+  }
+
+  /**
+   * Fills the 3N x 6 right hand side matrix (row-major) used by all
+   * of the solvers.  The first three columns hold the identity block
+   * for every bead, the last three hold the skew-symmetric matrix U_i
+   * of the bead position.  With C = B^-1, the resistance tensors at
+   * the origin only require the product C * [E | U].
+   */
+  static void setupRHS(std::vector<BeadParam>& beads,
+                       std::vector<RealType>& rhs) {
+    std::size_t nbeads = beads.size();
+    rhs.assign(3 * nbeads * 6, 0.0);
+    for (std::size_t i = 0; i < nbeads; ++i) {
+      Mat3x3d U;
+      U.setupSkewMat(beads[i].pos);
+      for (std::size_t a = 0; a < 3; ++a) {
+        RealType* row = &rhs[(3*i + a) * 6];
+        row[a] = 1.0;
+        for (std::size_t b = 0; b < 3; ++b)
+          row[3 + b] = U(a, b);
+      }
+    }
+  }
+
+  /**
+   * Stores the overlap class and volume of beads i and j (j < i) as
+   * the solvers assemble the mobility tensor.  Only row i is touched,
+   * so the threads that own different rows never share an entry.
+   */
+  void ApproximationModel::recordOverlap(std::size_t i, std::size_t j,
+                                         int kind, RealType volume) {
+    if (kind == 0) return;
+    overlaps_[i].push_back(std::make_pair(j, kind));
+    overlapVolume_[i] += volume;
+  }
+
+  /**
+   * Reports every overlapping or contained pair of beads, in both
+   * orders and in row order, and returns the overlap statistics used
+   * for the volume correction.  Each pair was recorded once, so its
+   * volume is counted twice, as Vij and Vji.
+   */
+  void ApproximationModel::reportOverlaps(RealType& volume_overlap,
+                                          RealType& overlap_beads) {
+    std::size_t nbeads = overlaps_.size();
+    std::vector<std::vector<std::pair<std::size_t, int> > > rows(overlaps_);
+
+    for (std::size_t i = 0; i < nbeads; ++i) {
+      for (std::size_t k = 0; k < overlaps_[i].size(); ++k) {
+        std::size_t j = overlaps_[i][k].first;
+        int kind = overlaps_[i][k].second;
+        // j inside i (2) is i inside j (3) seen from row j
+        rows[j].push_back(std::make_pair(i, (kind == 1) ? 1 : 5 - kind));
+      }
+      volume_overlap += 2.0 * overlapVolume_[i];
+    }
+
+    for (std::size_t i = 0; i < nbeads; ++i) {
+      std::sort(rows[i].begin(), rows[i].end());
+      for (std::size_t k = 0; k < rows[i].size(); ++k) {
+        std::size_t j = rows[i][k].first;
+        switch (rows[i][k].second) {
+        case 1:
+          std::cout << "There is overlapping between beads: (" << i << ") and (" << j << ")" << std::endl;
+          break;
+        case 2:
+          std::cout << "Bead: (" << j << ") is inside bead (" << i << ")" << std::endl;
+          break;
+        case 3:
+          std::cout << "Bead: (" << i << ") is inside bead (" << j << ")" << std::endl;
+          break;
+        }
+        overlap_beads += 1;  //counting overlapping beads
+      }
+    }
+  }
+
+  void ApproximationModel::solveLU(std::vector<BeadParam>& beads,
+                                   RealType viscosity,
+                                   std::vector<RealType>& X) {
+    std::size_t nbeads = beads.size();
+    std::size_t n = 3 * nbeads;
+    DynamicRectMatrix<RealType> B(n, n);
+    DynamicRectMatrix<RealType> C(n, n);
+
+    for (std::size_t i = 0; i < nbeads; ++i) {
+      for (std::size_t j = 0; j < nbeads; ++j) {
+        Mat3x3d Tij;
+        RealType v(0.0);
+        int kind = calcTij(beads, i, j, viscosity, Tij, v);
+        if (j < i) recordOverlap(i, j, kind, v);
+        B.setSubMatrix(i*3, j*3, Tij);
+      }
+    }
+
+    //invert B Matrix
+    invertMatrix(B, C);  //B is modified during the inversion
+
+    std::vector<RealType> rhs;
+    setupRHS(beads, rhs);
+    X.assign(n * 6, 0.0);
+    for (std::size_t r = 0; r < n; ++r) {
+      for (std::size_t k = 0; k < n; ++k) {
+        RealType c = C(r, k);
+        for (std::size_t m = 0; m < 6; ++m)
+          X[r*6 + m] += c * rhs[k*6 + m];
+      }
+    }
+  }
+
+  /**
+   * Packed storage for the lower triangle of a symmetric matrix.
+   * Row i starts at i*(i+1)/2 and is contiguous, so both the blocked
+   * factorization and the triangular solves stream through memory.
+   */
+  static inline std::size_t packedIndex(std::size_t i, std::size_t j) {
+    return i * (i + 1) / 2 + j;
+  }
+
+  bool ApproximationModel::solveCholesky(std::vector<BeadParam>& beads,
+                                         RealType viscosity,
+                                         std::vector<RealType>& X) {
+    long nbeads = beads.size();
+    long n = 3 * nbeads;
+    std::vector<RealType> L(static_cast<std::size_t>(n) * (n + 1) / 2, 0.0);
+
+    // assemble the lower triangle of B
+#pragma omp parallel for schedule(dynamic)
+    for (long i = 0; i < nbeads; ++i) {
+      for (long j = 0; j <= i; ++j) {
+        Mat3x3d Tij;
+        RealType v(0.0);
+        int kind = calcTij(beads, i, j, viscosity, Tij, v);
+        if (j < i) recordOverlap(i, j, kind, v);
+        for (long a = 0; a < 3; ++a) {
+          long bmax = (i == j) ? a : 2;
+          for (long b = 0; b <= bmax; ++b)
+            L[packedIndex(3*i + a, 3*j + b)] = Tij(a, b);
+        }
+      }
+    }
+
+    // right-looking blocked Cholesky factorization, B = L L^T
+    const long nb = 64;
+    for (long k0 = 0; k0 < n; k0 += nb) {
+      long k1 = std::min(k0 + nb, n);
+
+      // factor the diagonal block
+      for (long j = k0; j < k1; ++j) {
+        RealType* Lj = &L[packedIndex(j, 0)];
+        RealType d = Lj[j];
+        for (long k = k0; k < j; ++k) d -= Lj[k] * Lj[k];
+        if (d <= 0.0) return false;
+        Lj[j] = sqrt(d);
+        for (long i = j + 1; i < k1; ++i) {
+          RealType* Li = &L[packedIndex(i, 0)];
+          RealType s = Li[j];
+          for (long k = k0; k < j; ++k) s -= Li[k] * Lj[k];
+          Li[j] = s / Lj[j];
+        }
+      }
+
+      // triangular solve for the panel below the diagonal block
+#pragma omp parallel for schedule(static)
+      for (long i = k1; i < n; ++i) {
+        RealType* Li = &L[packedIndex(i, 0)];
+        for (long j = k0; j < k1; ++j) {
+          const RealType* Lj = &L[packedIndex(j, 0)];
+          RealType s = Li[j];
+          for (long k = k0; k < j; ++k) s -= Li[k] * Lj[k];
+          Li[j] = s / Lj[j];
+        }
+      }
+
+      // symmetric rank-nb update of the trailing matrix
+#pragma omp parallel for schedule(dynamic, 16)
+      for (long i = k1; i < n; ++i) {
+        RealType* Li = &L[packedIndex(i, 0)];
+        for (long j = k1; j <= i; ++j) {
+          const RealType* Lj = &L[packedIndex(j, 0)];
+          RealType s(0.0);
+          for (long k = k0; k < k1; ++k) s += Li[k] * Lj[k];
+          Li[j] -= s;
+        }
+      }
+    }
+
+    // forward (L y = b) and backward (L^T x = y) substitution for the
+    // six right hand sides at once
+    setupRHS(beads, X);
+    for (long i = 0; i < n; ++i) {
+      const RealType* Li = &L[packedIndex(i, 0)];
+      RealType* xi = &X[i * 6];
+      for (long k = 0; k < i; ++k) {
+        const RealType* xk = &X[k * 6];
+        for (int m = 0; m < 6; ++m) xi[m] -= Li[k] * xk[m];
+      }
+      for (int m = 0; m < 6; ++m) xi[m] /= Li[i];
+    }
+    for (long i = n - 1; i >= 0; --i) {
+      const RealType* Li = &L[packedIndex(i, 0)];
+      RealType* xi = &X[i * 6];
+      for (int m = 0; m < 6; ++m) xi[m] /= Li[i];
+      for (long k = 0; k < i; ++k) {
+        RealType* xk = &X[k * 6];
+        for (int m = 0; m < 6; ++m) xk[m] -= Li[k] * xi[m];
+      }
+    }
+    return true;
+  }
+
+  bool ApproximationModel::solveCG(std::vector<BeadParam>& beads,
+                                   RealType viscosity,
+                                   std::vector<RealType>& X) {
+    long nbeads = beads.size();
+    long n = 3 * nbeads;
+    const int maxIter = std::max(100L, n);
+    const RealType tolerance = 1.0e-10;
+
+    std::vector<RealType> b;
+    setupRHS(beads, b);
+
+    // Jacobi preconditioner from the self-mobility of each bead
+    std::vector<RealType> Minv(nbeads);
+    for (long i = 0; i < nbeads; ++i)
+      Minv[i] = 6.0 * Constants::PI * viscosity * beads[i].radius;
+
+    std::vector<RealType> r(b), z(n * 6), p(n * 6), q(n * 6);
+    X.assign(n * 6, 0.0);
+
+    RealType rz[6], bnorm[6], rnorm[6];
+    bool converged[6];
+    for (int m = 0; m < 6; ++m) {
+      rz[m] = 0.0; bnorm[m] = 0.0; converged[m] = false;
+    }
+    for (long k = 0; k < n; ++k) {
+      for (int m = 0; m < 6; ++m) {
+        z[k*6 + m] = Minv[k / 3] * r[k*6 + m];
+        p[k*6 + m] = z[k*6 + m];
+        rz[m] += r[k*6 + m] * z[k*6 + m];
+        bnorm[m] += b[k*6 + m] * b[k*6 + m];
+      }
+    }
+    for (int m = 0; m < 6; ++m) bnorm[m] = sqrt(bnorm[m]);
+
+    int iter;
+    for (iter = 0; iter < maxIter; ++iter) {
+
+      // matrix-free q = B p, building each Tij on the fly; the
+      // overlaps are collected on the first pass only
+#pragma omp parallel for schedule(dynamic)
+      for (long i = 0; i < nbeads; ++i) {
+        RealType acc[3][6] = {{0.0}};
+        for (long j = 0; j < nbeads; ++j) {
+          Mat3x3d Tij;
+          RealType v(0.0);
+          int kind = calcTij(beads, i, j, viscosity, Tij, v);
+          if (iter == 0 && j < i) recordOverlap(i, j, kind, v);
+          const RealType* pj = &p[3*j*6];
+          for (int a = 0; a < 3; ++a)
+            for (int c = 0; c < 3; ++c)
+              for (int m = 0; m < 6; ++m)
+                acc[a][m] += Tij(a, c) * pj[c*6 + m];
+        }
+        for (int a = 0; a < 3; ++a)
+          for (int m = 0; m < 6; ++m)
+            q[(3*i + a)*6 + m] = acc[a][m];
+      }
+
+      RealType pq[6], rzNew[6];
+      for (int m = 0; m < 6; ++m) {
+        pq[m] = 0.0; rzNew[m] = 0.0; rnorm[m] = 0.0;
+      }
+      for (long k = 0; k < n * 6; ++k) pq[k % 6] += p[k] * q[k];
+
+      for (int m = 0; m < 6; ++m) {
+        RealType alpha = converged[m] ? 0.0 : rz[m] / pq[m];
+        for (long k = 0; k < n; ++k) {
+          X[k*6 + m] += alpha * p[k*6 + m];
+          r[k*6 + m] -= alpha * q[k*6 + m];
+          rnorm[m] += r[k*6 + m] * r[k*6 + m];
+        }
+      }
+
+      bool allConverged = true;
+      for (int m = 0; m < 6; ++m) {
+        converged[m] = converged[m] || (sqrt(rnorm[m]) <= tolerance * bnorm[m]);
+        allConverged = allConverged && converged[m];
+      }
+      if (allConverged) break;
+
+      for (long k = 0; k < n; ++k) {
+        for (int m = 0; m < 6; ++m) {
+          z[k*6 + m] = Minv[k / 3] * r[k*6 + m];
+          rzNew[m] += r[k*6 + m] * z[k*6 + m];
+        }
+      }
+      for (int m = 0; m < 6; ++m) {
+        RealType beta = converged[m] ? 0.0 : rzNew[m] / rz[m];
+        rz[m] = rzNew[m];
+        for (long k = 0; k < n; ++k)
+          p[k*6 + m] = converged[m] ? 0.0 : z[k*6 + m] + beta * p[k*6 + m];
+      }
+    }
+
+    std::cout << "Conjugate gradient iterations = " << std::min(iter + 1, maxIter) << std::endl;
+    return iter < maxIter;
+  }
+
   bool ApproximationModel::calcHydroPropsAtCRandAtCDandAtCOM(std::vector<BeadParam>& beads,
                                               RealType viscosity,
                                               RealType temperature,
@@ -114,8 +509,6 @@ namespace OpenMD {
     std::cout << "\n";
 
     unsigned int nbeads = beads.size();
-    DynamicRectMatrix<RealType> B(3*nbeads, 3*nbeads);
-    DynamicRectMatrix<RealType> C(3*nbeads, 3*nbeads);
     Mat3x3d I;
     I(0, 0) = 1.0;
     I(1, 1) = 1.0;
@@ -124,117 +517,63 @@ namespace OpenMD {
     RealType overlap_beads = 0.0;
 
     for (std::size_t i = 0; i < nbeads; ++i) {
-      for (std::size_t j = 0; j < nbeads; ++j) {
-         //checking if the beads' radii are non-negative values.
-        if (beads[i].radius < 0 || beads[j].radius < 0){
-          sprintf(painCave.errMsg, "There are beads with negative radius. Starting from index 0,\
- check bead (%lu) and/or bead (%lu).\n", i, j);
-          painCave.isFatal = 1;
-          simError();
-        }
-        //if the bead's radius is below 1.0e-14, substitute by 1.0e-14;
-        //to avoid problem in the self-interaction part (i.e., to not divide by zero)
-        if (beads[i].radius < 1.0e-14){
-          beads[i].radius = 1.0e-14;
-        }
-        else if (beads[j].radius < 1.0e-14){
-          beads[j].radius = 1.0e-14;
-        }
+      //checking if the beads' radii are non-negative values.
+      if (beads[i].radius < 0) {
+        sprintf(painCave.errMsg, "There are beads with negative radius. Starting from index 0,\
+ check bead (%lu).\n", i);
+        painCave.isFatal = 1;
+        simError();
+      }
+      //if the bead's radius is below 1.0e-14, substitute by 1.0e-14;
+      //to avoid problem in the self-interaction part (i.e., to not divide by zero)
+      if (beads[i].radius < 1.0e-14){
+        beads[i].radius = 1.0e-14;
+      }
+    }
 
-        Mat3x3d Tij;
-        if (i != j ) {   //non-self interaction: divided in overlapping and non-overlapping beads; the transitions among them are continuous
-          Vector3d Rij = beads[i].pos - beads[j].pos;
-          RealType rij = Rij.length();
-          RealType rij2 = rij * rij;
-          if (rij >= (beads[i].radius + beads[j].radius)) {      //non-overlapping beads
-            RealType sumSigma2OverRij2 = ((beads[i].radius*beads[i].radius) +
-                                               (beads[j].radius*beads[j].radius)) / rij2;
-            Mat3x3d tmpMat;
-            tmpMat = outProduct(Rij, Rij) / rij2;
-            RealType constant = 8.0 * Constants::PI * viscosity * rij;
-            RealType tmp1 = 1.0 + sumSigma2OverRij2/3.0;
-            RealType tmp2 = 1.0 - sumSigma2OverRij2;
-            Tij = (tmp1 * I + tmp2 * tmpMat ) / constant;
-        }      //overlapping beads, part I
-          else if ( rij > fabs(beads[i].radius - beads[j].radius) && rij < (beads[i].radius + beads[j].radius) ) {
-            std::cout << "There is overlapping between beads: (" << i << ") and (" << j << ")" << std::endl;
-            overlap_beads +=1;  //counting overlapping beads
-            RealType sum_sigma = (beads[i].radius + beads[j].radius);
-            RealType subtr_sigma = (beads[i].radius - beads[j].radius);
-            RealType subtr_sigma_sqr = subtr_sigma * subtr_sigma;
-
-            RealType constant = 6.0 * Constants::PI * viscosity * (beads[i].radius * beads[j].radius);
-
-            RealType rij3 = rij2 * rij;
-
-            Mat3x3d tmpMat;
-            tmpMat = outProduct(Rij, Rij) / rij2;
-
-            RealType tmp_var1 = subtr_sigma_sqr + 3.0 * rij2;
-            RealType tmp1overlap = ( 16.0 * rij3 * sum_sigma - tmp_var1 * tmp_var1 )/( 32.0 * rij3 );
-
-            RealType tmp_var2 = subtr_sigma_sqr - rij2;
-            RealType tmp2overlap = ( 3.0 * tmp_var2 * tmp_var2 )/( 32.0 * rij3 );
-
-            Tij = (tmp1overlap * I + tmp2overlap * tmpMat) / constant;
-
-            RealType volumetmp1 = (-rij + sum_sigma) * (-rij + sum_sigma);
-            RealType volumetmp2 = (rij2 + 2.0 * (rij * beads[i].radius) - 3.0 * (beads[i].radius * beads[i].radius) +
-               2 * (rij * beads[j].radius) + 6 * (beads[i].radius * beads[j].radius) - 3 * (beads[j].radius * beads[j].radius));
-            volume_overlap += (Constants::PI/(12.0 * rij)) * volumetmp1 * volumetmp2;
-        }
-          else{      //overlapping beads, part II: one bead inside the other
-            if ( (beads[i].radius >= beads[j].radius) ) {
-              std::cout << "Bead: (" << j << ") is inside bead (" << i << ")" << std::endl;
-              overlap_beads +=1;  //counting overlapping beads
-              RealType constant = 1.0 / (6.0 * Constants::PI * viscosity * beads[i].radius);
-              Tij(0, 0) = constant;
-              Tij(1, 1) = constant;
-              Tij(2, 2) = constant;
-
-              RealType bead_rad_cub = beads[j].radius * beads[j].radius * beads[j].radius;
-
-              volume_overlap += (4.0/3.0) * Constants::PI * bead_rad_cub;
-
-            } else{
-              std::cout << "Bead: (" << i << ") is inside bead (" << j << ")" << std::endl;
-              overlap_beads +=1;  //counting overlapping beads
-              RealType constant = 1.0 / (6.0 * Constants::PI * viscosity * beads[j].radius);
-              Tij(0, 0) = constant;
-              Tij(1, 1) = constant;
-              Tij(2, 2) = constant;
-
-              RealType bead_rad_cub = beads[i].radius * beads[i].radius * beads[i].radius;
-
-              volume_overlap += (4.0/3.0) * Constants::PI * bead_rad_cub;
-            }
-          }
-        }else {   //self interaction, there is no overlapping volume (volume_overlap)
-          RealType constant = 1.0 / (6.0 * Constants::PI * viscosity * beads[i].radius);
-          Tij(0, 0) = constant;
-          Tij(1, 1) = constant;
-          Tij(2, 2) = constant;
-        }
-        B.setSubMatrix(i*3, j*3, Tij);
+    overlaps_.assign(nbeads, std::vector<std::pair<std::size_t, int> >());
+    overlapVolume_.assign(nbeads, 0.0);
+
+    // X = B^-1 [E | U], a 3N x 6 row-major matrix
+    std::vector<RealType> X;
+
+    switch (solver_) {
+    case hsCG:
+      std::cout << "Solving for the mobility tensor with matrix-free conjugate gradients" << std::endl;
+      if (!solveCG(beads, viscosity, X)) {
+        sprintf(painCave.errMsg,
+                "ApproximationModel: conjugate gradient solver did not converge.\n");
+        painCave.isFatal = 0;
+        painCave.severity = OPENMD_WARNING;
+        simError();
       }
+      break;
+    case hsCholesky:
+      std::cout << "Solving for the mobility tensor with a blocked Cholesky factorization" << std::endl;
+      if (solveCholesky(beads, viscosity, X))
+        break;
+      sprintf(painCave.errMsg,
+              "ApproximationModel: bead mobility tensor is not positive definite,\n"
+              "\tfalling back to LU inversion.\n");
+      painCave.isFatal = 0;
+      painCave.severity = OPENMD_WARNING;
+      simError();
+      // LU assembles the tensor again and records the overlaps again
+      overlaps_.assign(nbeads, std::vector<std::pair<std::size_t, int> >());
+      overlapVolume_.assign(nbeads, 0.0);
+      // fall through
+    case hsLU:
+    default:
+      solveLU(beads, viscosity, X);
+      break;
     }
 
+    reportOverlaps(volume_overlap, overlap_beads);
 
     //overlapping beads percentage
     //#overlap_beads counts (i,j) and (j,i) beads; and N*(N-1) counts (Tij) and (Tji) elements  (i!=j)
     RealType overlap_percent = (overlap_beads * 1.0/(nbeads * (nbeads-1)))*100;  //(overlap_beads/(N*(N-1)))*100
 
-    //invert B Matrix
-    invertMatrix(B, C);  //B is modified during the inversion
-
-    //prepare U Matrix relative to arbitrary origin O(0.0, 0.0, 0.0); from the generated geometry file .xyz
-    std::vector<Mat3x3d> U;
-    for (unsigned int i = 0; i < nbeads; ++i) {
-      Mat3x3d currU;
-      currU.setupSkewMat(beads[i].pos);
-      U.push_back(currU);
-    }
-
     //calculate Xi matrix at arbitrary origin O
     Mat3x3d Xiott;
     Mat3x3d Xiorr;
@@ -248,16 +587,24 @@ namespace OpenMD {
     }
 
     for (std::size_t i = 0; i < nbeads; ++i) {
-      for (std::size_t j = 0; j < nbeads; ++j) {
-        Mat3x3d Cij;
-        C.getSubMatrix(i*3, j*3, Cij);
-
-        Xiott += Cij;
-        Xiotr += U[i] * Cij;
-	// Uncorrected here.  Volume correction is added after we
-	// assemble Xiorr
-        Xiorr += -U[i] * Cij * U[j];
+      Mat3x3d Ui;
+      Ui.setupSkewMat(beads[i].pos);
+
+      // sum_j Cij and sum_j Cij U_j for bead i
+      Mat3x3d CEi;
+      Mat3x3d CUi;
+      for (std::size_t a = 0; a < 3; ++a) {
+        for (std::size_t b = 0; b < 3; ++b) {
+          CEi(a, b) = X[(3*i + a)*6 + b];
+          CUi(a, b) = X[(3*i + a)*6 + 3 + b];
+        }
       }
+
+      Xiott += CEi;
+      Xiotr += Ui * CEi;
+      // Uncorrected here.  Volume correction is added after we
+      // assemble Xiorr
+      Xiorr += -Ui * CUi;
     }
 
     // Add the volume correction
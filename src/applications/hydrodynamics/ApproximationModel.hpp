@@ -53,11 +53,28 @@
 namespace OpenMD {
 
   class Shape;
+
+  /**
+   * Linear solvers available for the bead mobility problem.  LU
+   * inverts the full 3N x 3N tensor, Cholesky factors the symmetric
+   * positive definite tensor (stored as a packed lower triangle) and
+   * solves for only the six right hand sides that are needed, and CG
+   * is a matrix-free conjugate gradient solver that never stores the
+   * tensor at all.
+   */
+  enum HydroSolverType {
+    hsLU,
+    hsCholesky,
+    hsCG
+  };
+
   class ApproximationModel :  public HydrodynamicsModel {
 
   public:
     ApproximationModel(StuntDouble* sd, SimInfo* info);
 
+    void setSolver(HydroSolverType solver) { solver_ = solver; }
+
     virtual bool calcHydroProps(Shape* shape, RealType viscosity,
                                 RealType temperature);
     virtual void init();
@@ -68,7 +85,28 @@ namespace OpenMD {
 
     bool calcHydroPropsAtCRandAtCDandAtCOM(std::vector<BeadParam>& beads, RealType viscosity,
                             RealType temperature, HydroProp* cr, HydroProp* cd, HydroProp* coM);
+
+    int calcTij(std::vector<BeadParam>& beads, std::size_t i, std::size_t j,
+                RealType viscosity, Mat3x3d& Tij, RealType& volume_overlap);
+
+    void recordOverlap(std::size_t i, std::size_t j, int kind,
+                       RealType volume);
+    void reportOverlaps(RealType& volume_overlap, RealType& overlap_beads);
+
+    void solveLU(std::vector<BeadParam>& beads, RealType viscosity,
+                 std::vector<RealType>& X);
+    bool solveCholesky(std::vector<BeadParam>& beads, RealType viscosity,
+                       std::vector<RealType>& X);
+    bool solveCG(std::vector<BeadParam>& beads, RealType viscosity,
+                 std::vector<RealType>& X);
+
     std::vector<BeadParam> beads_;
+    HydroSolverType solver_;
+
+    /** (j, calcTij class) of the beads j < i overlapping bead i */
+    std::vector<std::vector<std::pair<std::size_t, int> > > overlaps_;
+    /** overlapping volume of bead i with the beads j < i */
+    std::vector<RealType> overlapVolume_;
   };
 }
 
@@ -49,6 +49,7 @@
 #include "applications/hydrodynamics/HydrodynamicsModelCreator.hpp"
 #include "applications/hydrodynamics/HydrodynamicsModelFactory.hpp"
 #include "applications/hydrodynamics/AnalyticalModel.hpp"
+#include "applications/hydrodynamics/ApproximationModel.hpp"
 #include "applications/hydrodynamics/BeadModel.hpp"
 #include "applications/hydrodynamics/RoughShell.hpp"
 #include "applications/hydrodynamics/ShapeBuilder.hpp"
@@ -189,6 +190,21 @@ int main(int argc, char* argv[]){
           RealType bs = args_info.beadSize_arg;
           dynamic_cast<RoughShell*>(model)->setSigma(bs);
         }
+
+        HydroSolverType solver;
+        switch (args_info.solver_arg) {
+        case solver_arg_LU:
+          solver = hsLU;
+          break;
+        case solver_arg_CG:
+          solver = hsCG;
+          break;
+        case solver_arg_Cholesky:
+        default:
+          solver = hsCholesky;
+          break;
+        }
+        dynamic_cast<ApproximationModel*>(model)->setSolver(solver);
       }
     }
 
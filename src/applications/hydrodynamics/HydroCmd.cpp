@@ -40,6 +40,7 @@ const char *gengetopt_args_info_help[] = {
   "      --model=ENUM       hydrodynamics model  (possible values=\"BeadModel\",\n                           \"RoughShell\" default=`RoughShell') (mandatory)",
   "  -s, --beadSize=DOUBLE  bead size (diameter) for RoughShell model (in angstroms)\n                           (default=`0.2')",
   "  -b, --beads            generate the beads only, hydrodynamics will not be\n                           performed  (default=off)",
+  "      --solver=ENUM      linear solver for the bead mobility tensor  (possible\n                           values=\"LU\", \"Cholesky\", \"CG\"\n                           default=`Cholesky')",
     0
 };
 
@@ -63,6 +64,7 @@ static int
 cmdline_parser_required2 (struct gengetopt_args_info *args_info, const char *prog_name, const char *additional_error);
 
 const char *cmdline_parser_model_values[] = {"BeadModel", "RoughShell", 0}; /*< Possible values for model. */
+const char *cmdline_parser_solver_values[] = {"LU", "Cholesky", "CG", 0}; /*< Possible values for solver. */
 
 static char *
 gengetopt_strdup (const char *s);
@@ -77,6 +79,7 @@ void clear_given (struct gengetopt_args_info *args_info)
   args_info->model_given = 0 ;
   args_info->beadSize_given = 0 ;
   args_info->beads_given = 0 ;
+  args_info->solver_given = 0 ;
 }
 
 static
@@ -92,6 +95,8 @@ void clear_args (struct gengetopt_args_info *args_info)
   args_info->beadSize_arg = 0.2;
   args_info->beadSize_orig = NULL;
   args_info->beads_flag = 0;
+  args_info->solver_arg = solver_arg_Cholesky;
+  args_info->solver_orig = NULL;
 
 }
 
@@ -107,6 +112,7 @@ void init_args_info(struct gengetopt_args_info *args_info)
   args_info->model_help = gengetopt_args_info_help[4] ;
   args_info->beadSize_help = gengetopt_args_info_help[5] ;
   args_info->beads_help = gengetopt_args_info_help[6] ;
+  args_info->solver_help = gengetopt_args_info_help[7] ;
 
 }
 
@@ -199,6 +205,7 @@ cmdline_parser_release (struct gengetopt_args_info *args_info)
   free_string_field (&(args_info->output_orig));
   free_string_field (&(args_info->model_orig));
   free_string_field (&(args_info->beadSize_orig));
+  free_string_field (&(args_info->solver_orig));
 
 
   for (i = 0; i < args_info->inputs_num; ++i)
@@ -289,6 +296,8 @@ cmdline_parser_dump(FILE *outfile, struct gengetopt_args_info *args_info)
     write_into_file(outfile, "beadSize", args_info->beadSize_orig, 0);
   if (args_info->beads_given)
     write_into_file(outfile, "beads", 0, 0 );
+  if (args_info->solver_given)
+    write_into_file(outfile, "solver", args_info->solver_orig, cmdline_parser_solver_values);
 
 
   i = EXIT_SUCCESS;
@@ -1177,6 +1186,7 @@ cmdline_parser_internal (
         { "model",	1, NULL, 0 },
         { "beadSize",	1, NULL, 's' },
         { "beads",	0, NULL, 'b' },
+        { "solver",	1, NULL, 0 },
         { 0,  0, 0, 0 }
       };
 
@@ -1267,6 +1277,20 @@ cmdline_parser_internal (
                 additional_error))
               goto failure;
 
+          }
+          /* linear solver for the bead mobility tensor.  */
+          else if (strcmp (long_options[option_index].name, "solver") == 0)
+          {
+
+
+            if (update_arg( (void *)&(args_info->solver_arg),
+                 &(args_info->solver_orig), &(args_info->solver_given),
+                &(local_args_info.solver_given), optarg, cmdline_parser_solver_values, "Cholesky", ARG_ENUM,
+                check_ambiguity, override, 0, 0,
+                "solver", '-',
+                additional_error))
+              goto failure;
+
           }
 
           break;
@@ -35,6 +35,7 @@ extern "C" {
 #endif
 
 enum enum_model { model__NULL = -1, model_arg_BeadModel = 0, model_arg_RoughShell };
+enum enum_solver { solver__NULL = -1, solver_arg_LU = 0, solver_arg_Cholesky, solver_arg_CG };
 
 /** @brief Where the command line options are stored */
 struct gengetopt_args_info
@@ -55,6 +56,9 @@ struct gengetopt_args_info
   const char *beadSize_help; /**< @brief bead size for RoughShell model (in angstroms) help description.  */
   int beads_flag;	/**< @brief generate the beads only, hydrodynamics will not be performed (default=off).  */
   const char *beads_help; /**< @brief generate the beads only, hydrodynamics will not be performed help description.  */
+  enum enum_solver solver_arg;	/**< @brief linear solver for the bead mobility tensor (default='Cholesky').  */
+  char * solver_orig;	/**< @brief linear solver for the bead mobility tensor original value given at command line.  */
+  const char *solver_help; /**< @brief linear solver for the bead mobility tensor help description.  */
   
   unsigned int help_given ;	/**< @brief Whether help was given.  */
   unsigned int version_given ;	/**< @brief Whether version was given.  */
@@ -63,6 +67,7 @@ struct gengetopt_args_info
   unsigned int model_given ;	/**< @brief Whether model was given.  */
   unsigned int beadSize_given ;	/**< @brief Whether beadSize was given.  */
   unsigned int beads_given ;	/**< @brief Whether beads was given.  */
+  unsigned int solver_given ;	/**< @brief Whether solver was given.  */
 
   char **inputs ; /**< @brief unamed options (options without names) */
   unsigned inputs_num ; /**< @brief unamed options number */
@@ -190,6 +195,7 @@ int cmdline_parser_required (struct gengetopt_args_info *args_info,
   const char *prog_name);
 
 extern const char *cmdline_parser_model_values[];  /**< @brief Possible values for model. */
+extern const char *cmdline_parser_solver_values[];  /**< @brief Possible values for solver. */
 
 
 #ifdef __cplusplus
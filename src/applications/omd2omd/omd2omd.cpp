@@ -40,9 +40,12 @@
  * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
  */
  
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "omd2omdCmd.hpp"
 #include "brains/Register.hpp"
@@ -50,18 +53,136 @@
 #include "brains/SimInfo.hpp"
 #include "brains/ForceManager.hpp"
 #include "brains/Thermo.hpp"
+#include "brains/RigidBodyBatch.hpp"
 #include "io/DumpReader.hpp"
 #include "io/DumpWriter.hpp"
 #include "utils/simError.h"
 #include "utils/Constants.hpp"
 #include "math/Quaternion.hpp"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMD;
 
 using namespace std;
 
 void createMdFile(const std::string&oldMdFileName, const std::string&newMdFileName, std::vector<int> nMol);
 
+/**
+ * The old and new systems used to map one frame.  Each worker thread
+ * owns one of these, so frames can be mapped independently.
+ */
+struct FrameMapper {
+  SimInfo* oldInfo;
+  SimInfo* newInfo;
+  DumpReader* dumpReader;
+  DumpWriter* writer;
+  Thermo* thermo;
+  RigidBodyBatch* rbBatch;
+};
+
+FrameMapper* createMapper(SimInfo* oldInfo, SimInfo* newInfo,
+                          DumpReader* dumpReader, const string& outFileName) {
+  FrameMapper* fm = new FrameMapper;
+  fm->oldInfo = oldInfo;
+  fm->newInfo = newInfo;
+  fm->dumpReader = dumpReader;
+  // this writer only formats frames; it never opens the output file
+  fm->writer = new DumpWriter(newInfo, outFileName, false);
+  fm->thermo = new Thermo(oldInfo);
+  fm->rbBatch = new RigidBodyBatch(newInfo);
+  fm->rbBatch->build();
+  return fm;
+}
+
+// Reads one frame of the old system, maps it onto the new system, and
+// formats the new frame into os.
+void mapFrame(FrameMapper* fm, int whichFrame, const Mat3x3d& rotMatrix,
+              const Vector3i& repeat, const Vector3d& translate,
+              std::ostream& os) {
+  SimInfo* oldInfo = fm->oldInfo;
+  SimInfo* newInfo = fm->newInfo;
+  SimInfo::MoleculeIterator miter;
+  Molecule::IntegrableObjectIterator  iiter;
+  Molecule* mol;
+  StuntDouble* sd;
+  StuntDouble* sdNew;
+  Mat3x3d oldHmat;
+  Mat3x3d rotHmat;
+  Mat3x3d newHmat;
+  Snapshot* oldSnap;
+  Snapshot* newSnap;
+  Vector3d oldPos;
+  Vector3d newPos;
+  Vector3d COM;
+
+  Mat3x3d repeatD = Mat3x3d(0.0);
+  repeatD(0,0) = repeat.x();
+  repeatD(1,1) = repeat.y();
+  repeatD(2,2) = repeat.z();
+
+  fm->dumpReader->readFrame(whichFrame);        
+  oldSnap = oldInfo->getSnapshotManager()->getCurrentSnapshot();
+  newSnap = newInfo->getSnapshotManager()->getCurrentSnapshot();
+
+  newSnap->setID( oldSnap->getID() );
+  newSnap->setTime( oldSnap->getTime() );
+    
+  oldHmat = oldSnap->getHmat();
+  rotHmat = rotMatrix*oldHmat;
+  newHmat = repeatD*rotHmat;
+  newSnap->setHmat(newHmat);
+
+  newSnap->setThermostat( oldSnap->getThermostat() );
+  newSnap->setBarostat( oldSnap->getBarostat() );
+
+  COM = fm->thermo->getCom();
+
+  int newIndex = 0;
+  for (mol = oldInfo->beginMolecule(miter); mol != NULL; 
+       mol = oldInfo->nextMolecule(miter)) {
+      
+    for (int ii = 0; ii < repeat.x(); ii++) {
+      for (int jj = 0; jj < repeat.y(); jj++) {
+        for (int kk = 0; kk < repeat.z(); kk++) {
+
+          Vector3d trans = Vector3d(ii, jj, kk);
+          for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
+               sd = mol->nextIntegrableObject(iiter)) {
+            oldPos = sd->getPos() - COM + translate;
+            oldSnap->wrapVector(oldPos);
+            newPos = rotMatrix*oldPos + trans * oldHmat;
+            sdNew = newInfo->getIOIndexToIntegrableObject(newIndex);
+            sdNew->setPos( newPos );
+            sdNew->setVel( rotMatrix*sd->getVel() );
+	      
+            if (sd->isDirectional()) {
+
+              Mat3x3d bodyRotMat = sd->getA();
+              bodyRotMat = bodyRotMat * rotMatrix.inverse();
+              sdNew->setA( bodyRotMat );
+		
+              sdNew->setJ( rotMatrix * sd->getJ() );
+            }
+	      
+            newIndex++;
+          }
+	    
+        }
+      }
+    }
+      
+  }
+  
+  //update atoms of rigidbody
+  fm->rbBatch->updateAtoms();
+  fm->rbBatch->updateAtomVel();
+
+  fm->writer->writeFrame(os);
+}
+
 int main(int argc, char* argv[]){
   
   gengetopt_args_info args_info;
@@ -105,12 +226,6 @@ int main(int argc, char* argv[]){
                              args_info.repeatY_arg,
                              args_info.repeatZ_arg);
 
-  Mat3x3d repeatD = Mat3x3d(0.0);
-  repeatD(0,0) = repeat.x();
-  repeatD(1,1) = repeat.y();
-  repeatD(2,2) = repeat.z();
-
-  
   Vector3d translate = Vector3d(args_info.translateX_arg,
                                 args_info.translateY_arg,
                                 args_info.translateZ_arg);
@@ -131,11 +246,31 @@ int main(int argc, char* argv[]){
   
   createMdFile(dumpFileName, outFileName, nMol);
 
+  // Frames are converted concurrently, one frame per worker at a
+  // time, and appended to the new file in their original order.
+  // Every worker owns a copy of both the old and the new system.
   SimCreator newCreator;
   SimInfo* newInfo = newCreator.createSim(outFileName, false);
 
   DumpReader* dumpReader = new DumpReader(oldInfo, dumpFileName);
   int nframes = dumpReader->getNFrames();
+
+  int nWorkers = 1;
+#ifdef _OPENMP
+  nWorkers = std::max(1, std::min(omp_get_max_threads(), nframes));
+#endif
+  std::vector<FrameMapper*> workers(nWorkers);
+  workers[0] = createMapper(oldInfo, newInfo, dumpReader, outFileName);
+  for (int w = 1; w < nWorkers; w++) {
+    SimCreator oldWorkerCreator;
+    SimCreator newWorkerCreator;
+    SimInfo* oldWorkerInfo = oldWorkerCreator.createSim(dumpFileName, false);
+    SimInfo* newWorkerInfo = newWorkerCreator.createSim(outFileName, false);
+    DumpReader* workerReader = new DumpReader(oldWorkerInfo, dumpFileName);
+    workerReader->setFrameIndex(dumpReader->getFrameIndex());
+    workers[w] = createMapper(oldWorkerInfo, newWorkerInfo, workerReader,
+                              outFileName);
+  }
   
   DumpWriter* writer = new DumpWriter(newInfo, outFileName);
   if (writer == NULL) {
@@ -144,98 +279,37 @@ int main(int argc, char* argv[]){
     simError();
   }
 
-  SimInfo::MoleculeIterator miter;
-  Molecule::IntegrableObjectIterator  iiter;
-  Molecule::RigidBodyIterator rbIter;
-  Molecule* mol;
-  StuntDouble* sd;
-  StuntDouble* sdNew;
-  RigidBody* rb;
-  Mat3x3d oldHmat;
-  Mat3x3d rotHmat;
-  Mat3x3d newHmat;
-  Snapshot* oldSnap;
-  Snapshot* newSnap;
-  Vector3d oldPos;
-  Vector3d newPos;
-  Vector3d COM;
-  Thermo thermo(oldInfo);
-
-  
+#pragma omp parallel for ordered schedule(static, 1) num_threads(nWorkers)
   for (int i = 0; i < nframes; i++){
-    cerr << "frame = " << i << "\n";
-    dumpReader->readFrame(i);        
-    oldSnap = oldInfo->getSnapshotManager()->getCurrentSnapshot();
-    newSnap = newInfo->getSnapshotManager()->getCurrentSnapshot();
+    int w = 0;
+#ifdef _OPENMP
+    w = omp_get_thread_num();
+#endif
+    std::ostringstream frameText;
+    mapFrame(workers[w], i, rotMatrix, repeat, translate, frameText);
 
-    newSnap->setID( oldSnap->getID() );
-    newSnap->setTime( oldSnap->getTime() );
-    
-    oldHmat = oldSnap->getHmat();
-    rotHmat = rotMatrix*oldHmat;
-    newHmat = repeatD*rotHmat;
-    newSnap->setHmat(newHmat);
-
-    newSnap->setThermostat( oldSnap->getThermostat() );
-    newSnap->setBarostat( oldSnap->getBarostat() );
-
-    COM = thermo.getCom();
-
-    int newIndex = 0;
-    for (mol = oldInfo->beginMolecule(miter); mol != NULL; 
-         mol = oldInfo->nextMolecule(miter)) {
-      
-      for (int ii = 0; ii < repeat.x(); ii++) {
-        for (int jj = 0; jj < repeat.y(); jj++) {
-          for (int kk = 0; kk < repeat.z(); kk++) {
-
-            Vector3d trans = Vector3d(ii, jj, kk);
-            for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-                 sd = mol->nextIntegrableObject(iiter)) {
-	      oldPos = sd->getPos() - COM + translate;
-	      oldSnap->wrapVector(oldPos);
-	      newPos = rotMatrix*oldPos + trans * oldHmat;
-	      sdNew = newInfo->getIOIndexToIntegrableObject(newIndex);
-              sdNew->setPos( newPos );
-	      sdNew->setVel( rotMatrix*sd->getVel() );
-	      
-              if (sd->isDirectional()) {
-
-		Mat3x3d bodyRotMat = sd->getA();
-		bodyRotMat = bodyRotMat * rotMatrix.inverse();
-		sdNew->setA( bodyRotMat );
-		
-		sdNew->setJ( rotMatrix * sd->getJ() );
-              }
-	      
-              newIndex++;
-            }
-	    
-          }
-        }
-      }
-      
+#pragma omp ordered
+    {
+      cerr << "frame = " << i << "\n";
+      writer->writeFormattedFrame(frameText.str());
     }
-  
-    //update atoms of rigidbody
-    for (mol = newInfo->beginMolecule(miter); mol != NULL; 
-         mol = newInfo->nextMolecule(miter)) {
-      
-      //change the positions of atoms which belong to the rigidbodies
-      for (rb = mol->beginRigidBody(rbIter); rb != NULL; 
-           rb = mol->nextRigidBody(rbIter)) {
-	
-	
-        rb->updateAtoms();
-        rb->updateAtomVel();
-	
-      }
-    }
-
-    writer->writeDump();    
   }
   // deleting the writer will put the closing at the end of the dump file.
   delete writer;
+
+  for (int w = 0; w < nWorkers; w++) {
+    delete workers[w]->thermo;
+    delete workers[w]->rbBatch;
+    delete workers[w]->writer;
+    if (w > 0) {
+      delete workers[w]->dumpReader;
+      delete workers[w]->newInfo;
+      delete workers[w]->oldInfo;
+    }
+    delete workers[w];
+  }
+  delete dumpReader;
+  delete newInfo;
   delete oldInfo;
 }
 
@@ -0,0 +1,668 @@
+/*
+ * Copyright (c) 2006 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+
+/**
+ * solvationBuilder
+ *
+ * Tiles a periodic solvent box into the (possibly non-orthorhombic)
+ * periodic box of a solute, removes solvent molecules which overlap
+ * the solute or which collide with solvent from a neighboring tile,
+ * and writes a single ready-to-run OpenMD file.  Overlaps are found
+ * with periodic cell lists built in scaled coordinates, so the cost
+ * is linear in the number of atoms rather than quadratic.
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <set>
+#include <vector>
+#include <fstream>
+
+#include "applications/solvationBuilder/solvationBuilderCmd.hpp"
+#include "brains/SimInfo.hpp"
+#include "brains/SimCreator.hpp"
+#include "brains/RigidBodyBatch.hpp"
+#include "io/DumpWriter.hpp"
+#include "primitives/Molecule.hpp"
+#include "primitives/RigidBody.hpp"
+#include "math/Vector3.hpp"
+#include "math/SquareMatrix3.hpp"
+#include "utils/StringUtils.hpp"
+#include "utils/Trim.hpp"
+#include "utils/Utility.hpp"
+#include "utils/simError.h"
+
+using namespace std;
+using namespace OpenMD;
+
+/**
+ * A periodic cell list over a set of points in a (possibly
+ * non-orthorhombic) box.  Cells are laid out in scaled coordinates
+ * so that the neighbor search only ever has to look at the 27
+ * surrounding cells.
+ */
+class PeriodicCellList {
+public:
+  PeriodicCellList(const Mat3x3d& hmat, RealType rCut, int maxCells)
+    : hmat_(hmat), invHmat_(hmat.inverse()) {
+
+    RealType volume = fabs(hmat_.determinant());
+    Vector3d a = hmat_.getColumn(0);
+    Vector3d b = hmat_.getColumn(1);
+    Vector3d c = hmat_.getColumn(2);
+    Vector3d widths(volume / cross(b, c).length(),
+                    volume / cross(c, a).length(),
+                    volume / cross(a, b).length());
+
+    // with fewer than three cells in a direction the 27-cell search
+    // visits some cells more than once, which is harmless when we are
+    // only asking whether any overlap exists.
+    for (int i = 0; i < 3; i++)
+      nCells_[i] = max(1, int(widths[i] / rCut));
+
+    while (nCells_[0] * nCells_[1] * nCells_[2] > max(maxCells, 1)) {
+      for (int i = 0; i < 3; i++)
+        nCells_[i] = max(1, nCells_[i] / 2);
+    }
+
+    cells_.resize(nCells_[0] * nCells_[1] * nCells_[2]);
+  }
+
+  void addPoint(const Vector3d& pos, int id) {
+    cells_[getCellIndex(pos)].push_back(id);
+  }
+
+  int getCellIndex(const Vector3d& pos) {
+    Vector3d s = invHmat_ * pos;
+    int c[3];
+    for (int i = 0; i < 3; i++) {
+      s[i] -= roundMe(s[i]);
+      c[i] = int((s[i] + 0.5) * nCells_[i]);
+      if (c[i] >= nCells_[i]) c[i] = nCells_[i] - 1;
+      if (c[i] < 0) c[i] = 0;
+    }
+    return c[0] + nCells_[0] * (c[1] + nCells_[1] * c[2]);
+  }
+
+  /**
+   * Fills neighbors with the indices of the 27 cells surrounding
+   * (and including) the cell holding pos.
+   */
+  void getNeighborCells(const Vector3d& pos, vector<int>& neighbors) {
+    int cell = getCellIndex(pos);
+    int cx = cell % nCells_[0];
+    int cy = (cell / nCells_[0]) % nCells_[1];
+    int cz = cell / (nCells_[0] * nCells_[1]);
+
+    neighbors.clear();
+    for (int i = -1; i <= 1; i++) {
+      int x = (cx + i + nCells_[0]) % nCells_[0];
+      for (int j = -1; j <= 1; j++) {
+        int y = (cy + j + nCells_[1]) % nCells_[1];
+        for (int k = -1; k <= 1; k++) {
+          int z = (cz + k + nCells_[2]) % nCells_[2];
+          neighbors.push_back(x + nCells_[0] * (y + nCells_[1] * z));
+        }
+      }
+    }
+  }
+
+  const vector<int>& getCell(int index) { return cells_[index]; }
+
+  /**
+   * Returns the minimum image separation of two points, and whether
+   * the minimum image crossed a periodic boundary.
+   */
+  Vector3d minimumImage(const Vector3d& d, bool& wrapped) {
+    Vector3d s = invHmat_ * d;
+    wrapped = false;
+    for (int i = 0; i < 3; i++) {
+      RealType shift = roundMe(s[i]);
+      if (shift != 0.0) wrapped = true;
+      s[i] -= shift;
+    }
+    return hmat_ * s;
+  }
+
+private:
+  Mat3x3d hmat_;
+  Mat3x3d invHmat_;
+  int nCells_[3];
+  vector<vector<int> > cells_;
+};
+
+/**
+ * A candidate solvent molecule: one molecule of the solvent box
+ * placed in one particular tile.
+ */
+struct SolventCandidate {
+  int molecule;
+  int tile;
+  Vector3d shift;
+};
+
+/**
+ * Collects the #include lines and the molecule and component blocks
+ * from the top level of a raw MetaData string.
+ */
+void scanMetaData(const string& raw, vector<string>& includes,
+                  vector<string>& molecules, vector<string>& components);
+string getBlockName(const string& block);
+string setBlockNMol(const string& block, int nMol);
+
+int main(int argc, char *argv []) {
+
+  gengetopt_args_info args_info;
+  std::string soluteFileName;
+  std::string solventFileName;
+  std::string outputFileName;
+
+  // parse command line arguments
+  if (cmdline_parser(argc, argv, &args_info) != 0)
+    exit(1);
+
+  soluteFileName = args_info.input_arg;
+  solventFileName = args_info.solvent_arg;
+  outputFileName = args_info.output_arg;
+
+  if (!outputFileName.compare(soluteFileName) ||
+      !outputFileName.compare(solventFileName)) {
+    sprintf(painCave.errMsg,
+            "Input and Output File names should be different!");
+    painCave.severity = OPENMD_ERROR;
+    painCave.isFatal = 1;
+    simError();
+  }
+
+  RealType rCut = args_info.distance_arg;
+  RealType rTile = args_info.tileDistance_arg;
+
+  if (rCut <= 0.0) {
+    sprintf(painCave.errMsg, "The overlap removal distance must be "
+            "greater than 0.");
+    painCave.severity = OPENMD_ERROR;
+    painCave.isFatal = 1;
+    simError();
+  }
+
+  // parse the md files and set up both systems with their coordinates
+
+  SimCreator soluteCreator;
+  SimInfo* soluteInfo = soluteCreator.createSim(soluteFileName);
+  SimCreator solventCreator;
+  SimInfo* solventInfo = solventCreator.createSim(solventFileName);
+
+  Snapshot* soluteSnap = soluteInfo->getSnapshotManager()->getCurrentSnapshot();
+  Snapshot* solventSnap = solventInfo->getSnapshotManager()->getCurrentSnapshot();
+  Mat3x3d hmat = soluteSnap->getHmat();
+  Mat3x3d invHmat = soluteSnap->getInvHmat();
+  Mat3x3d solventHmat = solventSnap->getHmat();
+  Mat3x3d solventInvHmat = solventSnap->getInvHmat();
+
+  SimInfo::MoleculeIterator mi;
+  Molecule::AtomIterator ai;
+  Molecule* mol;
+  Atom* atom;
+
+  // the solute atoms go into a cell list sized by the overlap distance:
+
+  vector<Vector3d> solutePos;
+  for (mol = soluteInfo->beginMolecule(mi); mol != NULL;
+       mol = soluteInfo->nextMolecule(mi)) {
+    for (atom = mol->beginAtom(ai); atom != NULL; atom = mol->nextAtom(ai))
+      solutePos.push_back(atom->getPos());
+  }
+
+  PeriodicCellList soluteCells(hmat, rCut, solutePos.size());
+  for (unsigned int i = 0; i < solutePos.size(); i++)
+    soluteCells.addPoint(solutePos[i], i);
+
+  // flatten the solvent box into per-molecule atom ranges; each
+  // molecule is wrapped by its center of mass into the solvent box
+  // so that the tiles cover the box without gaps.
+
+  int nSolventMols = solventInfo->getNGlobalMolecules();
+  vector<int> atomStart(nSolventMols + 1, 0);
+  vector<Vector3d> solventPos;
+  vector<Vector3d> solventCom(nSolventMols);
+  vector<Vector3d> wrapShift(nSolventMols);
+
+  for (int m = 0; m < nSolventMols; m++) {
+    mol = solventInfo->getMoleculeByGlobalIndex(m);
+    atomStart[m] = solventPos.size();
+    for (atom = mol->beginAtom(ai); atom != NULL; atom = mol->nextAtom(ai))
+      solventPos.push_back(atom->getPos());
+
+    Vector3d com = mol->getCom();
+    Vector3d wrapped = com;
+    solventSnap->wrapVector(wrapped);
+    solventCom[m] = wrapped;
+    wrapShift[m] = wrapped - com;
+  }
+  atomStart[nSolventMols] = solventPos.size();
+
+  // find the range of solvent tiles that can reach the solute box by
+  // mapping the corners of the solute box into scaled solvent
+  // coordinates.
+
+  Vector3d sMin(1e30, 1e30, 1e30);
+  Vector3d sMax(-1e30, -1e30, -1e30);
+  for (int i = 0; i < 8; i++) {
+    Vector3d corner((i & 1) ? 0.5 : -0.5,
+                    (i & 2) ? 0.5 : -0.5,
+                    (i & 4) ? 0.5 : -0.5);
+    Vector3d s = solventInvHmat * (hmat * corner);
+    for (int j = 0; j < 3; j++) {
+      sMin[j] = min(sMin[j], s[j]);
+      sMax[j] = max(sMax[j], s[j]);
+    }
+  }
+  int tMin[3], nTiles[3];
+  for (int j = 0; j < 3; j++) {
+    tMin[j] = int(floor(sMin[j] - 0.5));
+    nTiles[j] = int(ceil(sMax[j] + 0.5)) - tMin[j] + 1;
+  }
+
+  // every solvent molecule in every tile whose center of mass lands
+  // inside the solute box is a candidate:
+
+  vector<SolventCandidate> candidates;
+  for (int i = 0; i < nTiles[0]; i++) {
+    for (int j = 0; j < nTiles[1]; j++) {
+      for (int k = 0; k < nTiles[2]; k++) {
+        Vector3d n(tMin[0] + i, tMin[1] + j, tMin[2] + k);
+        Vector3d tileShift = solventHmat * n;
+        int tile = i + nTiles[0] * (j + nTiles[1] * k);
+
+        for (int m = 0; m < nSolventMols; m++) {
+          Vector3d s = invHmat * (solventCom[m] + tileShift);
+          if (s[0] < -0.5 || s[0] >= 0.5 ||
+              s[1] < -0.5 || s[1] >= 0.5 ||
+              s[2] < -0.5 || s[2] >= 0.5) continue;
+
+          SolventCandidate cand;
+          cand.molecule = m;
+          cand.tile = tile;
+          cand.shift = wrapShift[m] + tileShift;
+          candidates.push_back(cand);
+        }
+      }
+    }
+  }
+
+  int nCandidates = candidates.size();
+  vector<char> keep(nCandidates, 1);
+  RealType rCutSq = rCut * rCut;
+
+  // pass 1: remove candidates which overlap the solute.  Each
+  // candidate is independent, so this loop threads trivially.
+
+#pragma omp parallel
+  {
+    vector<int> neighbors;
+    bool wrapped;
+#pragma omp for schedule(dynamic, 256)
+    for (int c = 0; c < nCandidates; c++) {
+      const SolventCandidate& cand = candidates[c];
+      for (int a = atomStart[cand.molecule];
+           a < atomStart[cand.molecule + 1] && keep[c]; a++) {
+        Vector3d pos = solventPos[a] + cand.shift;
+        soluteCells.getNeighborCells(pos, neighbors);
+        for (unsigned int n = 0; n < neighbors.size() && keep[c]; n++) {
+          const vector<int>& cell = soluteCells.getCell(neighbors[n]);
+          for (unsigned int l = 0; l < cell.size(); l++) {
+            Vector3d d = soluteCells.minimumImage(pos - solutePos[cell[l]],
+                                                  wrapped);
+            if (d.lengthSquare() < rCutSq) {
+              keep[c] = 0;
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // pass 2: where the tiles meet (and where they wrap around the
+  // solute box) solvent molecules from different tiles can collide.
+  // The collisions of each candidate with lower-index candidates are
+  // found in parallel, one candidate per iteration.  Candidates are
+  // then settled in index order: one is removed only if it collides
+  // with a lower-index candidate that is still kept.  The result does
+  // not depend on the thread count.
+
+  if (rTile > 0.0) {
+    vector<int> owner;
+    vector<Vector3d> tilePos;
+    vector<int> tileStart(nCandidates + 1, 0);
+    for (int c = 0; c < nCandidates; c++) {
+      tileStart[c] = tilePos.size();
+      if (!keep[c]) continue;
+      const SolventCandidate& cand = candidates[c];
+      for (int a = atomStart[cand.molecule];
+           a < atomStart[cand.molecule + 1]; a++) {
+        tilePos.push_back(solventPos[a] + cand.shift);
+        owner.push_back(c);
+      }
+    }
+    tileStart[nCandidates] = tilePos.size();
+
+    PeriodicCellList tileCells(hmat, rTile, tilePos.size());
+    for (unsigned int i = 0; i < tilePos.size(); i++)
+      tileCells.addPoint(tilePos[i], i);
+
+    vector<vector<int> > lowerHits(nCandidates);
+    RealType rTileSq = rTile * rTile;
+
+#pragma omp parallel
+    {
+      vector<int> neighbors;
+      bool wrapped;
+#pragma omp for schedule(dynamic, 256)
+      for (int c = 0; c < nCandidates; c++) {
+        vector<int>& hits = lowerHits[c];
+        for (int i = tileStart[c]; i < tileStart[c + 1]; i++) {
+          tileCells.getNeighborCells(tilePos[i], neighbors);
+          for (unsigned int n = 0; n < neighbors.size(); n++) {
+            const vector<int>& cell = tileCells.getCell(neighbors[n]);
+            for (unsigned int l = 0; l < cell.size(); l++) {
+              int c2 = owner[cell[l]];
+              if (c2 >= c) continue;
+              if (!hits.empty() && hits.back() == c2) continue;
+              Vector3d d = tileCells.minimumImage(tilePos[i] -
+                                                  tilePos[cell[l]], wrapped);
+              // molecules from the same tile only meet through the
+              // periodic boundaries of the solute box:
+              if (candidates[c2].tile == candidates[c].tile && !wrapped)
+                continue;
+              if (d.lengthSquare() < rTileSq)
+                hits.push_back(c2);
+            }
+          }
+        }
+      }
+    }
+
+    for (int c = 0; c < nCandidates; c++) {
+      if (!keep[c]) continue;
+      for (unsigned int h = 0; h < lowerHits[c].size(); h++) {
+        if (keep[lowerHits[c][h]]) {
+          keep[c] = 0;
+          break;
+        }
+      }
+    }
+  }
+
+  // tally the surviving solvent by component.  Molecules are created
+  // component by component, so the component of a solvent molecule
+  // follows from its global index.
+
+  std::vector<Component*> soluteComponents =
+    soluteInfo->getSimParams()->getComponents();
+  std::vector<Component*> solventComponents =
+    solventInfo->getSimParams()->getComponents();
+
+  vector<int> componentOf(nSolventMols);
+  vector<int> componentStart;
+  int m = 0;
+  for (unsigned int i = 0; i < solventComponents.size(); i++) {
+    componentStart.push_back(m);
+    for (int n = 0; n < solventComponents[i]->getNMol(); n++)
+      componentOf[m++] = i;
+  }
+
+  vector<int> nKept(solventComponents.size(), 0);
+  int nKeptTotal = 0;
+  for (int c = 0; c < nCandidates; c++) {
+    if (keep[c]) {
+      nKept[componentOf[candidates[c].molecule]]++;
+      nKeptTotal++;
+    }
+  }
+
+  // Build the new MetaData: the solute's MetaData followed by
+  // whatever the solvent needs (includes, molecule definitions not
+  // already present, and its components with corrected counts).
+
+  vector<string> soluteIncludes, soluteMolecules, soluteComps;
+  vector<string> solventIncludes, solventMolecules, solventComps;
+  scanMetaData(soluteInfo->getRawMetaData(), soluteIncludes,
+               soluteMolecules, soluteComps);
+  scanMetaData(solventInfo->getRawMetaData(), solventIncludes,
+               solventMolecules, solventComps);
+
+  set<string> knownIncludes(soluteIncludes.begin(), soluteIncludes.end());
+  set<string> knownMolecules;
+  for (unsigned int i = 0; i < soluteMolecules.size(); i++)
+    knownMolecules.insert(getBlockName(soluteMolecules[i]));
+
+  if (solventComps.size() != solventComponents.size()) {
+    sprintf(painCave.errMsg, "solvationBuilder could not find all of the "
+            "component blocks in the MetaData of %s.\n",
+            solventFileName.c_str());
+    painCave.severity = OPENMD_ERROR;
+    painCave.isFatal = 1;
+    simError();
+  }
+
+  std::ostringstream metaData;
+  metaData << soluteInfo->getRawMetaData() << "\n";
+  for (unsigned int i = 0; i < solventIncludes.size(); i++)
+    if (knownIncludes.find(solventIncludes[i]) == knownIncludes.end())
+      metaData << solventIncludes[i] << "\n";
+  for (unsigned int i = 0; i < solventMolecules.size(); i++)
+    if (knownMolecules.find(getBlockName(solventMolecules[i])) ==
+        knownMolecules.end())
+      metaData << solventMolecules[i] << "\n";
+  for (unsigned int i = 0; i < solventComps.size(); i++)
+    if (nKept[i] > 0)
+      metaData << setBlockNMol(solventComps[i], nKept[i]) << "\n";
+
+  ofstream newMdFile(outputFileName.c_str());
+  newMdFile << "<OpenMD version=2>" << std::endl;
+  newMdFile << "  <MetaData>" << std::endl;
+  newMdFile << metaData.str();
+  newMdFile << "  </MetaData>" << std::endl;
+  newMdFile << "</OpenMD>" << std::endl;
+  newMdFile.close();
+
+  SimCreator newCreator;
+  SimInfo* newInfo = newCreator.createSim(outputFileName, false);
+  Snapshot* newSnap = newInfo->getSnapshotManager()->getCurrentSnapshot();
+  newSnap->setHmat(hmat);
+  newSnap->setTime(soluteSnap->getTime());
+  newSnap->setID(soluteSnap->getID());
+
+  // copy the solute, then the surviving solvent component by
+  // component, into the new system:
+
+  Molecule::IntegrableObjectIterator ii;
+  StuntDouble* sd;
+  StuntDouble* sdNew;
+  int newIndex = 0;
+
+  for (mol = soluteInfo->beginMolecule(mi); mol != NULL;
+       mol = soluteInfo->nextMolecule(mi)) {
+    for (sd = mol->beginIntegrableObject(ii); sd != NULL;
+         sd = mol->nextIntegrableObject(ii)) {
+      sdNew = newInfo->getIOIndexToIntegrableObject(newIndex++);
+      sdNew->setPos(sd->getPos());
+      sdNew->setVel(sd->getVel());
+      if (sd->isDirectional()) {
+        sdNew->setA(sd->getA());
+        sdNew->setJ(sd->getJ());
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < solventComponents.size(); i++) {
+    for (int c = 0; c < nCandidates; c++) {
+      if (!keep[c] || componentOf[candidates[c].molecule] != int(i))
+        continue;
+      mol = solventInfo->getMoleculeByGlobalIndex(candidates[c].molecule);
+      for (sd = mol->beginIntegrableObject(ii); sd != NULL;
+           sd = mol->nextIntegrableObject(ii)) {
+        sdNew = newInfo->getIOIndexToIntegrableObject(newIndex++);
+        sdNew->setPos(sd->getPos() + candidates[c].shift);
+        sdNew->setVel(sd->getVel());
+        if (sd->isDirectional()) {
+          sdNew->setA(sd->getA());
+          sdNew->setJ(sd->getJ());
+        }
+      }
+    }
+  }
+
+  RigidBodyBatch rbBatch(newInfo);
+  rbBatch.build();
+  rbBatch.updateAtoms();
+  rbBatch.updateAtomVel();
+
+  DumpWriter* writer = new DumpWriter(newInfo, outputFileName);
+
+  if (writer == NULL) {
+    sprintf(painCave.errMsg, "error in creating DumpWriter");
+    painCave.severity = OPENMD_ERROR;
+    painCave.isFatal = 1;
+    simError();
+  }
+
+  writer->writeDump();
+
+  // deleting the writer will put the closing at the end of the dump file.
+
+  delete writer;
+
+  sprintf(painCave.errMsg, "solvationBuilder: %d solvent tiles were "
+          "examined, and %d of %d candidate solvent molecules were kept.\n",
+          nTiles[0] * nTiles[1] * nTiles[2], nKeptTotal, nCandidates);
+  painCave.severity = OPENMD_INFO;
+  painCave.isFatal = 0;
+  simError();
+
+  sprintf(painCave.errMsg,
+          "A new OpenMD file called \"%s\" has been generated.\n",
+          outputFileName.c_str());
+  painCave.severity = OPENMD_INFO;
+  painCave.isFatal = 0;
+  simError();
+
+  delete newInfo;
+  delete solventInfo;
+  delete soluteInfo;
+
+  return 0;
+}
+
+void scanMetaData(const string& raw, vector<string>& includes,
+                  vector<string>& molecules, vector<string>& components) {
+  std::size_t i = 0;
+  std::size_t n = raw.size();
+
+  while (i < n) {
+    char ch = raw[i];
+
+    if (isspace(ch) || ch == ';') {
+      i++;
+    } else if (raw.compare(i, 2, "//") == 0) {
+      i = raw.find('\n', i);
+      if (i == string::npos) i = n;
+    } else if (raw.compare(i, 2, "/*") == 0) {
+      i = raw.find("*/", i);
+      i = (i == string::npos) ? n : i + 2;
+    } else if (ch == '#') {
+      std::size_t end = raw.find('\n', i);
+      if (end == string::npos) end = n;
+      string line = raw.substr(i, end - i);
+      if (line.compare(0, 8, "#include") == 0)
+        includes.push_back(trimRightCopy(line));
+      i = end;
+    } else {
+      // a statement: either "keyword = value;" or "keyword { ... }"
+      std::size_t start = i;
+      while (i < n && raw[i] != ';' && raw[i] != '{') i++;
+      if (i < n && raw[i] == '{') {
+        string keyword = trimCopy(raw.substr(start, i - start));
+        int depth = 0;
+        for (; i < n; i++) {
+          if (raw[i] == '{') depth++;
+          else if (raw[i] == '}' && --depth == 0) break;
+        }
+        i = min(i + 1, n);
+        if (keyword == "molecule")
+          molecules.push_back(raw.substr(start, i - start));
+        else if (keyword == "component")
+          components.push_back(raw.substr(start, i - start));
+      } else {
+        i++;
+      }
+    }
+  }
+}
+
+string getBlockName(const string& block) {
+  std::size_t i = block.find("name");
+  if (i == string::npos) return string();
+  std::size_t eq = block.find('=', i);
+  std::size_t end = block.find(';', eq);
+  if (eq == string::npos || end == string::npos) return string();
+  string name = trimCopy(block.substr(eq + 1, end - eq - 1));
+  if (name.size() >= 2 && name[0] == '"')
+    name = name.substr(1, name.size() - 2);
+  return name;
+}
+
+string setBlockNMol(const string& block, int nMol) {
+  std::size_t i = block.find("nMol");
+  if (i == string::npos) return block;
+  std::size_t end = block.find(';', i);
+  std::ostringstream nMolStatement;
+  nMolStatement << "nMol = " << nMol;
+  return block.substr(0, i) + nMolStatement.str() + block.substr(end);
+}
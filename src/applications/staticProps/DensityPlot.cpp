@@ -116,26 +116,16 @@ namespace OpenMD {
         }
             
         Atom* atom = static_cast<Atom*>(sd);
-        GenericData* data = atom->getAtomType()->getPropertyByName("nelectron");
-        if (data == NULL) {
+        int ident = atom->getAtomType()->getIdent();
+        if (!getTypeParameters(atom->getAtomType())) {
           sprintf( painCave.errMsg, "Can not find Parameters for nelectron\n");
           painCave.severity = OPENMD_ERROR;
           painCave.isFatal = 1;
           simError(); 
         }
             
-        DoubleGenericData* doubleData = dynamic_cast<DoubleGenericData*>(data);
-        if (doubleData == NULL) {
-          sprintf( painCave.errMsg,
-                   "Can not cast GenericData to DoubleGenericData\n");
-          painCave.severity = OPENMD_ERROR;
-          painCave.isFatal = 1;
-          simError();   
-        }
-            
-        RealType nelectron = doubleData->getData();
-        LennardJonesAdapter lja = LennardJonesAdapter(atom->getAtomType());
-        RealType sigma = lja.getSigma() * 0.5;
+        RealType nelectron = nElectrons_[ident];
+        RealType sigma = sigmas_[ident];
         RealType sigma2 = sigma * sigma;
             
         Vector3d pos = sd->getPos() - origin;
@@ -167,6 +157,30 @@ namespace OpenMD {
   
   }
 
+  bool DensityPlot::getTypeParameters(AtomType* atype) {
+    // the parameters are looked up once per atom type and cached by
+    // the type's ident, rather than searched for on every atom
+    int ident = atype->getIdent();
+
+    if (ident >= int(haveType_.size())) {
+      haveType_.resize(ident + 1, false);
+      nElectrons_.resize(ident + 1, 0.0);
+      sigmas_.resize(ident + 1, 0.0);
+    }
+
+    if (!haveType_[ident]) {
+      GenericData* data = atype->getPropertyByName("nelectron");
+      DoubleGenericData* doubleData = dynamic_cast<DoubleGenericData*>(data);
+      if (doubleData == NULL) return false;
+
+      LennardJonesAdapter lja = LennardJonesAdapter(atype);
+      nElectrons_[ident] = doubleData->getData();
+      sigmas_[ident] = lja.getSigma() * 0.5;
+      haveType_[ident] = true;
+    }
+    return true;
+  }
+
   Vector3d DensityPlot::calcNewOrigin() {
 
     int i;
@@ -63,6 +63,7 @@ namespace OpenMD {
 
         private:
             Vector3d calcNewOrigin();
+            bool getTypeParameters(AtomType* atype);
             
             void writeDensity();            
 
@@ -81,6 +82,9 @@ namespace OpenMD {
             SelectionManager cmSeleMan_;
             SelectionEvaluator cmEvaluator_;
 
+            std::vector<bool> haveType_;
+            std::vector<RealType> nElectrons_;
+            std::vector<RealType> sigmas_;
             
     };
 }
@@ -56,7 +56,8 @@ namespace OpenMD {
     : SnapshotManager(storageLayout), info_(info), 
       blockCapacity_(blockCapacity), memSize_(memSize), 
       activeBlocks_(blockCapacity_, -1), 
-      activeRefCount_(blockCapacity_, 0) {
+      activeRefCount_(blockCapacity_, 0), lastUse_(blockCapacity_, 0),
+      useClock_(0), nHits_(0), nMisses_(0), nEvictions_(0) {
     
     nAtoms_ = info->getNGlobalAtoms();
     nRigidBodies_ = info->getNGlobalRigidBodies();
@@ -144,9 +145,26 @@ namespace OpenMD {
     std::vector<int>::iterator i;
     for (i = activeBlocks_.begin(); i != activeBlocks_.end(); ++i) {
       if (*i != -1) {
-	unloadBlock(*i);
+	internalUnload(*i);
       }
     }
+
+    unsigned long requests = nHits_ + nMisses_;
+    if (requests > 0) {
+      std::cout << "-----------------------------------------------------"
+                << std::endl;
+      std::cout << "BlockSnapshotManager cache report:" << std::endl;
+      std::cout << "\n";
+      std::cout << "             Block requests:\t" << requests << std::endl;
+      std::cout << "                       Hits:\t" << nHits_ << std::endl;
+      std::cout << "                     Misses:\t" << nMisses_ << std::endl;
+      std::cout << "                  Evictions:\t" << nEvictions_ 
+                << std::endl;
+      std::cout << "                   Hit rate:\t" << getHitRate() 
+                << std::endl;
+      std::cout << "-----------------------------------------------------"
+                << std::endl;
+    }
   }
 
   Snapshot* BlockSnapshotManager::getSnapshot(int id) { 
@@ -172,22 +190,28 @@ namespace OpenMD {
     std::vector<int>::iterator i = findActiveBlock(block);
     bool loadSuccess(false);
     if (i != activeBlocks_.end()) {
-      // If the block is already in memory, just increase the
-      // reference count:
+      // If the block is already in memory (possibly left over from an
+      // earlier request), just increase the reference count:
       ++activeRefCount_[i - activeBlocks_.begin()];
+      lastUse_[i - activeBlocks_.begin()] = ++useClock_;
+      ++nHits_;
       loadSuccess = true;
     } else if (getNActiveBlocks() < blockCapacity_){
       // If the number of active blocks is less than the block
       // capacity, just load the block:
+      ++nMisses_;
       internalLoad(block);
       loadSuccess = true;
     } else if ( hasZeroRefBlock() ) {
       // If we have already reached the block capacity, we need to
-      // unload a block with 0 references:
-      int zeroRefBlock = getFirstZeroRefBlock();
+      // evict the unreferenced block that has gone unused the longest:
+      ++nMisses_;
+      int zeroRefBlock = getLeastRecentlyUsedZeroRefBlock();
       assert(zeroRefBlock != -1);
       internalUnload(zeroRefBlock);
+      ++nEvictions_;
       internalLoad(block);
+      loadSuccess = true;
     } else {
       // We have reached capacity and all blocks in memory are have
       // non-zero references:
@@ -207,9 +231,8 @@ namespace OpenMD {
 	activeRefCount_[i - activeBlocks_.begin()]  = 0;
       }
 
-      if (activeRefCount_[i-activeBlocks_.begin()] == 0) {
-        internalUnload(block);
-      }
+      // The frames stay in memory until loadBlock needs the space
+      // for another block.
         
       unloadSuccess = true;
     } else {
@@ -219,6 +242,17 @@ namespace OpenMD {
     return unloadSuccess;
   }
 
+  void BlockSnapshotManager::prefetchBlock(int block) {
+    if (block < 0 || block >= getNBlocks()) return;
+    if (isBlockActive(block)) return;
+    reader_->prefetchFrames(blocks_[block].first, blocks_[block].second);
+  }
+
+  RealType BlockSnapshotManager::getHitRate() {
+    unsigned long requests = nHits_ + nMisses_;
+    return requests > 0 ? RealType(nHits_) / RealType(requests) : 0.0;
+  }
+
   void BlockSnapshotManager::internalLoad(int block) {
         
     for (int i = blocks_[block].first; i < blocks_[block].second; ++i) {
@@ -230,6 +264,7 @@ namespace OpenMD {
     assert(j != activeBlocks_.end());
     *j = block;    
     ++activeRefCount_[j - activeBlocks_.begin()];
+    lastUse_[j - activeBlocks_.begin()] = ++useClock_;
   }
 
   void BlockSnapshotManager::internalUnload(int block) {
@@ -241,6 +276,7 @@ namespace OpenMD {
     j = std::find(activeBlocks_.begin(), activeBlocks_.end(), block);
     assert(j != activeBlocks_.end());
     *j = -1;
+    activeRefCount_[j - activeBlocks_.begin()] = 0;
   }
 
   bool BlockSnapshotManager::hasZeroRefBlock(){
@@ -248,11 +284,14 @@ namespace OpenMD {
       != activeRefCount_.end() ?  true : false;
   }
   
-  int BlockSnapshotManager::getFirstZeroRefBlock(){
-    std::vector<int>::iterator i = std::find(activeRefCount_.begin(),
-                                             activeRefCount_.end(), 0);
-    return i != activeRefCount_.end() ?
-      activeBlocks_[i - activeRefCount_.begin()] : -1;
+  int BlockSnapshotManager::getLeastRecentlyUsedZeroRefBlock(){
+    int lru = -1;
+    for (int i = 0; i < blockCapacity_; ++i) {
+      if (activeBlocks_[i] != -1 && activeRefCount_[i] == 0) {
+        if (lru == -1 || lastUse_[i] < lastUse_[lru]) lru = i;
+      }
+    }
+    return lru != -1 ? activeBlocks_[lru] : -1;
   }
 
   std::vector<int> BlockSnapshotManager::getActiveBlocks() {
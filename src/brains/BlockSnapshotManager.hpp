@@ -53,7 +53,13 @@ namespace OpenMD {
 
   /**
    * @class BlockSnapshotManager
-   * @todo document
+   * @brief Holds a trajectory in memory a block of frames at a time.
+   *
+   * At most blockCapacity blocks are resident.  Unloading a block
+   * only drops its reference count; the frames stay cached until the
+   * space is needed, and the least recently used unreferenced block
+   * is evicted first.  Callers that know which block they will need
+   * next can ask for it to be prefetched.
    */
   class BlockSnapshotManager : public SnapshotManager{
 
@@ -88,6 +94,16 @@ namespace OpenMD {
         
     bool unloadBlock(int block);
 
+    /**
+     * Starts reading a block that will be loaded soon.  The disk
+     * reads happen in the background; the frames are still parsed by
+     * loadBlock.
+     */
+    void prefetchBlock(int block);
+
+    /** Returns the fraction of loadBlock calls served from memory */
+    RealType getHitRate();
+
     std::vector<int> getActiveBlocks();
 
     int getBlockCapacity() {
@@ -104,7 +120,7 @@ namespace OpenMD {
 
     bool hasZeroRefBlock();
 
-    int getFirstZeroRefBlock();
+    int getLeastRecentlyUsedZeroRefBlock();
 
     void internalLoad(int block);
     void internalUnload(int block);
@@ -118,6 +134,12 @@ namespace OpenMD {
     std::vector<SnapshotBlock> blocks_;        
     std::vector<int> activeBlocks_;
     std::vector<int> activeRefCount_;
+    std::vector<unsigned long> lastUse_;
+    unsigned long useClock_;
+
+    unsigned long nHits_;
+    unsigned long nMisses_;
+    unsigned long nEvictions_;
         
     int nAtoms_;
     int nRigidBodies_;
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2014 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2014).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+
+#include <typeinfo>
+#include "brains/BondedBatch.hpp"
+#include "primitives/Molecule.hpp"
+#include "types/HarmonicBondType.hpp"
+#include "types/HarmonicBendType.hpp"
+#include "types/PolynomialTorsionType.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMD {
+
+  BondedBatch::BondedBatch(SimInfo* info) : info_(info), bondPotential_(0.0),
+                                            bendPotential_(0.0),
+                                            torsionPotential_(0.0) {}
+
+  void BondedBatch::build() {
+    SimInfo::MoleculeIterator mi;
+    Molecule::BondIterator bondIter;
+    Molecule::BendIterator bendIter;
+    Molecule::TorsionIterator torsionIter;
+    Molecule* mol;
+    Bond* bond;
+    Bend* bend;
+    Torsion* torsion;
+    std::map<PolynomialTorsionType*, std::pair<int, int> > polyMap;
+    std::map<PolynomialTorsionType*, std::pair<int, int> >::iterator pi;
+
+    bonds_.clear();      bondAtoms_.clear();
+    bondR0_.clear();     bondK_.clear();
+    bends_.clear();      bendAtoms_.clear();
+    bendTheta0_.clear(); bendK_.clear();
+    torsions_.clear();   torsionAtoms_.clear();
+    torsionCoeffStart_.clear();
+    torsionDegree_.clear();
+    torsionCoeffs_.clear();
+    otherBonds_.clear();
+    otherBends_.clear();
+    otherTorsions_.clear();
+
+    for (mol = info_->beginMolecule(mi); mol != NULL;
+         mol = info_->nextMolecule(mi)) {
+
+      for (bond = mol->beginBond(bondIter); bond != NULL;
+           bond = mol->nextBond(bondIter)) {
+        HarmonicBondType* hbt =
+          dynamic_cast<HarmonicBondType*>(bond->getBondType());
+
+        if (hbt != NULL && typeid(*hbt) == typeid(HarmonicBondType)) {
+          bonds_.push_back(bond);
+          bondAtoms_.push_back(bond->getAtomA()->getLocalIndex());
+          bondAtoms_.push_back(bond->getAtomB()->getLocalIndex());
+          bondR0_.push_back(hbt->getEquilibriumBondLength());
+          bondK_.push_back(hbt->getForceConstant());
+        } else {
+          otherBonds_.push_back(bond);
+        }
+      }
+
+      for (bend = mol->beginBend(bendIter); bend != NULL;
+           bend = mol->nextBend(bendIter)) {
+        HarmonicBendType* hbt =
+          dynamic_cast<HarmonicBendType*>(bend->getBendType());
+
+        // Urey-Bradley and SDK bends derive from the harmonic bend
+        // but add their own terms, and ghost bends use the
+        // orientation of a directional atom:
+        if (hbt != NULL && typeid(*hbt) == typeid(HarmonicBendType) &&
+            typeid(*bend) == typeid(Bend)) {
+          bends_.push_back(bend);
+          bendAtoms_.push_back(bend->getAtomA()->getLocalIndex());
+          bendAtoms_.push_back(bend->getAtomB()->getLocalIndex());
+          bendAtoms_.push_back(bend->getAtomC()->getLocalIndex());
+          bendTheta0_.push_back(hbt->getTheta());
+          bendK_.push_back(hbt->getForceConstant());
+        } else {
+          otherBends_.push_back(bend);
+        }
+      }
+
+      for (torsion = mol->beginTorsion(torsionIter); torsion != NULL;
+           torsion = mol->nextTorsion(torsionIter)) {
+        PolynomialTorsionType* ptt =
+          dynamic_cast<PolynomialTorsionType*>(torsion->getTorsionType());
+
+        if (ptt == NULL || typeid(*torsion) != typeid(Torsion)) {
+          otherTorsions_.push_back(torsion);
+          continue;
+        }
+
+        // flatten each polynomial type only once.  Polynomials with
+        // negative powers of cos(phi) can't be evaluated by Horner's
+        // rule, so those types are remembered with a start of -1 and
+        // their torsions stay on the virtual calcForce path:
+        pi = polyMap.find(ptt);
+        if (pi == polyMap.end()) {
+          const DoublePolynomial& poly = ptt->getPolynomial();
+          DoublePolynomial::const_iterator ci;
+          int degree = 0;
+          int start = -1;
+          bool dense = true;
+
+          for (ci = poly.begin(); ci != poly.end(); ++ci) {
+            if (ci->first < 0) dense = false;
+            degree = std::max(degree, ci->first);
+          }
+
+          if (dense) {
+            start = torsionCoeffs_.size();
+            torsionCoeffs_.resize(start + degree + 1, 0.0);
+            for (ci = poly.begin(); ci != poly.end(); ++ci)
+              torsionCoeffs_[start + ci->first] += ci->second;
+          }
+
+          pi = polyMap.insert(std::make_pair(ptt, std::make_pair(start,
+                                                                 degree))).first;
+        }
+
+        if (pi->second.first < 0) {
+          otherTorsions_.push_back(torsion);
+          continue;
+        }
+
+        torsions_.push_back(torsion);
+        torsionAtoms_.push_back(torsion->getAtomA()->getLocalIndex());
+        torsionAtoms_.push_back(torsion->getAtomB()->getLocalIndex());
+        torsionAtoms_.push_back(torsion->getAtomC()->getLocalIndex());
+        torsionAtoms_.push_back(torsion->getAtomD()->getLocalIndex());
+        torsionCoeffStart_.push_back(pi->second.first);
+        torsionDegree_.push_back(pi->second.second);
+      }
+    }
+
+    bondForce_.resize(bonds_.size());
+    bondPot_.assign(bonds_.size(), 0.0);
+    bendForce_.resize(2 * bends_.size());
+    bendPot_.assign(bends_.size(), 0.0);
+    torsionForce_.resize(3 * torsions_.size());
+    torsionPot_.assign(torsions_.size(), 0.0);
+    torsionValid_.assign(torsions_.size(), 0);
+  }
+
+  void BondedBatch::calcForces(bool doParticlePot) {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+
+    calcBondForces(snap);
+    calcBendForces(snap);
+    calcTorsionForces(snap);
+    scatterForces(snap, doParticlePot);
+  }
+
+  void BondedBatch::calcBondForces(Snapshot* snap) {
+    std::vector<Vector3d>& pos = snap->atomData.position;
+    int nBonds = bonds_.size();
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < nBonds; i++) {
+      Vector3d r12 = pos[bondAtoms_[2*i+1]] - pos[bondAtoms_[2*i]];
+      snap->wrapVector(r12);
+      RealType len = r12.length();
+      RealType dr = len - bondR0_[i];
+      RealType dvdr = bondK_[i] * dr;
+
+      bondPot_[i] = 0.5 * bondK_[i] * dr * dr;
+      bondForce_[i] = r12 * (-dvdr / len);
+    }
+  }
+
+  void BondedBatch::calcBendForces(Snapshot* snap) {
+    std::vector<Vector3d>& pos = snap->atomData.position;
+    int nBends = bends_.size();
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < nBends; i++) {
+      const Vector3d& pos2 = pos[bendAtoms_[3*i+1]];
+
+      Vector3d r21 = pos[bendAtoms_[3*i]] - pos2;
+      snap->wrapVector(r21);
+      RealType d21 = r21.length();
+      RealType d21inv = 1.0 / d21;
+
+      Vector3d r23 = pos[bendAtoms_[3*i+2]] - pos2;
+      snap->wrapVector(r23);
+      RealType d23 = r23.length();
+      RealType d23inv = 1.0 / d23;
+
+      RealType cosTheta = dot(r21, r23) / (d21 * d23);
+
+      //check roundoff
+      if (cosTheta > 1.0) {
+        cosTheta = 1.0;
+      } else if (cosTheta < -1.0) {
+        cosTheta = -1.0;
+      }
+
+      RealType delta = acos(cosTheta) - bendTheta0_[i];
+      RealType dVdTheta = bendK_[i] * delta;
+      bendPot_[i] = 0.5 * bendK_[i] * delta * delta;
+
+      RealType sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+      if (fabs(sinTheta) < 1.0E-6) {
+        sinTheta = 1.0E-6;
+      }
+
+      RealType commonFactor1 = dVdTheta / sinTheta * d21inv;
+      RealType commonFactor2 = dVdTheta / sinTheta * d23inv;
+
+      bendForce_[2*i]   = commonFactor1 * (r23 * d23inv - r21*d21inv*cosTheta);
+      bendForce_[2*i+1] = commonFactor2 * (r21 * d21inv - r23*d23inv*cosTheta);
+    }
+  }
+
+  void BondedBatch::calcTorsionForces(Snapshot* snap) {
+    std::vector<Vector3d>& pos = snap->atomData.position;
+    int nTorsions = torsions_.size();
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < nTorsions; i++) {
+      const int* atoms = &torsionAtoms_[4*i];
+
+      Vector3d r21 = pos[atoms[0]] - pos[atoms[1]];
+      snap->wrapVector(r21);
+      Vector3d r32 = pos[atoms[1]] - pos[atoms[2]];
+      snap->wrapVector(r32);
+      Vector3d r43 = pos[atoms[2]] - pos[atoms[3]];
+      snap->wrapVector(r43);
+
+      Vector3d A = cross(r21, r32);
+      RealType rA = A.length();
+      Vector3d B = cross(r32, r43);
+      RealType rB = B.length();
+
+      // colinear atoms leave the torsion (and its previous potential)
+      // untouched, just as Torsion::calcForce does:
+      if (rA * rB < OpenMD::epsilon) {
+        torsionValid_[i] = 0;
+        continue;
+      }
+      torsionValid_[i] = 1;
+
+      A.normalize();
+      B.normalize();
+
+      RealType cos_phi = dot(A, B);
+      if (cos_phi > 1.0) cos_phi = 1.0;
+      if (cos_phi < -1.0) cos_phi = -1.0;
+
+      // Horner evaluation of the polynomial and its derivative:
+      const RealType* c = &torsionCoeffs_[torsionCoeffStart_[i]];
+      RealType V = c[torsionDegree_[i]];
+      RealType dVdcosPhi = 0.0;
+      for (int n = torsionDegree_[i] - 1; n >= 0; n--) {
+        dVdcosPhi = dVdcosPhi * cos_phi + V;
+        V = V * cos_phi + c[n];
+      }
+      torsionPot_[i] = V;
+
+      Vector3d dcosdA = (cos_phi * A - B) / rA;
+      Vector3d dcosdB = (cos_phi * B - A) / rB;
+
+      torsionForce_[3*i]   = dVdcosPhi * cross(r32, dcosdA);
+      torsionForce_[3*i+1] = dVdcosPhi * (cross(r43, dcosdB) -
+                                          cross(r21, dcosdA));
+      torsionForce_[3*i+2] = dVdcosPhi * cross(dcosdB, r32);
+    }
+  }
+
+  void BondedBatch::scatterForces(Snapshot* snap, bool doParticlePot) {
+    std::vector<Vector3d>& frc = snap->atomData.force;
+    std::vector<RealType>& ppot = snap->atomData.particlePot;
+    std::size_t i;
+    int a;
+
+    bondPotential_ = 0.0;
+    for (i = 0; i < bonds_.size(); i++) {
+      frc[bondAtoms_[2*i]]   -= bondForce_[i];
+      frc[bondAtoms_[2*i+1]] += bondForce_[i];
+      bondPotential_ += bondPot_[i];
+      bonds_[i]->setPotential(bondPot_[i]);
+      if (doParticlePot) {
+        for (a = 0; a < 2; a++) ppot[bondAtoms_[2*i+a]] += bondPot_[i];
+      }
+    }
+
+    bendPotential_ = 0.0;
+    for (i = 0; i < bends_.size(); i++) {
+      const Vector3d& force1 = bendForce_[2*i];
+      const Vector3d& force3 = bendForce_[2*i+1];
+      frc[bendAtoms_[3*i]]   += force1;
+      frc[bendAtoms_[3*i+1]] -= force1 + force3;
+      frc[bendAtoms_[3*i+2]] += force3;
+      bendPotential_ += bendPot_[i];
+      bends_[i]->setPotential(bendPot_[i]);
+      if (doParticlePot) {
+        for (a = 0; a < 3; a++) ppot[bendAtoms_[3*i+a]] += bendPot_[i];
+      }
+    }
+
+    torsionPotential_ = 0.0;
+    for (i = 0; i < torsions_.size(); i++) {
+      torsionPotential_ += torsionPot_[i];
+      if (!torsionValid_[i]) continue;
+
+      const Vector3d& f1 = torsionForce_[3*i];
+      const Vector3d& f2 = torsionForce_[3*i+1];
+      const Vector3d& f3 = torsionForce_[3*i+2];
+      frc[torsionAtoms_[4*i]]   += f1;
+      frc[torsionAtoms_[4*i+1]] += f2 - f1;
+      frc[torsionAtoms_[4*i+2]] += f3 - f2;
+      frc[torsionAtoms_[4*i+3]] -= f3;
+      torsions_[i]->setPotential(torsionPot_[i]);
+      if (doParticlePot) {
+        for (a = 0; a < 4; a++) ppot[torsionAtoms_[4*i+a]] += torsionPot_[i];
+      }
+    }
+  }
+
+  RealType BondedBatch::getSelectionPotential(SelectionManager& seleMan) {
+    RealType selectionPotential(0.0);
+    std::size_t i;
+
+    for (i = 0; i < bonds_.size(); i++) {
+      if (seleMan.isSelected(bonds_[i]->getAtomA()) ||
+          seleMan.isSelected(bonds_[i]->getAtomB()))
+        selectionPotential += bondPot_[i];
+    }
+
+    for (i = 0; i < bends_.size(); i++) {
+      if (seleMan.isSelected(bends_[i]->getAtomA()) ||
+          seleMan.isSelected(bends_[i]->getAtomB()) ||
+          seleMan.isSelected(bends_[i]->getAtomC()))
+        selectionPotential += bendPot_[i];
+    }
+
+    for (i = 0; i < torsions_.size(); i++) {
+      if (seleMan.isSelected(torsions_[i]->getAtomA()) ||
+          seleMan.isSelected(torsions_[i]->getAtomB()) ||
+          seleMan.isSelected(torsions_[i]->getAtomC()) ||
+          seleMan.isSelected(torsions_[i]->getAtomD()))
+        selectionPotential += torsionPot_[i];
+    }
+
+    return selectionPotential;
+  }
+
+}
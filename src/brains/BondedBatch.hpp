@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2014 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2014).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#ifndef BRAINS_BONDEDBATCH_HPP
+#define BRAINS_BONDEDBATCH_HPP
+
+#include <vector>
+#include "brains/SimInfo.hpp"
+#include "primitives/Bond.hpp"
+#include "primitives/Bend.hpp"
+#include "primitives/Torsion.hpp"
+#include "selection/SelectionManager.hpp"
+
+namespace OpenMD {
+
+  /**
+   * @class BondedBatch BondedBatch.hpp "brains/BondedBatch.hpp"
+   *
+   * Evaluates the most common bonded functional forms (harmonic
+   * bonds, harmonic bends and polynomial-in-cos(phi) torsions, which
+   * covers the CHARMM, OPLS and TraPPE torsion types) for all local
+   * molecules at once.
+   *
+   * When the batch is built, the interactions of each functional
+   * form are flattened into contiguous arrays of local atom indices
+   * and parameters.  Each group is evaluated in a threaded loop that
+   * stores per-interaction forces, and the forces are then scattered
+   * onto the atoms serially so that no atomic updates are needed.
+   * Interactions with any other functional form (and the ghost bends
+   * and torsions which involve directional atoms) are handed back to
+   * the caller through the getOther* lists.
+   */
+  class BondedBatch {
+  public:
+    BondedBatch(SimInfo* info);
+
+    /**
+     * Flattens the bonded interactions of the local molecules.  This
+     * must be called after the SimInfo has been created.
+     */
+    void build();
+
+    /** Computes the forces of all batched interactions. */
+    void calcForces(bool doParticlePot);
+
+    RealType getBondPotential() { return bondPotential_; }
+    RealType getBendPotential() { return bendPotential_; }
+    RealType getTorsionPotential() { return torsionPotential_; }
+
+    /**
+     * Returns the potential of the batched interactions which involve
+     * at least one selected atom.
+     */
+    RealType getSelectionPotential(SelectionManager& seleMan);
+
+    std::vector<Bond*>& getOtherBonds() { return otherBonds_; }
+    std::vector<Bend*>& getOtherBends() { return otherBends_; }
+    std::vector<Torsion*>& getOtherTorsions() { return otherTorsions_; }
+
+  private:
+    void calcBondForces(Snapshot* snap);
+    void calcBendForces(Snapshot* snap);
+    void calcTorsionForces(Snapshot* snap);
+    void scatterForces(Snapshot* snap, bool doParticlePot);
+
+    SimInfo* info_;
+
+    // harmonic bonds
+    std::vector<Bond*> bonds_;
+    std::vector<int> bondAtoms_;          /**< 2 local atom indices per bond */
+    std::vector<RealType> bondR0_;
+    std::vector<RealType> bondK_;
+    std::vector<Vector3d> bondForce_;     /**< force on the second atom */
+    std::vector<RealType> bondPot_;
+
+    // harmonic bends
+    std::vector<Bend*> bends_;
+    std::vector<int> bendAtoms_;          /**< 3 local atom indices per bend */
+    std::vector<RealType> bendTheta0_;
+    std::vector<RealType> bendK_;
+    std::vector<Vector3d> bendForce_;     /**< forces on the first and third atoms */
+    std::vector<RealType> bendPot_;
+
+    // polynomial torsions
+    std::vector<Torsion*> torsions_;
+    std::vector<int> torsionAtoms_;       /**< 4 local atom indices per torsion */
+    std::vector<int> torsionCoeffStart_;  /**< offset into torsionCoeffs_ */
+    std::vector<int> torsionDegree_;
+    std::vector<RealType> torsionCoeffs_; /**< dense coefficients, lowest power first */
+    std::vector<Vector3d> torsionForce_;  /**< f1, f2 and f3 of each torsion */
+    std::vector<RealType> torsionPot_;
+    std::vector<char> torsionValid_;      /**< false for colinear torsions */
+
+    std::vector<Bond*> otherBonds_;
+    std::vector<Bend*> otherBends_;
+    std::vector<Torsion*> otherTorsions_;
+
+    RealType bondPotential_;
+    RealType bendPotential_;
+    RealType torsionPotential_;
+  };
+
+}
+#endif
@@ -72,20 +72,43 @@ namespace OpenMD {
   ForceManager::ForceManager(SimInfo * info) : initialized_(false), info_(info),
                                                switcher_(NULL),
                                                seleMan_(info),
-                                               evaluator_(info) {
+                                               evaluator_(info),
+                                               nGroupPairs_(0),
+                                               nGroupAtomPairs_(0),
+                                               nDirectAtomPairs_(0),
+                                               forceGroups_(ALL_FORCE_GROUPS),
+                                               chargeOnly_(false) {
     forceField_ = info_->getForceField();
     interactionMan_ = new InteractionManager();
     fDecomp_ = new ForceMatrixDecomposition(info_, interactionMan_);
     thermo = new Thermo(info_);
+    rbBatch_ = new RigidBodyBatch(info_);
+    bondedBatch_ = new BondedBatch(info_);
   }
 
   ForceManager::~ForceManager() {
     perturbations_.clear();
 
+    if (nGroupPairs_ > 0 && info_->getSimParams()->getPrintDiagnostics()) {
+      RealType percent = (nGroupAtomPairs_ > 0) ?
+        100.0 * RealType(nDirectAtomPairs_) / RealType(nGroupAtomPairs_) : 0.0;
+      sprintf(painCave.errMsg,
+              "ForceManager: %lu cutoff group pairs were inside the cutoff.\n"
+              "\t%lu atom pairs belonged to multi-atom groups, and %lu of\n"
+              "\tthese (%.1f%%) were bounded well enough to skip\n"
+              "\tperiodic wrapping.\n", nGroupPairs_, nGroupAtomPairs_,
+              nDirectAtomPairs_, percent);
+      painCave.severity = OPENMD_INFO;
+      painCave.isFatal = 0;
+      simError();
+    }
+
     delete switcher_;
     delete interactionMan_;
     delete fDecomp_;
     delete thermo;
+    delete rbBatch_;
+    delete bondedBatch_;
   }
 
   /**
@@ -453,6 +476,9 @@ namespace OpenMD {
 
     fDecomp_->distributeInitialData();
 
+    rbBatch_->build();
+    bondedBatch_->build();
+
     doPotentialSelection_ = false;
     if (info_->getSimParams()->havePotentialSelection()) {
       doPotentialSelection_ = true;
@@ -472,11 +498,31 @@ namespace OpenMD {
 
     if (!initialized_) initialize();
     preCalculation();
-    shortRangeInteractions();
+    if (forceGroups_ & BONDED_FORCE_GROUP)
+      shortRangeInteractions();
     longRangeInteractions();
     postCalculation();
   }
 
+  void ForceManager::calcChargeForces() {
+
+    if (!initialized_) initialize();
+
+    // bonded terms don't depend on the charges:
+    int groups = forceGroups_;
+    forceGroups_ = PAIR_FORCE_GROUP | RECIPROCAL_FORCE_GROUP;
+    chargeOnly_ = true;
+    interactionMan_->setChargeOnly(true);
+
+    ForceManager::preCalculation();
+    ForceManager::longRangeInteractions();
+    ForceManager::postCalculation();
+
+    interactionMan_->setChargeOnly(false);
+    chargeOnly_ = false;
+    forceGroups_ = groups;
+  }
+
   void ForceManager::preCalculation() {
     SimInfo::MoleculeIterator mi;
     Molecule* mol;
@@ -494,19 +540,25 @@ namespace OpenMD {
 
     fDecomp_->setSnapshot(snap);
 
-    snap->setBondPotential(0.0);
-    snap->setBendPotential(0.0);
-    snap->setTorsionPotential(0.0);
-    snap->setInversionPotential(0.0);
+    // potentials of force groups that are not being evaluated keep
+    // their previous values:
+    if (forceGroups_ & BONDED_FORCE_GROUP) {
+      snap->setBondPotential(0.0);
+      snap->setBendPotential(0.0);
+      snap->setTorsionPotential(0.0);
+      snap->setInversionPotential(0.0);
+    }
 
     potVec zeroPot(0.0);
-    snap->setLongRangePotential(zeroPot);
+    if (forceGroups_ & PAIR_FORCE_GROUP) {
+      snap->setLongRangePotential(zeroPot);
 
-    snap->setExcludedPotentials(zeroPot);
-    if (doPotentialSelection_)
-      snap->setSelectionPotentials(zeroPot);
+      snap->setExcludedPotentials(zeroPot);
+      if (doPotentialSelection_)
+        snap->setSelectionPotentials(zeroPot);
 
-    snap->setSelfPotential(0.0);
+      snap->setSelfPotential(0.0);
+    }
     snap->setRestraintPotential(0.0);
     snap->setRawPotential(0.0);
 
@@ -547,16 +599,11 @@ namespace OpenMD {
 
   void ForceManager::shortRangeInteractions() {
     Molecule* mol;
-    RigidBody* rb;
     Bond* bond;
     Bend* bend;
     Torsion* torsion;
     Inversion* inversion;
     SimInfo::MoleculeIterator mi;
-    Molecule::RigidBodyIterator rbIter;
-    Molecule::BondIterator bondIter;;
-    Molecule::BendIterator  bendIter;
-    Molecule::TorsionIterator  torsionIter;
     Molecule::InversionIterator  inversionIter;
     RealType bondPotential = 0.0;
     RealType bendPotential = 0.0;
@@ -564,92 +611,103 @@ namespace OpenMD {
     RealType inversionPotential = 0.0;
     potVec selectionPotential(0.0);
 
-    //calculate short range interactions
-    for (mol = info_->beginMolecule(mi); mol != NULL;
-         mol = info_->nextMolecule(mi)) {
-
-      //change the positions of atoms which belong to the rigidbodies
-      for (rb = mol->beginRigidBody(rbIter); rb != NULL;
-           rb = mol->nextRigidBody(rbIter)) {
-        rb->updateAtoms();
-      }
+    //change the positions of atoms which belong to the rigidbodies
+    rbBatch_->updateAtoms();
+
+    //calculate the short range interactions that have been batched
+    //by functional form
+    bondedBatch_->calcForces(doParticlePot_);
+    bondPotential += bondedBatch_->getBondPotential();
+    bendPotential += bondedBatch_->getBendPotential();
+    torsionPotential += bondedBatch_->getTorsionPotential();
+    if (doPotentialSelection_) {
+      selectionPotential[BONDED_FAMILY] +=
+        bondedBatch_->getSelectionPotential(seleMan_);
+    }
 
-      for (bond = mol->beginBond(bondIter); bond != NULL;
-           bond = mol->nextBond(bondIter)) {
-        bond->calcForce(doParticlePot_);
-        bondPotential += bond->getPotential();
-        if (doPotentialSelection_) {
-          if (seleMan_.isSelected(bond->getAtomA()) ||
-              seleMan_.isSelected(bond->getAtomB()) ) {
-            selectionPotential[BONDED_FAMILY] += bond->getPotential();
-          }
+    //and then the remaining ones
+    vector<Bond*>& bonds = bondedBatch_->getOtherBonds();
+    for (vector<Bond*>::iterator bi = bonds.begin(); bi != bonds.end(); ++bi) {
+      bond = *bi;
+      bond->calcForce(doParticlePot_);
+      bondPotential += bond->getPotential();
+      if (doPotentialSelection_) {
+        if (seleMan_.isSelected(bond->getAtomA()) ||
+            seleMan_.isSelected(bond->getAtomB()) ) {
+          selectionPotential[BONDED_FAMILY] += bond->getPotential();
         }
       }
+    }
 
-      for (bend = mol->beginBend(bendIter); bend != NULL;
-           bend = mol->nextBend(bendIter)) {
+    vector<Bend*>& bends = bondedBatch_->getOtherBends();
+    for (vector<Bend*>::iterator bi = bends.begin(); bi != bends.end(); ++bi) {
+      bend = *bi;
 
-        RealType angle;
-        bend->calcForce(angle, doParticlePot_);
-        RealType currBendPot = bend->getPotential();
+      RealType angle;
+      bend->calcForce(angle, doParticlePot_);
+      RealType currBendPot = bend->getPotential();
 
-        bendPotential += bend->getPotential();
-        map<Bend*, BendDataSet>::iterator i = bendDataSets.find(bend);
-        if (i == bendDataSets.end()) {
-          BendDataSet dataSet;
-          dataSet.prev.angle = dataSet.curr.angle = angle;
-          dataSet.prev.potential = dataSet.curr.potential = currBendPot;
-          dataSet.deltaV = 0.0;
-          bendDataSets.insert(map<Bend*, BendDataSet>::value_type(bend,
-                                                                  dataSet));
-        }else {
-          i->second.prev.angle = i->second.curr.angle;
-          i->second.prev.potential = i->second.curr.potential;
-          i->second.curr.angle = angle;
-          i->second.curr.potential = currBendPot;
-          i->second.deltaV =  fabs(i->second.curr.potential -
-                                   i->second.prev.potential);
-        }
-        if (doPotentialSelection_) {
-          if (seleMan_.isSelected(bend->getAtomA()) ||
-              seleMan_.isSelected(bend->getAtomB()) ||
-              seleMan_.isSelected(bend->getAtomC()) ) {
-            selectionPotential[BONDED_FAMILY] += bend->getPotential();
-          }
+      bendPotential += bend->getPotential();
+      map<Bend*, BendDataSet>::iterator i = bendDataSets.find(bend);
+      if (i == bendDataSets.end()) {
+        BendDataSet dataSet;
+        dataSet.prev.angle = dataSet.curr.angle = angle;
+        dataSet.prev.potential = dataSet.curr.potential = currBendPot;
+        dataSet.deltaV = 0.0;
+        bendDataSets.insert(map<Bend*, BendDataSet>::value_type(bend,
+                                                                dataSet));
+      }else {
+        i->second.prev.angle = i->second.curr.angle;
+        i->second.prev.potential = i->second.curr.potential;
+        i->second.curr.angle = angle;
+        i->second.curr.potential = currBendPot;
+        i->second.deltaV =  fabs(i->second.curr.potential -
+                                 i->second.prev.potential);
+      }
+      if (doPotentialSelection_) {
+        if (seleMan_.isSelected(bend->getAtomA()) ||
+            seleMan_.isSelected(bend->getAtomB()) ||
+            seleMan_.isSelected(bend->getAtomC()) ) {
+          selectionPotential[BONDED_FAMILY] += bend->getPotential();
         }
       }
+    }
 
-      for (torsion = mol->beginTorsion(torsionIter); torsion != NULL;
-           torsion = mol->nextTorsion(torsionIter)) {
-        RealType angle;
-        torsion->calcForce(angle, doParticlePot_);
-        RealType currTorsionPot = torsion->getPotential();
-        torsionPotential += torsion->getPotential();
-        map<Torsion*, TorsionDataSet>::iterator i = torsionDataSets.find(torsion);
-        if (i == torsionDataSets.end()) {
-          TorsionDataSet dataSet;
-          dataSet.prev.angle = dataSet.curr.angle = angle;
-          dataSet.prev.potential = dataSet.curr.potential = currTorsionPot;
-          dataSet.deltaV = 0.0;
-          torsionDataSets.insert(map<Torsion*, TorsionDataSet>::value_type(torsion, dataSet));
-        }else {
-          i->second.prev.angle = i->second.curr.angle;
-          i->second.prev.potential = i->second.curr.potential;
-          i->second.curr.angle = angle;
-          i->second.curr.potential = currTorsionPot;
-          i->second.deltaV =  fabs(i->second.curr.potential -
-                                   i->second.prev.potential);
-        }
-        if (doPotentialSelection_) {
-          if (seleMan_.isSelected(torsion->getAtomA()) ||
-              seleMan_.isSelected(torsion->getAtomB()) ||
-              seleMan_.isSelected(torsion->getAtomC()) ||
-              seleMan_.isSelected(torsion->getAtomD()) ) {
-            selectionPotential[BONDED_FAMILY] += torsion->getPotential();
-          }
+    vector<Torsion*>& torsions = bondedBatch_->getOtherTorsions();
+    for (vector<Torsion*>::iterator ti = torsions.begin();
+         ti != torsions.end(); ++ti) {
+      torsion = *ti;
+      RealType angle;
+      torsion->calcForce(angle, doParticlePot_);
+      RealType currTorsionPot = torsion->getPotential();
+      torsionPotential += torsion->getPotential();
+      map<Torsion*, TorsionDataSet>::iterator i = torsionDataSets.find(torsion);
+      if (i == torsionDataSets.end()) {
+        TorsionDataSet dataSet;
+        dataSet.prev.angle = dataSet.curr.angle = angle;
+        dataSet.prev.potential = dataSet.curr.potential = currTorsionPot;
+        dataSet.deltaV = 0.0;
+        torsionDataSets.insert(map<Torsion*, TorsionDataSet>::value_type(torsion, dataSet));
+      }else {
+        i->second.prev.angle = i->second.curr.angle;
+        i->second.prev.potential = i->second.curr.potential;
+        i->second.curr.angle = angle;
+        i->second.curr.potential = currTorsionPot;
+        i->second.deltaV =  fabs(i->second.curr.potential -
+                                 i->second.prev.potential);
+      }
+      if (doPotentialSelection_) {
+        if (seleMan_.isSelected(torsion->getAtomA()) ||
+            seleMan_.isSelected(torsion->getAtomB()) ||
+            seleMan_.isSelected(torsion->getAtomC()) ||
+            seleMan_.isSelected(torsion->getAtomD()) ) {
+          selectionPotential[BONDED_FAMILY] += torsion->getPotential();
         }
-
       }
+    }
+
+    for (mol = info_->beginMolecule(mi); mol != NULL;
+         mol = info_->nextMolecule(mi)) {
 
       for (inversion = mol->beginInversion(inversionIter);
 	   inversion != NULL;
@@ -757,7 +815,6 @@ namespace OpenMD {
     Vector3d fij, fg, f1;
     bool in_switching_region;
     RealType sw, dswdr, swderiv;
-    vector<int> atomListColumn, atomListRow;
     InteractionData idat;
     SelfData sdat;
     RealType mf;
@@ -782,6 +839,26 @@ namespace OpenMD {
 
     int loopStart, loopEnd;
 
+    // Member atoms of a pair of cutoff groups can't be more than
+    // rgrp + R1 + R2 apart (R being each group's bounding radius).
+    // While that stays below half of the narrowest box width, the
+    // interatomic vector built from the already wrapped group vector
+    // and the unwrapped group->atom vectors is the minimum image, and
+    // no per-atom wrapping is needed.
+    RealType maxDirect(0.0);
+    bool allDirect = !usePeriodicBoundaryConditions_;
+    if (usePeriodicBoundaryConditions_) {
+      Mat3x3d hmat = curSnapshot->getHmat();
+      Vector3d a = hmat.getColumn(0);
+      Vector3d b = hmat.getColumn(1);
+      Vector3d c = hmat.getColumn(2);
+      RealType vol = curSnapshot->getVolume();
+      maxDirect = 0.5 * min(vol / cross(b, c).length(),
+                            min(vol / cross(c, a).length(),
+                                vol / cross(a, b).length()));
+    }
+    bool direct;
+
     idat.rcut = &rCut_;
     idat.vdwMult = &vdwMult;
     idat.electroMult = &electroMult;
@@ -814,6 +891,9 @@ namespace OpenMD {
     } else {
       loopStart = PAIR_LOOP;
     }
+    // nothing to loop over if the pair group isn't wanted:
+    if (!(forceGroups_ & PAIR_FORCE_GROUP)) loopEnd = loopStart - 1;
+
     for (int iLoop = loopStart; iLoop <= loopEnd; iLoop++) {
 
       if (iLoop == loopStart) {
@@ -828,7 +908,7 @@ namespace OpenMD {
 
       for (cg1 = 0; cg1 < int(point_.size()) - 1; cg1++) {
 
-        atomListRow = fDecomp_->getAtomsInGroupRow(cg1);
+        vector<int>& atomListRow = fDecomp_->getAtomsInGroupRow(cg1);
         newAtom1 = true;
 
         for (int m2 = point_[cg1]; m2 < point_[cg1+1]; m2++) {
@@ -854,11 +934,24 @@ namespace OpenMD {
             in_switching_region = switcher_->getSwitch(rgrpsq, sw, dswdr,
                                                        rgrp);
 
-            atomListColumn = fDecomp_->getAtomsInGroupColumn(cg2);
+            vector<int>& atomListColumn = fDecomp_->getAtomsInGroupColumn(cg2);
 
             if (doHeatFlux_)
               gvel2 = fDecomp_->getGroupVelocityColumn(cg2);
 
+            direct = allDirect || (rgrp + fDecomp_->getGroupRadiusRow(cg1) +
+                                   fDecomp_->getGroupRadiusColumn(cg2)
+                                   < maxDirect);
+            if (iLoop == PAIR_LOOP) {
+              nGroupPairs_++;
+              if (atomListRow.size() > 1 || atomListColumn.size() > 1) {
+                nGroupAtomPairs_ += atomListRow.size() * atomListColumn.size();
+                if (direct)
+                  nDirectAtomPairs_ += atomListRow.size() * 
+                    atomListColumn.size();
+              }
+            }
+
             for (ia = atomListRow.begin();
                  ia != atomListRow.end(); ++ia) {
               atom1 = (*ia);
@@ -899,8 +992,13 @@ namespace OpenMD {
                     if (doHeatFlux_)
                       vel2 = gvel2;
                   } else {
-                    d = fDecomp_->getInteratomicVector(atom1, atom2);
-                    curSnapshot->wrapVector( d );
+                    if (direct) {
+                      d = d_grp + fDecomp_->getGroupToAtomVectorColumn(atom2)
+                        - fDecomp_->getGroupToAtomVectorRow(atom1);
+                    } else {
+                      d = fDecomp_->getInteratomicVector(atom1, atom2);
+                      curSnapshot->wrapVector( d );
+                    }
                     r2 = d.lengthSquare();
                     idat.d = &d;
                     idat.r2 = &r2;
@@ -1015,15 +1113,26 @@ namespace OpenMD {
 
     // collects pairwise information
     fDecomp_->collectData();
-    if (cutoffMethod_ == EWALD_FULL) {
-      interactionMan_->doReciprocalSpaceSum(reciprocalPotential);
-      curSnapshot->setReciprocalPotential(reciprocalPotential);
+
+    if (forceGroups_ & RECIPROCAL_FORCE_GROUP) {
+      if (cutoffMethod_ == EWALD_FULL) {
+        interactionMan_->doReciprocalSpaceSum(reciprocalPotential);
+        curSnapshot->setReciprocalPotential(reciprocalPotential);
+      }
+
+      if (useSurfaceTerm_) {
+        interactionMan_->doSurfaceTerm(useSlabGeometry_, axis_,
+                                       surfacePotential);
+        curSnapshot->setSurfacePotential(surfacePotential);
+      }
     }
 
-    if (useSurfaceTerm_) {
-      interactionMan_->doSurfaceTerm(useSlabGeometry_, axis_, surfacePotential);
-      curSnapshot->setSurfacePotential(surfacePotential);
+    if (!(forceGroups_ & PAIR_FORCE_GROUP)) {
+      // carry the pair virial from the last time it was computed
+      virialTensor += pairVirial_;
+      return;
     }
+    pairVirial_ = virialTensor;
 
     if (info_->requiresSelfCorrection()) {
       for (unsigned int atom1 = 0; atom1 < info_->getNAtoms(); atom1++) {
@@ -1058,27 +1167,20 @@ namespace OpenMD {
 
   void ForceManager::postCalculation() {
 
-    vector<Perturbation*>::iterator pi;
-    for (pi = perturbations_.begin(); pi != perturbations_.end(); ++pi) {
-      (*pi)->applyPerturbation();
+    // external fields also act on the fluctuating charges
+    if ((forceGroups_ & BONDED_FORCE_GROUP) || chargeOnly_) {
+      vector<Perturbation*>::iterator pi;
+      for (pi = perturbations_.begin(); pi != perturbations_.end(); ++pi) {
+        (*pi)->applyPerturbation();
+      }
     }
 
-    SimInfo::MoleculeIterator mi;
-    Molecule* mol;
-    Molecule::RigidBodyIterator rbIter;
-    RigidBody* rb;
+    if (chargeOnly_) return;
+
     Snapshot* curSnapshot = info_->getSnapshotManager()->getCurrentSnapshot();
 
     // collect the atomic forces onto rigid bodies
-
-    for (mol = info_->beginMolecule(mi); mol != NULL;
-         mol = info_->nextMolecule(mi)) {
-      for (rb = mol->beginRigidBody(rbIter); rb != NULL;
-           rb = mol->nextRigidBody(rbIter)) {
-        Mat3x3d rbTau = rb->calcForcesAndTorquesAndVirial();
-        virialTensor += rbTau;
-      }
-    }
+    virialTensor += rbBatch_->calcForcesAndTorquesAndVirial();
 
 #ifdef IS_MPI
     MPI_Allreduce(MPI_IN_PLACE, virialTensor.getArrayPointer(), 9,
@@ -58,6 +58,8 @@
 #include "perturbations/Perturbation.hpp"
 #include "parallel/ForceDecomposition.hpp"
 #include "brains/Thermo.hpp"
+#include "brains/RigidBodyBatch.hpp"
+#include "brains/BondedBatch.hpp"
 #include "selection/SelectionEvaluator.hpp"
 #include "selection/SelectionManager.hpp"
 
@@ -66,6 +68,19 @@
 
 using namespace std;
 namespace OpenMD {
+
+  /**
+   * Groups of forces that multiple time step integrators can ask the
+   * ForceManager to evaluate separately.  Perturbations (external
+   * fields) are evaluated with the bonded group.
+   */
+  enum ForceGroup {
+    BONDED_FORCE_GROUP = 1,     /**< bonds, bends, torsions, inversions */
+    PAIR_FORCE_GROUP = 2,       /**< cutoff pair loop and self terms */
+    RECIPROCAL_FORCE_GROUP = 4, /**< reciprocal-space sum and surface term */
+    ALL_FORCE_GROUPS = 7
+  };
+
   /**
    * @class ForceManager ForceManager.hpp "brains/ForceManager.hpp"
    * ForceManager is responsible for calculating both the short range
@@ -85,6 +100,37 @@ namespace OpenMD {
     void setDoElectricField(bool def) { doElectricField_ = def; }
     void initialize();
 
+    /**
+     * Restricts calcForces to a combination of ForceGroup flags.
+     * Forces on atoms are always zeroed first, so after calcForces
+     * they hold only the selected groups.  Potentials (and the pair
+     * virial) of groups that are skipped keep the values from the
+     * last call that evaluated them.
+     */
+    void setForceGroups(int groups) { forceGroups_ = groups; }
+    int getForceGroups() { return forceGroups_; }
+
+    /**
+     * Returns false for force managers that add forces of their own
+     * after the standard evaluation; those can't be split into groups.
+     */
+    virtual bool supportsForceGroups() { return true; }
+
+    /**
+     * Evaluates only the terms that contribute to the fluctuating
+     * charge forces (the electrostatic and EAM pair terms, the
+     * reciprocal-space sum and any perturbations) while the positions
+     * are held fixed.  The current neighbor list is reused, and the
+     * other nonbonded interactions, bonded interactions, rigid body
+     * force collection and the virial are skipped, so the positional
+     * forces and the potential are not meaningful until the next
+     * calcForces().  The skipped terms are constant at fixed
+     * positions, so energy differences between charge states are
+     * still correct.  Force managers that add forces of their own in
+     * postCalculation() do not do so here.
+     */
+    void calcChargeForces();
+
   protected: 
     bool initialized_; 
     bool doParticlePot_;
@@ -114,6 +160,8 @@ namespace OpenMD {
     ForceDecomposition* fDecomp_;
     SwitchingFunction* switcher_;
     Thermo* thermo;
+    RigidBodyBatch* rbBatch_;
+    BondedBatch* bondedBatch_;
 
     SwitchingFunctionType sft_;/**< Type of switching function in use */
     RealType rCut_;            /**< cutoff radius for non-bonded interactions */
@@ -134,6 +182,7 @@ namespace OpenMD {
     vector<RealType> electrostaticScale_;
 
     Mat3x3d virialTensor;
+    Mat3x3d pairVirial_;   /**< pair loop virial from its last evaluation */
 
     vector<Perturbation*> perturbations_;
 
@@ -142,6 +191,13 @@ namespace OpenMD {
     SelectionManager seleMan_;
     SelectionEvaluator evaluator_;
 
+    unsigned long nGroupPairs_;      /**< group pairs inside the cutoff */
+    unsigned long nGroupAtomPairs_;  /**< atom pairs in multi-atom groups */
+    unsigned long nDirectAtomPairs_; /**< of those, pairs needing no wrapping */
+
+    int forceGroups_;   /**< ForceGroup flags evaluated by calcForces */
+    bool chargeOnly_;   /**< true while calcChargeForces is running */
+
   };
 } 
 #endif //BRAINS_FORCEMANAGER_HPP
@@ -50,6 +50,7 @@
 #include <cassert>
 #include <typeinfo>
 #include <set>
+#include <new>
 
 #include "brains/MoleculeCreator.hpp"
 #include "primitives/GhostBend.hpp"
@@ -65,20 +66,58 @@
 
 namespace OpenMD {
   
+  MoleculeCreator::StampTypes& 
+  MoleculeCreator::getStampTypes(ForceField* ff, MoleculeStamp* molStamp) {
+    std::map<MoleculeStamp*, StampTypes>::iterator i;
+    
+    i = stampTypes_.find(molStamp);
+    if (i != stampTypes_.end()) return i->second;
+
+    StampTypes& types = stampTypes_[molStamp];
+
+    // atom types have to come first, since the other types are
+    // looked up by the names of the atom types:
+    for (std::size_t j = 0; j < molStamp->getNAtoms(); ++j)
+      types.atomTypes.push_back(resolveAtomType(ff, molStamp->getAtomStamp(j)));
+
+    for (std::size_t j = 0; j < molStamp->getNBonds(); ++j)
+      types.bondTypes.push_back(resolveBondType(ff, molStamp, 
+                                                molStamp->getBondStamp(j),
+                                                types.atomTypes));
+
+    for (std::size_t j = 0; j < molStamp->getNBends(); ++j)
+      types.bendTypes.push_back(resolveBendType(ff, molStamp, 
+                                                molStamp->getBendStamp(j),
+                                                types.atomTypes));
+
+    for (std::size_t j = 0; j < molStamp->getNTorsions(); ++j)
+      types.torsionTypes.push_back(resolveTorsionType(ff, molStamp, 
+                                                      molStamp->getTorsionStamp(j),
+                                                      types.atomTypes));
+
+    for (std::size_t j = 0; j < molStamp->getNInversions(); ++j)
+      types.inversionTypes.push_back(resolveInversionType(ff, molStamp, 
+                                                          molStamp->getInversionStamp(j),
+                                                          types.atomTypes));
+    return types;
+  }
+  
   Molecule* MoleculeCreator::createMolecule(ForceField* ff, 
                                             MoleculeStamp *molStamp,
 					    int stampId, int globalIndex, 
                                             LocalIndexManager* localIndexMan) {
     Molecule* mol = new Molecule(stampId, globalIndex, molStamp->getName(), 
                                  molStamp->getRegion() );
+    mol->setPrimitivesInArena(true);
+
+    // all instances of a stamp share the same force field types:
+    StampTypes& types = getStampTypes(ff, molStamp);
 
     //create atoms
     Atom* atom;
-    AtomStamp* currentAtomStamp;
     int nAtom = molStamp->getNAtoms();
     for (int i = 0; i < nAtom; ++i) {
-      currentAtomStamp = molStamp->getAtomStamp(i);
-      atom = createAtom(ff, mol, currentAtomStamp, localIndexMan);
+      atom = createAtom(types.atomTypes[i], mol, localIndexMan);
       mol->addAtom(atom);
     }
 
@@ -101,7 +140,8 @@ namespace OpenMD {
 
     for (int i = 0; i < nBonds; ++i) {
       currentBondStamp = molStamp->getBondStamp(i);        
-      bond = createBond(ff, mol, currentBondStamp, localIndexMan);
+      bond = createBond(mol, currentBondStamp, types.bondTypes[i],
+                        localIndexMan);
       mol->addBond(bond);
     }
 
@@ -111,7 +151,8 @@ namespace OpenMD {
     int nBends = molStamp->getNBends();
     for (int i = 0; i < nBends; ++i) {
       currentBendStamp = molStamp->getBendStamp(i);
-      bend = createBend(ff, mol, currentBendStamp, localIndexMan);
+      bend = createBend(mol, currentBendStamp, types.bendTypes[i],
+                        localIndexMan);
       mol->addBend(bend);
     }
 
@@ -121,7 +162,8 @@ namespace OpenMD {
     int nTorsions = molStamp->getNTorsions();
     for (int i = 0; i < nTorsions; ++i) {
       currentTorsionStamp = molStamp->getTorsionStamp(i);
-      torsion = createTorsion(ff, mol, currentTorsionStamp, localIndexMan);
+      torsion = createTorsion(mol, currentTorsionStamp, types.torsionTypes[i],
+                              localIndexMan);
       mol->addTorsion(torsion);
     }
 
@@ -131,8 +173,8 @@ namespace OpenMD {
     int nInversions = molStamp->getNInversions();
     for (int i = 0; i < nInversions; ++i) {
       currentInversionStamp = molStamp->getInversionStamp(i);
-      inversion = createInversion(ff, mol, currentInversionStamp, 
-                                  localIndexMan);
+      inversion = createInversion(mol, currentInversionStamp, 
+                                  types.inversionTypes[i], localIndexMan);
       if (inversion != NULL ) {
         mol->addInversion(inversion);
       }
@@ -207,11 +249,13 @@ namespace OpenMD {
         simError();      
       } else {
         RealType distance = cStamp->getConstrainedDistance();
-	ConstraintElem* consElemA = new ConstraintElem(atomA);
-	ConstraintElem* consElemB = new ConstraintElem(atomB);
-	ConstraintPair* cPair = new ConstraintPair(consElemA, consElemB, 
-						   distance,
-						   printConstraintForce);
+	ConstraintElem* consElemA = new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(atomA);
+	ConstraintElem* consElemB = new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(atomB);
+	ConstraintPair* cPair = new (arenas_->constraints.allocate(sizeof(ConstraintPair)))
+          ConstraintPair(consElemA, consElemB, distance, 
+                         printConstraintForce);
 	mol->addConstraintPair(cPair);
       }   
     }
@@ -233,11 +277,8 @@ namespace OpenMD {
   }    
 
 
-  Atom* MoleculeCreator::createAtom(ForceField* ff, Molecule* mol, 
-                                    AtomStamp* stamp,
-                                    LocalIndexManager* localIndexMan) {
+  AtomType* MoleculeCreator::resolveAtomType(ForceField* ff, AtomStamp* stamp) {
     AtomType * atomType;
-    Atom* atom;
 
     atomType =  ff->getAtomType(stamp->getType());
     
@@ -248,16 +289,23 @@ namespace OpenMD {
       painCave.isFatal = 1;
       simError();
     }
+    return atomType;
+  }
+
+  Atom* MoleculeCreator::createAtom(AtomType* atomType, Molecule* mol, 
+                                    LocalIndexManager* localIndexMan) {
+    Atom* atom;
 
     //below code still have some kind of hard-coding smell
     if (atomType->isDirectional()){
 
       DirectionalAtom* dAtom;
-      dAtom = new DirectionalAtom(atomType);
+      dAtom = new (arenas_->atoms.allocate(sizeof(DirectionalAtom)))
+        DirectionalAtom(atomType);
       atom = dAtom;    
     }
     else{
-      atom = new Atom(atomType);
+      atom = new (arenas_->atoms.allocate(sizeof(Atom))) Atom(atomType);
     }
 
     atom->setLocalIndex(localIndexMan->getNextAtomIndex());
@@ -303,18 +351,12 @@ namespace OpenMD {
     return rb;
   }    
 
-  Bond* MoleculeCreator::createBond(ForceField* ff, Molecule* mol, 
-                                    BondStamp* stamp,
-                                    LocalIndexManager* localIndexMan) {
+  BondType* MoleculeCreator::resolveBondType(ForceField* ff,
+                                             MoleculeStamp* molStamp,
+                                             BondStamp* stamp,
+                                             std::vector<AtomType*>& atomTypes) {
     BondTypeParser btParser;        
     BondType* bondType = NULL;
-    Atom* atomA;
-    Atom* atomB;
-    
-    atomA = mol->getAtomAt(stamp->getA());
-    atomB = mol->getAtomAt(stamp->getB());
-    
-    assert( atomA && atomB);
 
     if (stamp->hasOverride()) {
 
@@ -325,25 +367,42 @@ namespace OpenMD {
       catch( OpenMDException& e) {
         sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
                 "for molecule %s\n",
-                e.what(), mol->getType().c_str() );
+                e.what(), molStamp->getName().c_str() );
         painCave.isFatal = 1;
         simError();
       }
 
     } else {
-      bondType = ff->getBondType(atomA->getType(), atomB->getType());
+      AtomType* atypeA = atomTypes[stamp->getA()];
+      AtomType* atypeB = atomTypes[stamp->getB()];
+
+      bondType = ff->getBondType(atypeA->getName(), atypeB->getName());
 
       if (bondType == NULL) {
         sprintf(painCave.errMsg, "Can not find Matching Bond Type for[%s, %s]",
-                atomA->getType().c_str(),
-                atomB->getType().c_str());
+                atypeA->getName().c_str(),
+                atypeB->getName().c_str());
         
         painCave.isFatal = 1;
         simError();
       }
     }
+    return bondType;
+  }
+
+  Bond* MoleculeCreator::createBond(Molecule* mol, BondStamp* stamp,
+                                    BondType* bondType,
+                                    LocalIndexManager* localIndexMan) {
+    Atom* atomA;
+    Atom* atomB;
+    
+    atomA = mol->getAtomAt(stamp->getA());
+    atomB = mol->getAtomAt(stamp->getB());
+    
+    assert( atomA && atomB);
     
-    Bond* bond = new Bond(atomA, atomB, bondType);
+    Bond* bond = new (arenas_->bonds.allocate(sizeof(Bond)))
+      Bond(atomA, atomB, bondType);
 
     //set the local index of this bond, the global index will be set later
     bond->setLocalIndex(localIndexMan->getNextBondIndex());
@@ -359,11 +418,62 @@ namespace OpenMD {
     return bond;    
   }    
   
-  Bend* MoleculeCreator::createBend(ForceField* ff, Molecule* mol, 
-                                    BendStamp* stamp,
-                                    LocalIndexManager* localIndexMan) {
+  BendType* MoleculeCreator::resolveBendType(ForceField* ff,
+                                             MoleculeStamp* molStamp,
+                                             BendStamp* stamp,
+                                             std::vector<AtomType*>& atomTypes) {
     BendTypeParser btParser;
     BendType* bendType = NULL;
+    std::string nameA, nameB, nameC;
+    
+    std::vector<int> bendAtoms = stamp->getMembers();
+    if (bendAtoms.size() == 3) {
+      nameA = atomTypes[bendAtoms[0]]->getName();
+      nameB = atomTypes[bendAtoms[1]]->getName();
+      nameC = atomTypes[bendAtoms[2]]->getName();
+    } else if ( bendAtoms.size() == 2 && stamp->haveGhostVectorSource()) {
+      int ghostIndex = stamp->getGhostVectorSource();
+      int normalIndex = ghostIndex != bendAtoms[0] ?
+        bendAtoms[0] : bendAtoms[1]; 
+      nameA = atomTypes[normalIndex]->getName();
+      nameB = atomTypes[ghostIndex]->getName();
+      nameC = "GHOST";
+    } else {
+      return NULL;
+    }
+
+    if (stamp->hasOverride()) {
+        
+      try {
+        bendType = btParser.parseTypeAndPars(stamp->getOverrideType(),
+                                             stamp->getOverridePars() );
+      }
+      catch( OpenMDException& e) {
+        sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
+                "for molecule %s\n",
+                e.what(), molStamp->getName().c_str() );
+        painCave.isFatal = 1;
+        simError();
+      }
+    } else {
+        
+      bendType = ff->getBendType(nameA, nameB, nameC);
+      
+      if (bendType == NULL) {
+        sprintf(painCave.errMsg, 
+                "Can not find Matching Bend Type for[%s, %s, %s]",
+                nameA.c_str(), nameB.c_str(), nameC.c_str());
+        
+        painCave.isFatal = 1;
+        simError();
+      }
+    }
+    return bendType;
+  }
+
+  Bend* MoleculeCreator::createBend(Molecule* mol, BendStamp* stamp,
+                                    BendType* bendType,
+                                    LocalIndexManager* localIndexMan) {
     Bend* bend = NULL;
     
     std::vector<int> bendAtoms = stamp->getMembers();
@@ -373,39 +483,9 @@ namespace OpenMD {
       Atom* atomC = mol->getAtomAt(bendAtoms[2]);
       
       assert( atomA && atomB && atomC );
-
-      if (stamp->hasOverride()) {
-        
-        try {
-          bendType = btParser.parseTypeAndPars(stamp->getOverrideType(),
-                                               stamp->getOverridePars() );
-        }
-        catch( OpenMDException& e) {
-          sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
-                  "for molecule %s\n",
-                  e.what(), mol->getType().c_str() );
-          painCave.isFatal = 1;
-          simError();
-        }
-      } else {
-        
-        bendType = ff->getBendType(atomA->getType().c_str(), 
-                                             atomB->getType().c_str(), 
-                                             atomC->getType().c_str());
       
-        if (bendType == NULL) {
-          sprintf(painCave.errMsg, 
-                  "Can not find Matching Bend Type for[%s, %s, %s]",
-                  atomA->getType().c_str(),
-                  atomB->getType().c_str(),
-                  atomC->getType().c_str());
-          
-          painCave.isFatal = 1;
-          simError();
-        }
-      }
-      
-      bend = new Bend(atomA, atomB, atomC, bendType);
+      bend = new (arenas_->bends.allocate(sizeof(Bend)))
+        Bend(atomA, atomB, atomC, bendType);
       
     } else if ( bendAtoms.size() == 2 && stamp->haveGhostVectorSource()) {
       int ghostIndex = stamp->getGhostVectorSource();
@@ -418,38 +498,9 @@ namespace OpenMD {
 	painCave.isFatal = 1;
 	simError();
       }
-
-      if (stamp->hasOverride()) {
-        
-        try {
-          bendType = btParser.parseTypeAndPars(stamp->getOverrideType(),
-                                               stamp->getOverridePars() );
-        }
-        catch( OpenMDException& e) {
-          sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
-                  "for molecule %s\n",
-                  e.what(), mol->getType().c_str() );
-          painCave.isFatal = 1;
-          simError();
-        }
-      } else {
-      
-        bendType = ff->getBendType(normalAtom->getType(), ghostAtom->getType(),
-                                   "GHOST");
-        
-        if (bendType == NULL) {
-          sprintf(painCave.errMsg, 
-                  "Can not find Matching Bend Type for[%s, %s, %s]",
-                  normalAtom->getType().c_str(),
-                  ghostAtom->getType().c_str(),
-                  "GHOST");
-          
-          painCave.isFatal = 1;
-          simError();
-        }
-      }
       
-      bend = new GhostBend(normalAtom, ghostAtom, bendType);       
+      bend = new (arenas_->bends.allocate(sizeof(GhostBend)))
+        GhostBend(normalAtom, ghostAtom, bendType);       
       
     } 
     
@@ -467,12 +518,59 @@ namespace OpenMD {
     return bend;
   }    
 
-  Torsion* MoleculeCreator::createTorsion(ForceField* ff, Molecule* mol, 
-                                          TorsionStamp* stamp,
-                                          LocalIndexManager* localIndexMan) {
-
+  TorsionType* MoleculeCreator::resolveTorsionType(ForceField* ff,
+                                                   MoleculeStamp* molStamp,
+                                                   TorsionStamp* stamp,
+                                                   std::vector<AtomType*>& atomTypes) {
     TorsionTypeParser ttParser;
     TorsionType* torsionType = NULL;
+    std::string nameD;
+
+    std::vector<int> torsionAtoms = stamp->getMembers();
+    if (torsionAtoms.size() < 3) {
+	return torsionType;
+    }
+
+    std::string nameA = atomTypes[torsionAtoms[0]]->getName();
+    std::string nameB = atomTypes[torsionAtoms[1]]->getName();
+    std::string nameC = atomTypes[torsionAtoms[2]]->getName();
+
+    if (torsionAtoms.size() == 4) 
+      nameD = atomTypes[torsionAtoms[3]]->getName();
+    else
+      nameD = "GHOST";
+
+    if (stamp->hasOverride()) {
+        
+      try {
+        torsionType = ttParser.parseTypeAndPars(stamp->getOverrideType(),
+                                                stamp->getOverridePars() );
+      }
+      catch( OpenMDException& e) {
+        sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
+                "for molecule %s\n",
+                e.what(), molStamp->getName().c_str() );
+        painCave.isFatal = 1;
+        simError();
+      }
+    } else {
+      torsionType = ff->getTorsionType(nameA, nameB, nameC, nameD);
+
+      if (torsionType == NULL) {
+        sprintf(painCave.errMsg, 
+                "Can not find Matching Torsion Type for[%s, %s, %s, %s]",
+                nameA.c_str(), nameB.c_str(), nameC.c_str(), nameD.c_str());
+          
+        painCave.isFatal = 1;
+        simError();
+      }
+    }
+    return torsionType;
+  }
+
+  Torsion* MoleculeCreator::createTorsion(Molecule* mol, TorsionStamp* stamp,
+                                          TorsionType* torsionType,
+                                          LocalIndexManager* localIndexMan) {
     Torsion* torsion = NULL;
 
     std::vector<int> torsionAtoms = stamp->getMembers();
@@ -488,41 +586,9 @@ namespace OpenMD {
       Atom* atomD = mol->getAtomAt(torsionAtoms[3]);
 
       assert(atomA && atomB && atomC && atomD );
-
-      if (stamp->hasOverride()) {
-        
-        try {
-          torsionType = ttParser.parseTypeAndPars(stamp->getOverrideType(),
-                                                  stamp->getOverridePars() );
-        }
-        catch( OpenMDException& e) {
-          sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
-                  "for molecule %s\n",
-                  e.what(), mol->getType().c_str() );
-          painCave.isFatal = 1;
-          simError();
-        }
-      } else {
-
-        
-        torsionType = ff->getTorsionType(atomA->getType(), 
-                                         atomB->getType(), 
-                                         atomC->getType(), 
-                                         atomD->getType());
-        if (torsionType == NULL) {
-          sprintf(painCave.errMsg, 
-                  "Can not find Matching Torsion Type for[%s, %s, %s, %s]",
-                  atomA->getType().c_str(),
-                  atomB->getType().c_str(),
-                  atomC->getType().c_str(),
-                  atomD->getType().c_str());
-          
-          painCave.isFatal = 1;
-          simError();
-        }
-      }
       
-      torsion = new Torsion(atomA, atomB, atomC, atomD, torsionType);       
+      torsion = new (arenas_->torsions.allocate(sizeof(Torsion)))
+        Torsion(atomA, atomB, atomC, atomD, torsionType);       
     } else {
       
       DirectionalAtom* dAtom = dynamic_cast<DirectionalAtom*>(mol->getAtomAt(stamp->getGhostVectorSource()));
@@ -532,37 +598,8 @@ namespace OpenMD {
 	simError();
       }        
 
-      if (stamp->hasOverride()) {
-        
-        try {
-          torsionType = ttParser.parseTypeAndPars(stamp->getOverrideType(),
-                                                  stamp->getOverridePars() );
-        }
-        catch( OpenMDException& e) {
-          sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
-                  "for molecule %s\n",
-                  e.what(), mol->getType().c_str() );
-          painCave.isFatal = 1;
-          simError();
-        }
-      } else {              
-        torsionType = ff->getTorsionType(atomA->getType(), atomB->getType(), 
-                                         atomC->getType(), "GHOST");
-      
-        if (torsionType == NULL) {
-          sprintf(painCave.errMsg,
-                  "Can not find Matching Torsion Type for[%s, %s, %s, %s]",
-                  atomA->getType().c_str(),
-                  atomB->getType().c_str(),
-                  atomC->getType().c_str(),
-                  "GHOST");
-          
-          painCave.isFatal = 1;
-          simError();
-        }
-      }
-
-      torsion = new GhostTorsion(atomA, atomB, dAtom, torsionType);               
+      torsion = new (arenas_->torsions.allocate(sizeof(GhostTorsion)))
+        GhostTorsion(atomA, atomB, dAtom, torsionType);               
     }
 
     //set the local index of this torsion, the global index will be set later
@@ -580,27 +617,20 @@ namespace OpenMD {
     return torsion;
   }    
 
-  Inversion* MoleculeCreator::createInversion(ForceField* ff, Molecule* mol, 
-                                              InversionStamp* stamp,
-                                              LocalIndexManager* localIndexMan) {
+  InversionType* MoleculeCreator::resolveInversionType(ForceField* ff,
+                                                       MoleculeStamp* molStamp,
+                                                       InversionStamp* stamp,
+                                                       std::vector<AtomType*>& atomTypes) {
 
     InversionTypeParser itParser;
     InversionType* inversionType = NULL;
-    Inversion* inversion = NULL;
     
     int center = stamp->getCenter();
     std::vector<int> satellites = stamp->getSatellites();
     if (satellites.size() != 3) {
-	return inversion;
+	return inversionType;
     }
 
-    Atom* atomA = mol->getAtomAt(center);
-    Atom* atomB = mol->getAtomAt(satellites[0]);
-    Atom* atomC = mol->getAtomAt(satellites[1]);
-    Atom* atomD = mol->getAtomAt(satellites[2]);
-      
-    assert(atomA && atomB && atomC && atomD);
-
     if (stamp->hasOverride()) {
       
       try {
@@ -610,52 +640,74 @@ namespace OpenMD {
       catch( OpenMDException& e) {
         sprintf(painCave.errMsg, "MoleculeCreator Error: %s "
                 "for molecule %s\n",
-                e.what(), mol->getType().c_str() );
+                e.what(), molStamp->getName().c_str() );
         painCave.isFatal = 1;
         simError();
       }
     } else {
+      AtomType* atypeA = atomTypes[center];
+      AtomType* atypeB = atomTypes[satellites[0]];
+      AtomType* atypeC = atomTypes[satellites[1]];
+      AtomType* atypeD = atomTypes[satellites[2]];
       
-      inversionType = ff->getInversionType(atomA->getType(), 
-                                           atomB->getType(), 
-                                           atomC->getType(), 
-                                           atomD->getType());
+      inversionType = ff->getInversionType(atypeA->getName(), 
+                                           atypeB->getName(), 
+                                           atypeC->getName(), 
+                                           atypeD->getName());
       
       if (inversionType == NULL) {
         sprintf(painCave.errMsg,
                 "No Matching Inversion Type for[%s, %s, %s, %s]\n"
                 "\t(May not be a problem: not all inversions are parametrized)\n",
-                atomA->getType().c_str(),
-                atomB->getType().c_str(),
-                atomC->getType().c_str(),
-                atomD->getType().c_str());
+                atypeA->getName().c_str(),
+                atypeB->getName().c_str(),
+                atypeC->getName().c_str(),
+                atypeD->getName().c_str());
         
         painCave.isFatal = 0;
         painCave.severity = OPENMD_INFO;
         simError();
       }
     }
-    if (inversionType != NULL) {
+    return inversionType;
+  }
+
+  Inversion* MoleculeCreator::createInversion(Molecule* mol, 
+                                              InversionStamp* stamp,
+                                              InversionType* inversionType,
+                                              LocalIndexManager* localIndexMan) {
+    Inversion* inversion = NULL;
+    
+    int center = stamp->getCenter();
+    std::vector<int> satellites = stamp->getSatellites();
+    if (satellites.size() != 3 || inversionType == NULL) {
+	return inversion;
+    }
+
+    Atom* atomA = mol->getAtomAt(center);
+    Atom* atomB = mol->getAtomAt(satellites[0]);
+    Atom* atomC = mol->getAtomAt(satellites[1]);
+    Atom* atomD = mol->getAtomAt(satellites[2]);
       
-      inversion = new Inversion(atomA, atomB, atomC, atomD, inversionType);
+    assert(atomA && atomB && atomC && atomD);
+
+    inversion = new (arenas_->inversions.allocate(sizeof(Inversion)))
+      Inversion(atomA, atomB, atomC, atomD, inversionType);
       
-      // set the local index of this inversion, the global index will
-      // be set later
-      inversion->setLocalIndex(localIndexMan->getNextInversionIndex());
+    // set the local index of this inversion, the global index will
+    // be set later
+    inversion->setLocalIndex(localIndexMan->getNextInversionIndex());
       
-      // The rule for naming an inversion is: MoleculeName_Inversion_Integer
-      // The first part is the name of the molecule
-      // The second part is always fixed as "Inversion"
-      // The third part is the index of the inversion defined in meta-data file
-      // For example, Benzene_Inversion_0 is a valid Inversion name in a
-      // Benzene molecule
-
-      std::string s = OpenMD_itoa(mol->getNInversions(), 10);
-      inversion->setName(mol->getType() + "_Inversion_" + s.c_str());
-      return inversion;
-    } else {
-      return NULL;
-    }
+    // The rule for naming an inversion is: MoleculeName_Inversion_Integer
+    // The first part is the name of the molecule
+    // The second part is always fixed as "Inversion"
+    // The third part is the index of the inversion defined in meta-data file
+    // For example, Benzene_Inversion_0 is a valid Inversion name in a
+    // Benzene molecule
+
+    std::string s = OpenMD_itoa(mol->getNInversions(), 10);
+    inversion->setName(mol->getType() + "_Inversion_" + s.c_str());
+    return inversion;
   }
   
 
@@ -665,7 +717,8 @@ namespace OpenMD {
     int nAtoms;
     CutoffGroup* cg;
     Atom* atom;
-    cg = new CutoffGroup();
+    cg = new (arenas_->cutoffGroups.allocate(sizeof(CutoffGroup)))
+      CutoffGroup();
     
     nAtoms = stamp->getNMembers();
     for (int i =0; i < nAtoms; ++i) {
@@ -683,7 +736,8 @@ namespace OpenMD {
   CutoffGroup* MoleculeCreator::createCutoffGroup(Molecule * mol, Atom* atom,
                                                   LocalIndexManager* localIndexMan) {
     CutoffGroup* cg;
-    cg  = new CutoffGroup();
+    cg  = new (arenas_->cutoffGroups.allocate(sizeof(CutoffGroup)))
+      CutoffGroup();
     cg->addAtom(atom);
 
     //set the local index of this cutoffGroup, global index will be set later
@@ -706,10 +760,13 @@ namespace OpenMD {
       if (typeid(FixedBondType) == typeid(*bt)) {
 	FixedBondType* fbt = dynamic_cast<FixedBondType*>(bt);
 
-	ConstraintElem* consElemA = new ConstraintElem(bond->getAtomA());
-	ConstraintElem* consElemB = new ConstraintElem(bond->getAtomB());            
-        cPair = new ConstraintPair(consElemA, consElemB, 
-                                   fbt->getEquilibriumBondLength(), false);
+	ConstraintElem* consElemA = new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(bond->getAtomA());
+	ConstraintElem* consElemB = new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(bond->getAtomB());            
+        cPair = new (arenas_->constraints.allocate(sizeof(ConstraintPair)))
+          ConstraintPair(consElemA, consElemB, 
+                         fbt->getEquilibriumBondLength(), false);
 	mol->addConstraintPair(cPair);
       }
     }
@@ -728,13 +785,15 @@ namespace OpenMD {
       StuntDouble* sdA = consPair->getConsElem1()->getStuntDouble();            
       if (sdSet.find(sdA) == sdSet.end()){
 	sdSet.insert(sdA);
-	mol->addConstraintElem(new ConstraintElem(sdA));
+	mol->addConstraintElem(new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(sdA));
       }
       
       StuntDouble* sdB = consPair->getConsElem2()->getStuntDouble();            
       if (sdSet.find(sdB) == sdSet.end()){
 	sdSet.insert(sdB);
-	mol->addConstraintElem(new ConstraintElem(sdB));
+	mol->addConstraintElem(new (arenas_->constraints.allocate(sizeof(ConstraintElem)))
+          ConstraintElem(sdB));
       }      
     }
   }
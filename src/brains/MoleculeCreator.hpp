@@ -50,6 +50,9 @@
 #ifndef BRAINS_MOLECULECREATOR_HPP
 #define BRAINS_MOLECULECREATOR_HPP
 
+#include <map>
+#include <vector>
+
 #include "brains/SimInfo.hpp"
 #include "types/AtomStamp.hpp"
 #include "types/BondStamp.hpp"
@@ -67,27 +70,69 @@ namespace OpenMD {
    */
   class MoleculeCreator {
   public:
+    /**
+     * @param arenas storage for the primitives of the created
+     * molecules (normally SimInfo::getPrimitiveArenas())
+     */
+    MoleculeCreator(SimInfo::PrimitiveArenas* arenas) : arenas_(arenas) {}
+    virtual ~MoleculeCreator() {}
+
     virtual Molecule* createMolecule(ForceField* ff, MoleculeStamp *molStamp,
 				     int stampId, int globalIndex,  
                                      LocalIndexManager* localIndexMan);
 
   protected:
+
+    /**
+     * The force field types used by one MoleculeStamp, indexed in
+     * the same order as the stamps they were resolved from.  Every
+     * molecule created from a stamp shares these, so the force field
+     * lookups are done once per stamp instead of once per molecule.
+     */
+    struct StampTypes {
+      std::vector<AtomType*> atomTypes;
+      std::vector<BondType*> bondTypes;
+      std::vector<BendType*> bendTypes;
+      std::vector<TorsionType*> torsionTypes;
+      std::vector<InversionType*> inversionTypes;
+    };
+
+    /** Returns the (cached) force field types for a MoleculeStamp */
+    StampTypes& getStampTypes(ForceField* ff, MoleculeStamp* molStamp);
+
+    virtual AtomType* resolveAtomType(ForceField* ff, AtomStamp* stamp);
+    virtual BondType* resolveBondType(ForceField* ff, MoleculeStamp* molStamp,
+                                      BondStamp* stamp,
+                                      std::vector<AtomType*>& atomTypes);
+    virtual BendType* resolveBendType(ForceField* ff, MoleculeStamp* molStamp,
+                                      BendStamp* stamp,
+                                      std::vector<AtomType*>& atomTypes);
+    virtual TorsionType* resolveTorsionType(ForceField* ff, 
+                                            MoleculeStamp* molStamp,
+                                            TorsionStamp* stamp,
+                                            std::vector<AtomType*>& atomTypes);
+    virtual InversionType* resolveInversionType(ForceField* ff, 
+                                                MoleculeStamp* molStamp,
+                                                InversionStamp* stamp,
+                                                std::vector<AtomType*>& atomTypes);
         
-    /** Create an atom by its stamp */
-    virtual Atom* createAtom(ForceField* ff, Molecule* mol, AtomStamp* stamp, 
+    /** Create an atom by its type */
+    virtual Atom* createAtom(AtomType* atomType, Molecule* mol,
 			     LocalIndexManager* localIndexMan);
     virtual RigidBody* createRigidBody(MoleculeStamp *molStamp, Molecule* mol, 
 				       RigidBodyStamp* rbStamp,  
                                        LocalIndexManager* localIndexMan); 
-    virtual Bond* createBond(ForceField* ff, Molecule* mol, BondStamp* stamp, 
+    virtual Bond* createBond(Molecule* mol, BondStamp* stamp, 
+                             BondType* bondType,
                              LocalIndexManager* localIndexMan);
-    virtual Bend* createBend(ForceField* ff, Molecule* mol, BendStamp* stamp, 
+    virtual Bend* createBend(Molecule* mol, BendStamp* stamp, 
+                             BendType* bendType,
                              LocalIndexManager* localIndexMan);
-    virtual Torsion* createTorsion(ForceField* ff, Molecule* mol, 
-                                   TorsionStamp* stamp, 
+    virtual Torsion* createTorsion(Molecule* mol, TorsionStamp* stamp, 
+                                   TorsionType* torsionType,
                                    LocalIndexManager* localIndexMan);
-    virtual Inversion* createInversion(ForceField* ff, Molecule* mol, 
-                                       InversionStamp* stamp, 
+    virtual Inversion* createInversion(Molecule* mol, InversionStamp* stamp, 
+                                       InversionType* inversionType,
                                        LocalIndexManager* localIndexMan);
     virtual CutoffGroup* createCutoffGroup(Molecule* mol, 
                                            CutoffGroupStamp* stamp, 
@@ -96,6 +141,9 @@ namespace OpenMD {
                                            LocalIndexManager* localIndexMan);
     virtual void createConstraintPair(Molecule* mol);     
     virtual void createConstraintElem(Molecule* mol);
+
+    SimInfo::PrimitiveArenas* arenas_;
+    std::map<MoleculeStamp*, StampTypes> stampTypes_;
   };
 
 
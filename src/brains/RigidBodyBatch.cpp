@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2014 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2014).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+
+#include "brains/RigidBodyBatch.hpp"
+#include "primitives/Molecule.hpp"
+#include "primitives/RigidBody.hpp"
+#include "types/AtomType.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMD {
+
+  RigidBodyBatch::RigidBodyBatch(SimInfo* info) : info_(info), built_(false),
+                                                  nRigidBodies_(0) {}
+
+  void RigidBodyBatch::build() {
+    SimInfo::MoleculeIterator mi;
+    Molecule::RigidBodyIterator rbIter;
+    Molecule* mol;
+    RigidBody* rb;
+    Atom* atom;
+
+    rbIndex_.clear();
+    rbInertia_.clear();
+    memberStart_.clear();
+    memberIndex_.clear();
+    memberRef_.clear();
+    memberRefOrient_.clear();
+    memberDirectional_.clear();
+    memberElectrostatic_.clear();
+
+    rbIndex_.reserve(info_->getNRigidBodies());
+    rbInertia_.reserve(info_->getNRigidBodies());
+    memberStart_.reserve(info_->getNRigidBodies() + 1);
+
+    memberStart_.push_back(0);
+
+    for (mol = info_->beginMolecule(mi); mol != NULL;
+         mol = info_->nextMolecule(mi)) {
+      for (rb = mol->beginRigidBody(rbIter); rb != NULL;
+           rb = mol->nextRigidBody(rbIter)) {
+
+        Mat3x3d I = rb->getI();
+        std::vector<Atom*> atoms = rb->getAtoms();
+        rbIndex_.push_back(rb->getLocalIndex());
+        rbInertia_.push_back(Vector3d(I(0, 0), I(1, 1), I(2, 2)));
+
+        for (unsigned int i = 0; i < atoms.size(); i++) {
+          Vector3d ref;
+          atom = atoms[i];
+          rb->getAtomRefCoor(ref, i);
+
+          memberIndex_.push_back(atom->getLocalIndex());
+          memberRef_.push_back(ref);
+          memberElectrostatic_.push_back(atom->getAtomType()->isElectrostatic());
+
+          if (atom->isDirectional()) {
+            memberDirectional_.push_back(dynamic_cast<DirectionalAtom*>(atom));
+            memberRefOrient_.push_back(rb->getAtomRefOrient(i));
+          } else {
+            memberDirectional_.push_back(NULL);
+            memberRefOrient_.push_back(RotMat3x3d(0.0));
+          }
+        }
+        memberStart_.push_back(memberIndex_.size());
+      }
+    }
+
+    nRigidBodies_ = rbIndex_.size();
+    built_ = true;
+  }
+
+  void RigidBodyBatch::updateAtoms() {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+    DataStorage& rbData = snap->rigidbodyData;
+    DataStorage& atomData = snap->atomData;
+
+#pragma omp parallel for schedule(static)
+    for (int r = 0; r < nRigidBodies_; r++) {
+      const Vector3d& pos = rbData.position[rbIndex_[r]];
+      const RotMat3x3d& a = rbData.aMat[rbIndex_[r]];
+
+      for (int m = memberStart_[r]; m < memberStart_[r + 1]; m++) {
+        const Vector3d& ref = memberRef_[m];
+        Vector3d& apos = atomData.position[memberIndex_[m]];
+
+        // body-fixed to lab frame: A^T * ref
+        apos[0] = pos[0] + (a(0,0)*ref[0] + a(1,0)*ref[1] + a(2,0)*ref[2]);
+        apos[1] = pos[1] + (a(0,1)*ref[0] + a(1,1)*ref[1] + a(2,1)*ref[2]);
+        apos[2] = pos[2] + (a(0,2)*ref[0] + a(1,2)*ref[1] + a(2,2)*ref[2]);
+
+        // directional atoms also carry their multipoles along:
+        if (memberDirectional_[m] != NULL)
+          memberDirectional_[m]->setA(memberRefOrient_[m].transpose() * a);
+      }
+    }
+  }
+
+  void RigidBodyBatch::updateAtomVel() {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+    DataStorage& rbData = snap->rigidbodyData;
+    DataStorage& atomData = snap->atomData;
+
+#pragma omp parallel for schedule(static)
+    for (int r = 0; r < nRigidBodies_; r++) {
+      const Vector3d& ji = rbData.angularMomentum[rbIndex_[r]];
+      const Vector3d& I = rbInertia_[r];
+      Mat3x3d skewMat;
+
+      skewMat(0, 0) = 0;
+      skewMat(0, 1) = ji[2] / I[2];
+      skewMat(0, 2) = -ji[1] / I[1];
+
+      skewMat(1, 0) = -ji[2] / I[2];
+      skewMat(1, 1) = 0;
+      skewMat(1, 2) = ji[0] / I[0];
+
+      skewMat(2, 0) = ji[1] / I[1];
+      skewMat(2, 1) = -ji[0] / I[0];
+      skewMat(2, 2) = 0;
+
+      Mat3x3d mat = (rbData.aMat[rbIndex_[r]] * skewMat).transpose();
+      const Vector3d& rbVel = rbData.velocity[rbIndex_[r]];
+
+      for (int m = memberStart_[r]; m < memberStart_[r + 1]; m++) {
+        atomData.velocity[memberIndex_[m]] = rbVel + mat * memberRef_[m];
+      }
+    }
+  }
+
+  Mat3x3d RigidBodyBatch::calcForcesAndTorquesAndVirial() {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+    DataStorage& rbData = snap->rigidbodyData;
+    DataStorage& atomData = snap->atomData;
+
+    bool doEField = (rbData.getStorageLayout() & DataStorage::dslElectricField)
+      && (atomData.getStorageLayout() & DataStorage::dslElectricField);
+    bool atomTorques = atomData.getStorageLayout() & DataStorage::dslTorque;
+
+    Mat3x3d virial(0.0);
+
+#pragma omp parallel
+    {
+      Mat3x3d tau(0.0);
+
+#pragma omp for schedule(static) nowait
+      for (int r = 0; r < nRigidBodies_; r++) {
+        const Vector3d& pos = rbData.position[rbIndex_[r]];
+        Vector3d frc(0.0);
+        Vector3d trq(0.0);
+        Vector3d ef(0.0);
+        Vector3d rpos;
+        int eCount = 0;
+
+        for (int m = memberStart_[r]; m < memberStart_[r + 1]; m++) {
+          int ai = memberIndex_[m];
+          const Vector3d& afrc = atomData.force[ai];
+          rpos = atomData.position[ai] - pos;
+
+          frc += afrc;
+
+          trq[0] += rpos[1]*afrc[2] - rpos[2]*afrc[1];
+          trq[1] += rpos[2]*afrc[0] - rpos[0]*afrc[2];
+          trq[2] += rpos[0]*afrc[1] - rpos[1]*afrc[0];
+
+          // If the atom has a torque associated with it, then we also
+          // need to migrate the torques onto the center of mass:
+          if (atomTorques && memberDirectional_[m] != NULL)
+            trq += atomData.torque[ai];
+
+          if (doEField && memberElectrostatic_[m]) {
+            ef += atomData.electricField[ai];
+            eCount++;
+          }
+
+          tau(0,0) -= rpos[0]*afrc[0];
+          tau(0,1) -= rpos[0]*afrc[1];
+          tau(0,2) -= rpos[0]*afrc[2];
+          tau(1,0) -= rpos[1]*afrc[0];
+          tau(1,1) -= rpos[1]*afrc[1];
+          tau(1,2) -= rpos[1]*afrc[2];
+          tau(2,0) -= rpos[2]*afrc[0];
+          tau(2,1) -= rpos[2]*afrc[1];
+          tau(2,2) -= rpos[2]*afrc[2];
+        }
+
+        rbData.force[rbIndex_[r]] += frc;
+        rbData.torque[rbIndex_[r]] += trq;
+
+        if (doEField) {
+          ef /= eCount;
+          rbData.electricField[rbIndex_[r]] = ef;
+        }
+      }
+
+#pragma omp critical
+      virial += tau;
+    }
+
+    return virial;
+  }
+
+}
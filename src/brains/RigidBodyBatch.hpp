@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2014).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#ifndef BRAINS_RIGIDBODYBATCH_HPP
+#define BRAINS_RIGIDBODYBATCH_HPP
+
+#include <vector>
+#include "brains/SimInfo.hpp"
+#include "math/SquareMatrix3.hpp"
+#include "primitives/DirectionalAtom.hpp"
+
+namespace OpenMD {
+
+  /**
+   * @class RigidBodyBatch RigidBodyBatch.hpp "brains/RigidBodyBatch.hpp"
+   *
+   * Performs the per-step rigid body bookkeeping (placing member
+   * atoms, assigning member velocities, and collecting member forces
+   * and torques onto the rigid bodies) for all of the local rigid
+   * bodies at once.
+   *
+   * The membership information (local indices and body-fixed
+   * reference coordinates) is flattened into contiguous arrays when
+   * the batch is built, so the sweeps work directly on the current
+   * snapshot's DataStorage without any virtual calls or snapshot
+   * lookups per atom.  The sweeps over rigid bodies are independent,
+   * so they are threaded with OpenMP when it is available.
+   *
+   * The results are identical to calling RigidBody::updateAtoms(),
+   * RigidBody::updateAtomVel() and
+   * RigidBody::calcForcesAndTorquesAndVirial() on every rigid body.
+   */
+  class RigidBodyBatch {
+  public:
+    RigidBodyBatch(SimInfo* info);
+
+    /**
+     * Flattens the rigid body membership information.  This must be
+     * called after the reference coordinates of the rigid bodies have
+     * been computed (i.e. after the SimInfo has been created).
+     */
+    void build();
+
+    bool isBuilt() { return built_; }
+    int getNRigidBodies() { return nRigidBodies_; }
+
+    /** Places the member atoms of every local rigid body. */
+    void updateAtoms();
+
+    /** Assigns velocities to the member atoms of every local rigid body. */
+    void updateAtomVel();
+
+    /**
+     * Collects forces and torques from the member atoms onto every
+     * local rigid body.
+     * @return the (local) rigid body contribution to the virial tensor
+     */
+    Mat3x3d calcForcesAndTorquesAndVirial();
+
+  private:
+    SimInfo* info_;
+    bool built_;
+    int nRigidBodies_;
+
+    std::vector<int> rbIndex_;          /**< local index of each rigid body */
+    std::vector<Vector3d> rbInertia_;   /**< principal moments of each rigid body */
+    std::vector<int> memberStart_;      /**< offsets into the member arrays */
+
+    std::vector<int> memberIndex_;      /**< local index of each member atom */
+    std::vector<Vector3d> memberRef_;   /**< body-fixed reference coordinates */
+    std::vector<RotMat3x3d> memberRefOrient_;
+    std::vector<DirectionalAtom*> memberDirectional_; /**< NULL if not directional */
+    std::vector<char> memberElectrostatic_;
+  };
+
+}
+#endif
@@ -50,6 +50,8 @@
 #ifdef IS_MPI
 #include "mpi.h"
 #include "math/ParallelRandNumGen.hpp"
+#else
+#include <sys/time.h>
 #endif
 
 #include <exception>
@@ -250,9 +252,27 @@ namespace OpenMD {
     return simParams;
   }
   
+  /**
+   * Wall clock time in seconds, used for the startup timing breakdown.
+   */
+  static RealType wallTime() {
+#ifdef IS_MPI
+    return MPI_Wtime();
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + 1.0e-6 * tv.tv_usec;
+#endif
+  }
+
   SimInfo*  SimCreator::createSim(const std::string & mdFileName, 
                                   bool loadInitCoords) {
     
+    RealType tStart = wallTime();
+    RealType tMetaData, tForceField, tSimInfo, tDivide, tMolecules;
+    RealType tStorage, tGlobalIndex, tPairs, tCoords;
+    RealType t0, t1;
+
     const int bufferSize = 65535;
     char buffer[bufferSize];
     int lineNo = 0;
@@ -409,6 +429,10 @@ namespace OpenMD {
     //parse meta-data file
     Globals* simParams = parseFile(rawMetaDataStream, mdFileName, mdFileVersion,
                                    metaDataBlockStart + 1);
+
+    t1 = wallTime();
+    tMetaData = t1 - tStart;
+    t0 = t1;
     
     //create the force field
     ForceField * ff = new ForceField(simParams->getForceField());
@@ -446,6 +470,11 @@ namespace OpenMD {
     } 
     
     ff->parse(forcefieldFileName);
+
+    t1 = wallTime();
+    tForceField = t1 - t0;
+    t0 = t1;
+
     //create SimInfo
     SimInfo * info = new SimInfo(ff, simParams);
 
@@ -454,14 +483,26 @@ namespace OpenMD {
     //gather parameters (SimCreator only retrieves part of the
     //parameters)
     gatherParameters(info, mdFileName);
+
+    t1 = wallTime();
+    tSimInfo = t1 - t0;
+    t0 = t1;
     
     //divide the molecules and determine the global index of molecules
 #ifdef IS_MPI
     divideMolecules(info);
 #endif 
+
+    t1 = wallTime();
+    tDivide = t1 - t0;
+    t0 = t1;
     
     //create the molecules
     createMolecules(info);
+
+    t1 = wallTime();
+    tMolecules = t1 - t0;
+    t0 = t1;
     
     //find the storage layout
 
@@ -470,6 +511,10 @@ namespace OpenMD {
     //allocate memory for DataStorage(circular reference, need to
     //break it)
     info->setSnapshotManager(new SimSnapshotManager(info, storageLayout));
+
+    t1 = wallTime();
+    tStorage = t1 - t0;
+    t0 = t1;
     
     //set the global index of atoms, rigidbodies and cutoffgroups
     //(only need to be set once, the global index will never change
@@ -477,6 +522,10 @@ namespace OpenMD {
     //by MoleculeCreator class which actually delegates the
     //responsibility to LocalIndexManager.
     setGlobalIndex(info);
+
+    t1 = wallTime();
+    tGlobalIndex = t1 - t0;
+    t0 = t1;
     
     //Although addInteractionPairs is called inside SimInfo's addMolecule
     //method, at that point atoms don't have the global index yet
@@ -490,9 +539,40 @@ namespace OpenMD {
          mol = info->nextMolecule(mi)) {
       info->addInteractionPairs(mol);
     }
+
+    t1 = wallTime();
+    tPairs = t1 - t0;
+    t0 = t1;
     
     if (loadInitCoords)
       loadCoordinates(info, mdFileName);    
+
+    t1 = wallTime();
+    tCoords = t1 - t0;
+
+    // the per-phase timings are only reported when they are asked for
+    if (simParams->getPrintDiagnostics()) {
+      sprintf(painCave.errMsg,
+              "SimCreator: startup took %.3f seconds:\n"
+              "\t%-32s %10.3f\n\t%-32s %10.3f\n\t%-32s %10.3f\n"
+              "\t%-32s %10.3f\n\t%-32s %10.3f\n\t%-32s %10.3f\n"
+              "\t%-32s %10.3f\n\t%-32s %10.3f\n\t%-32s %10.3f\n",
+              t1 - tStart,
+              "meta-data read and parse", tMetaData,
+              "force field parse", tForceField,
+              "SimInfo and parameters", tSimInfo,
+              "molecule division", tDivide,
+              "molecule creation", tMolecules,
+              "storage layout and snapshots", tStorage,
+              "global indices", tGlobalIndex,
+              "interaction pairs", tPairs,
+              "initial coordinates", tCoords);
+      painCave.isFatal = 0;
+      painCave.severity = OPENMD_INFO;
+      simError();
+      painCave.severity = OPENMD_ERROR;
+    }
+
     return info;
   }
   
@@ -668,7 +748,7 @@ namespace OpenMD {
 #endif
   
   void SimCreator::createMolecules(SimInfo *info) {
-    MoleculeCreator molCreator;
+    MoleculeCreator molCreator(info->getPrimitiveArenas());
     int stampId;
     
     for(int i = 0; i < info->getNGlobalMolecules(); i++) {
@@ -63,6 +63,7 @@
 #include "brains/ForceField.hpp"
 #include "utils/PropertyMap.hpp"
 #include "utils/LocalIndexManager.hpp"
+#include "utils/MemoryArena.hpp"
 #include "nonbonded/SwitchingFunction.hpp"
 
 using namespace std;
@@ -87,6 +88,21 @@ namespace OpenMD{
   class SimInfo {
   public:
     typedef map<int, Molecule*>::iterator  MoleculeIterator;
+
+    /**
+     * Arenas holding the primitives built by MoleculeCreator.  Each
+     * kind of primitive has its own arena, so all of the local atoms
+     * (or bonds, bends, ...) are contiguous and in creation order.
+     */
+    struct PrimitiveArenas {
+      MemoryArena atoms;
+      MemoryArena bonds;
+      MemoryArena bends;
+      MemoryArena torsions;
+      MemoryArena inversions;
+      MemoryArena cutoffGroups;
+      MemoryArena constraints;
+    };
     
     /**
      * Constructor of SimInfo
@@ -304,6 +320,11 @@ namespace OpenMD{
     
     /** Sets the snapshot manager. */
     void setSnapshotManager(SnapshotManager* sman);
+
+    /** Returns the arenas that own the storage of the primitives */
+    PrimitiveArenas* getPrimitiveArenas() {
+      return &primitiveArenas_;
+    }
         
     /** Returns the force field */
     ForceField* getForceField() {
@@ -673,6 +694,9 @@ namespace OpenMD{
      */        
     LocalIndexManager localIndexMan_;
 
+    /** Storage for the primitives; released after ~SimInfo deletes the molecules */
+    PrimitiveArenas primitiveArenas_;
+
     // unparsed MetaData block for storing in Dump and EOR files:
     string rawMetaData_;
 
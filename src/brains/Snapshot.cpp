@@ -143,6 +143,7 @@ namespace OpenMD {
     frameData.pressure = 0.0;        
     frameData.temperature = 0.0;
     frameData.pressureTensor = Mat3x3d(0.0);   
+    frameData.kineticTensor = Mat3x3d(0.0);
     frameData.systemDipole = Vector3d(0.0);
     frameData.systemQuadrupole = Mat3x3d(0.0);
     frameData.convectiveHeatFlux = Vector3d(0.0, 0.0, 0.0);
@@ -176,6 +177,7 @@ namespace OpenMD {
     hasCOMvel = false;
     hasCOMw = false;
     hasPressureTensor = false;    
+    hasKineticTensor = false;
     hasSystemDipole = false;      
     hasSystemQuadrupole = false;
     hasConvectiveHeatFlux = false;  
@@ -688,6 +690,15 @@ namespace OpenMD {
     frameData.pressureTensor = pressureTensor;
   }
 
+  Mat3x3d Snapshot::getKineticTensor() {
+    return frameData.kineticTensor;
+  }
+
+  void Snapshot::setKineticTensor(const Mat3x3d& kineticTensor) {
+    hasKineticTensor = true;
+    frameData.kineticTensor = kineticTensor;
+  }
+
   void Snapshot::setVirialTensor(const Mat3x3d& virialTensor) {
     frameData.virialTensor = virialTensor;
   }
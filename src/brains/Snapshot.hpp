@@ -108,6 +108,7 @@ namespace OpenMD{
     RealType hullVolume;          /**< hull volume for entire system */
     Mat3x3d  virialTensor;        /**< virial tensor */
     Mat3x3d  pressureTensor;      /**< pressure tensor */
+    Mat3x3d  kineticTensor;       /**< sum of m v v over integrable objects (kinetic part of the pressure tensor) */
     Vector3d systemDipole;        /**< total system dipole moment */
     Mat3x3d  systemQuadrupole;    /**< total system quadrupole moment */
     Vector3d conductiveHeatFlux;  /**< heat flux vector (conductive only) */
@@ -249,6 +250,9 @@ namespace OpenMD{
     Mat3x3d  getPressureTensor();
     void     setPressureTensor(const Mat3x3d& pressureTensor);
 
+    Mat3x3d  getKineticTensor();
+    void     setKineticTensor(const Mat3x3d& kineticTensor);
+
     Mat3x3d  getVirialTensor();
     void     setVirialTensor(const Mat3x3d& virialTensor);
 
@@ -314,6 +318,7 @@ namespace OpenMD{
     bool hasCOMvel;
     bool hasCOMw;
     bool hasPressureTensor;    
+    bool hasKineticTensor;
     bool hasSystemDipole;
     bool hasSystemQuadrupole;
     bool hasConvectiveHeatFlux;
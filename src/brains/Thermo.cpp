@@ -66,37 +66,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasTranslationalKineticEnergy) {
-      SimInfo::MoleculeIterator miter;
-      vector<StuntDouble*>::iterator iiter;
-      Molecule* mol;
-      StuntDouble* sd;
-      Vector3d vel;
-      RealType mass;
-      RealType kinetic(0.0);
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-             sd = mol->nextIntegrableObject(iiter)) {
-
-          mass = sd->getMass();
-          vel = sd->getVel();
-
-          kinetic += mass * (vel[0]*vel[0] + vel[1]*vel[1] + vel[2]*vel[2]);
-
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &kinetic, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      kinetic = kinetic * 0.5 / Constants::energyConvert;
-
-
-      snap->setTranslationalKineticEnergy(kinetic);
+      calcKineticProperties();
     }
     return snap->getTranslationalKineticEnergy();
   }
@@ -105,48 +75,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasRotationalKineticEnergy) {
-      SimInfo::MoleculeIterator miter;
-      vector<StuntDouble*>::iterator iiter;
-      Molecule* mol;
-      StuntDouble* sd;
-      Vector3d angMom;
-      Mat3x3d I;
-      int i, j, k;
-      RealType kinetic(0.0);
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
-             sd = mol->nextIntegrableObject(iiter)) {
-
-          if (sd->isDirectional()) {
-            angMom = sd->getJ();
-            I = sd->getI();
-
-            if (sd->isLinear()) {
-              i = sd->linearAxis();
-              j = (i + 1) % 3;
-              k = (i + 2) % 3;
-              kinetic += angMom[j] * angMom[j] / I(j, j)
-                + angMom[k] * angMom[k] / I(k, k);
-            } else {
-              kinetic += angMom[0]*angMom[0]/I(0, 0)
-                + angMom[1]*angMom[1]/I(1, 1)
-                + angMom[2]*angMom[2]/I(2, 2);
-            }
-          }
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &kinetic, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      kinetic = kinetic * 0.5 / Constants::energyConvert;
-
-      snap->setRotationalKineticEnergy(kinetic);
+      calcKineticProperties();
     }
     return snap->getRotationalKineticEnergy();
   }
@@ -217,34 +146,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasElectronicKineticEnergy) {
-
-      SimInfo::MoleculeIterator miter;
-      vector<Atom*>::iterator iiter;
-      Molecule* mol;
-      Atom* atom;
-      RealType cvel;
-      RealType cmass;
-      RealType kinetic(0.0);
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (atom = mol->beginFluctuatingCharge(iiter); atom != NULL;
-             atom = mol->nextFluctuatingCharge(iiter)) {
-
-          cmass = atom->getChargeMass();
-          cvel = atom->getFlucQVel();
-          kinetic += cmass * cvel * cvel;
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &kinetic, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      kinetic *= 0.5;
-      snap->setElectronicKineticEnergy(kinetic);
+      calcKineticProperties();
     }
 
     return snap->getElectronicKineticEnergy();
@@ -269,43 +171,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasNetCharge) {
-
-      SimInfo::MoleculeIterator miter;
-      vector<Atom*>::iterator aiter;
-      Molecule* mol;
-      Atom* atom;
-      RealType charge;
-      RealType netCharge(0.0);
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (atom = mol->beginAtom(aiter); atom != NULL;
-             atom = mol->nextAtom(aiter)) {
-
-          charge = 0.0;
-
-          FixedChargeAdapter fca = FixedChargeAdapter(atom->getAtomType());
-          if ( fca.isFixedCharge() ) {
-            charge = fca.getCharge();
-          }
-
-          FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atom->getAtomType());
-          if ( fqa.isFluctuatingCharge() ) {
-            charge += atom->getFlucQPos();
-          }
-
-          netCharge += charge;
-
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &netCharge, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      snap->setNetCharge(netCharge);
+      calcChargeMoments();
     }
 
     return snap->getNetCharge();
@@ -316,35 +182,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasChargeMomentum) {
-
-      SimInfo::MoleculeIterator miter;
-      vector<Atom*>::iterator iiter;
-      Molecule* mol;
-      Atom* atom;
-      RealType cvel;
-      RealType cmass;
-      RealType momentum(0.0);
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (atom = mol->beginFluctuatingCharge(iiter); atom != NULL;
-             atom = mol->nextFluctuatingCharge(iiter)) {
-
-          cmass = atom->getChargeMass();
-          cvel = atom->getFlucQVel();
-
-          momentum += cmass * cvel;
-
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &momentum, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      snap->setChargeMomentum(momentum);
+      calcKineticProperties();
     }
 
     return snap->getChargeMomentum();
@@ -383,31 +221,12 @@ namespace OpenMD {
 
     if (!snap->hasPressureTensor) {
 
-      Mat3x3d pressureTensor;
-      Mat3x3d p_tens(0.0);
-      RealType mass;
-      Vector3d vcom;
-
-      SimInfo::MoleculeIterator i;
-      vector<StuntDouble*>::iterator j;
-      Molecule* mol;
-      StuntDouble* sd;
-      for (mol = info_->beginMolecule(i); mol != NULL;
-           mol = info_->nextMolecule(i)) {
-
-        for (sd = mol->beginIntegrableObject(j); sd != NULL;
-             sd = mol->nextIntegrableObject(j)) {
-
-          mass = sd->getMass();
-          vcom = sd->getVel();
-          p_tens += mass * outProduct(vcom, vcom);
-        }
+      if (!snap->hasKineticTensor) {
+        calcKineticProperties();
       }
 
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, p_tens.getArrayPointer(), 9,
-                    MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-#endif
+      Mat3x3d pressureTensor;
+      Mat3x3d p_tens = snap->getKineticTensor();
 
       RealType volume = this->getVolume();
       Mat3x3d virialTensor = snap->getVirialTensor();
@@ -424,100 +243,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasSystemDipole) {
-      SimInfo::MoleculeIterator miter;
-      vector<Atom*>::iterator aiter;
-      Molecule* mol;
-      Atom* atom;
-      RealType charge;
-      Vector3d ri(0.0);
-      Vector3d dipoleVector(0.0);
-      Vector3d nPos(0.0);
-      Vector3d pPos(0.0);
-      RealType nChg(0.0);
-      RealType pChg(0.0);
-      int nCount = 0;
-      int pCount = 0;
-
-      RealType chargeToC = 1.60217733e-19;
-      RealType angstromToM = 1.0e-10;
-      RealType debyeToCm = 3.33564095198e-30;
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (atom = mol->beginAtom(aiter); atom != NULL;
-             atom = mol->nextAtom(aiter)) {
-
-          charge = 0.0;
-
-          FixedChargeAdapter fca = FixedChargeAdapter(atom->getAtomType());
-          if ( fca.isFixedCharge() ) {
-            charge = fca.getCharge();
-          }
-
-          FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atom->getAtomType());
-          if ( fqa.isFluctuatingCharge() ) {
-            charge += atom->getFlucQPos();
-          }
-
-          charge *= chargeToC;
-
-          ri = atom->getPos();
-          snap->wrapVector(ri);
-          ri *= angstromToM;
-
-          if (charge < 0.0) {
-            nPos += ri;
-            nChg -= charge;
-            nCount++;
-          } else if (charge > 0.0) {
-            pPos += ri;
-            pChg += charge;
-            pCount++;
-          }
-
-          if (atom->isDipole()) {
-            dipoleVector += atom->getDipole() * debyeToCm;
-          }
-        }
-      }
-
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &pChg, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &nChg, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-
-      MPI_Allreduce(MPI_IN_PLACE, &pCount, 1, MPI_INTEGER,
-                    MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &nCount, 1, MPI_INTEGER,
-                    MPI_SUM, MPI_COMM_WORLD);
-
-      MPI_Allreduce(MPI_IN_PLACE, pPos.getArrayPointer(), 3,
-                    MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, nPos.getArrayPointer(), 3,
-                    MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-
-      MPI_Allreduce(MPI_IN_PLACE, dipoleVector.getArrayPointer(),
-                    3, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      // first load the accumulated dipole moment (if dipoles were present)
-      Vector3d boxDipole = dipoleVector;
-      // now include the dipole moment due to charges
-      // use the lesser of the positive and negative charge totals
-      RealType chg_value = nChg <= pChg ? nChg : pChg;
-
-      // find the average positions
-      if (pCount > 0 && nCount > 0 ) {
-        pPos /= pCount;
-        nPos /= nCount;
-      }
-
-      // dipole is from the negative to the positive (physics notation)
-      boxDipole += (pPos - nPos) * chg_value;
-      snap->setSystemDipole(boxDipole);
+      calcChargeMoments();
     }
 
     return snap->getSystemDipole();
@@ -528,65 +254,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasSystemQuadrupole) {
-      SimInfo::MoleculeIterator miter;
-      vector<Atom*>::iterator aiter;
-      Molecule* mol;
-      Atom* atom;
-      RealType charge;
-      Vector3d ri(0.0);
-      Vector3d dipole(0.0);
-      Mat3x3d qpole(0.0);
-
-      RealType chargeToC = 1.60217733e-19;
-      RealType angstromToM = 1.0e-10;
-      RealType debyeToCm = 3.33564095198e-30;
-
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-           mol = info_->nextMolecule(miter)) {
-
-        for (atom = mol->beginAtom(aiter); atom != NULL;
-             atom = mol->nextAtom(aiter)) {
-
-          ri = atom->getPos();
-          snap->wrapVector(ri);
-          ri *= angstromToM;
-
-          charge = 0.0;
-
-          FixedChargeAdapter fca = FixedChargeAdapter(atom->getAtomType());
-          if ( fca.isFixedCharge() ) {
-            charge = fca.getCharge();
-          }
-
-          FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atom->getAtomType());
-          if ( fqa.isFluctuatingCharge() ) {
-            charge += atom->getFlucQPos();
-          }
-
-          charge *= chargeToC;
-
-          qpole += 0.5 * charge * outProduct(ri, ri);
-
-          MultipoleAdapter ma = MultipoleAdapter(atom->getAtomType());
-
-          if ( ma.isDipole() ) {
-            dipole = atom->getDipole() * debyeToCm;
-            qpole += 0.5 * outProduct( dipole, ri );
-            qpole += 0.5 * outProduct( ri, dipole );
-          }
-
-          if ( ma.isQuadrupole() ) {
-            qpole += atom->getQuadrupole() * debyeToCm * angstromToM;
-          }
-        }
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, qpole.getArrayPointer(),
-                    9, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      snap->setSystemQuadrupole(qpole);
+      calcChargeMoments();
     }
 
     return snap->getSystemQuadrupole();
@@ -690,29 +358,7 @@ namespace OpenMD {
     Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
     if (!snap->hasCOMvel) {
-
-      SimInfo::MoleculeIterator i;
-      Molecule* mol;
-
-      Vector3d comVel(0.0);
-      RealType totalMass(0.0);
-
-      for (mol = info_->beginMolecule(i); mol != NULL;
-           mol = info_->nextMolecule(i)) {
-        RealType mass = mol->getMass();
-        totalMass += mass;
-        comVel += mass * mol->getComVel();
-      }
-
-#ifdef IS_MPI
-      MPI_Allreduce(MPI_IN_PLACE, &totalMass, 1, MPI_REALTYPE,
-                    MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, comVel.getArrayPointer(), 3,
-                    MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-      comVel /= totalMass;
-      snap->setCOMvel(comVel);
+      calcKineticProperties();
     }
     return snap->getCOMvel();
   }
@@ -1140,5 +786,231 @@ namespace OpenMD {
 #endif
   }
 
+  /**
+   * Fills every velocity-dependent property of the current snapshot
+   * (translational, rotational and electronic kinetic energies, the
+   * kinetic part of the pressure tensor, the charge momentum and the
+   * center of mass velocity) from a single pass over the integrable
+   * objects and fluctuating charges.  All partial sums are packed
+   * into one buffer so that only one reduction is needed.  Properties
+   * that were already cached in the snapshot are left untouched.
+   */
+  void Thermo::calcKineticProperties() {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
 
+    SimInfo::MoleculeIterator miter;
+    vector<StuntDouble*>::iterator iiter;
+    vector<Atom*>::iterator aiter;
+    Molecule* mol;
+    StuntDouble* sd;
+    Atom* atom;
+    Vector3d vel;
+    Vector3d angMom;
+    Mat3x3d I;
+    RealType mass;
+    RealType cvel;
+    RealType cmass;
+    int i, j, k;
+
+    // [0-8] kinetic tensor, [9] rotational kinetic, [10] electronic
+    // kinetic, [11] charge momentum, [12-14] linear momentum, [15] mass
+    RealType buf[16];
+    for (i = 0; i < 16; i++) buf[i] = 0.0;
+
+    for (mol = info_->beginMolecule(miter); mol != NULL;
+         mol = info_->nextMolecule(miter)) {
+
+      for (sd = mol->beginIntegrableObject(iiter); sd != NULL;
+           sd = mol->nextIntegrableObject(iiter)) {
+
+        mass = sd->getMass();
+        vel = sd->getVel();
+
+        for (i = 0; i < 3; i++) {
+          for (j = 0; j < 3; j++) {
+            buf[3*i + j] += mass * vel[i] * vel[j];
+          }
+          buf[12 + i] += mass * vel[i];
+        }
+        buf[15] += mass;
+
+        if (sd->isDirectional()) {
+          angMom = sd->getJ();
+          I = sd->getI();
+
+          if (sd->isLinear()) {
+            i = sd->linearAxis();
+            j = (i + 1) % 3;
+            k = (i + 2) % 3;
+            buf[9] += angMom[j] * angMom[j] / I(j, j)
+              + angMom[k] * angMom[k] / I(k, k);
+          } else {
+            buf[9] += angMom[0]*angMom[0]/I(0, 0)
+              + angMom[1]*angMom[1]/I(1, 1)
+              + angMom[2]*angMom[2]/I(2, 2);
+          }
+        }
+      }
+
+      for (atom = mol->beginFluctuatingCharge(aiter); atom != NULL;
+           atom = mol->nextFluctuatingCharge(aiter)) {
+
+        cmass = atom->getChargeMass();
+        cvel = atom->getFlucQVel();
+        buf[10] += cmass * cvel * cvel;
+        buf[11] += cmass * cvel;
+      }
+    }
+
+#ifdef IS_MPI
+    MPI_Allreduce(MPI_IN_PLACE, buf, 16, MPI_REALTYPE,
+                  MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+    Mat3x3d kineticTensor(buf);
+
+    if (!snap->hasKineticTensor)
+      snap->setKineticTensor(kineticTensor);
+
+    if (!snap->hasTranslationalKineticEnergy)
+      snap->setTranslationalKineticEnergy(0.5 * kineticTensor.trace() /
+                                          Constants::energyConvert);
+
+    if (!snap->hasRotationalKineticEnergy)
+      snap->setRotationalKineticEnergy(0.5 * buf[9] /
+                                       Constants::energyConvert);
+
+    if (!snap->hasElectronicKineticEnergy)
+      snap->setElectronicKineticEnergy(0.5 * buf[10]);
+
+    if (!snap->hasChargeMomentum)
+      snap->setChargeMomentum(buf[11]);
+
+    if (!snap->hasCOMvel)
+      snap->setCOMvel(Vector3d(buf[12], buf[13], buf[14]) / buf[15]);
+  }
+
+  /**
+   * Fills the net charge, the system dipole and the system quadrupole
+   * of the current snapshot from a single pass over the atoms with a
+   * single reduction.  Properties that were already cached in the
+   * snapshot are left untouched.
+   */
+  void Thermo::calcChargeMoments() {
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+
+    SimInfo::MoleculeIterator miter;
+    vector<Atom*>::iterator aiter;
+    Molecule* mol;
+    Atom* atom;
+    RealType charge;
+    Vector3d ri(0.0);
+    Vector3d dipole(0.0);
+    int i, j;
+
+    RealType chargeToC = 1.60217733e-19;
+    RealType angstromToM = 1.0e-10;
+    RealType debyeToCm = 3.33564095198e-30;
+
+    // [0] net charge, [1] positive charge, [2] negative charge,
+    // [3] positive count, [4] negative count, [5-7] positive
+    // positions, [8-10] negative positions, [11-13] point dipoles,
+    // [14-22] quadrupole
+    RealType buf[23];
+    for (i = 0; i < 23; i++) buf[i] = 0.0;
+
+    for (mol = info_->beginMolecule(miter); mol != NULL;
+         mol = info_->nextMolecule(miter)) {
+
+      for (atom = mol->beginAtom(aiter); atom != NULL;
+           atom = mol->nextAtom(aiter)) {
+
+        charge = 0.0;
+
+        FixedChargeAdapter fca = FixedChargeAdapter(atom->getAtomType());
+        if ( fca.isFixedCharge() ) {
+          charge = fca.getCharge();
+        }
+
+        FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atom->getAtomType());
+        if ( fqa.isFluctuatingCharge() ) {
+          charge += atom->getFlucQPos();
+        }
+
+        buf[0] += charge;
+
+        charge *= chargeToC;
+
+        ri = atom->getPos();
+        snap->wrapVector(ri);
+        ri *= angstromToM;
+
+        if (charge < 0.0) {
+          for (i = 0; i < 3; i++) buf[8 + i] += ri[i];
+          buf[2] -= charge;
+          buf[4] += 1.0;
+        } else if (charge > 0.0) {
+          for (i = 0; i < 3; i++) buf[5 + i] += ri[i];
+          buf[1] += charge;
+          buf[3] += 1.0;
+        }
+
+        Mat3x3d qpole;
+        qpole = 0.5 * charge * outProduct(ri, ri);
+
+        MultipoleAdapter ma = MultipoleAdapter(atom->getAtomType());
+
+        if ( ma.isDipole() ) {
+          dipole = atom->getDipole() * debyeToCm;
+          for (i = 0; i < 3; i++) buf[11 + i] += dipole[i];
+          qpole += 0.5 * outProduct( dipole, ri );
+          qpole += 0.5 * outProduct( ri, dipole );
+        }
+
+        if ( ma.isQuadrupole() ) {
+          qpole += atom->getQuadrupole() * debyeToCm * angstromToM;
+        }
+
+        for (i = 0; i < 3; i++)
+          for (j = 0; j < 3; j++)
+            buf[14 + 3*i + j] += qpole(i, j);
+      }
+    }
+
+#ifdef IS_MPI
+    MPI_Allreduce(MPI_IN_PLACE, buf, 23, MPI_REALTYPE,
+                  MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+    if (!snap->hasNetCharge)
+      snap->setNetCharge(buf[0]);
+
+    if (!snap->hasSystemDipole) {
+      RealType pChg = buf[1];
+      RealType nChg = buf[2];
+      int pCount = int(buf[3] + 0.5);
+      int nCount = int(buf[4] + 0.5);
+      Vector3d pPos(buf[5], buf[6], buf[7]);
+      Vector3d nPos(buf[8], buf[9], buf[10]);
+
+      // first load the accumulated dipole moment (if dipoles were present)
+      Vector3d boxDipole(buf[11], buf[12], buf[13]);
+      // now include the dipole moment due to charges
+      // use the lesser of the positive and negative charge totals
+      RealType chg_value = nChg <= pChg ? nChg : pChg;
+
+      // find the average positions
+      if (pCount > 0 && nCount > 0 ) {
+        pPos /= pCount;
+        nPos /= nCount;
+      }
+
+      // dipole is from the negative to the positive (physics notation)
+      boxDipole += (pPos - nPos) * chg_value;
+      snap->setSystemDipole(boxDipole);
+    }
+
+    if (!snap->hasSystemQuadrupole)
+      snap->setSystemQuadrupole(Mat3x3d(&buf[14]));
+  }
 }
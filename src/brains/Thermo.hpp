@@ -122,6 +122,14 @@ namespace OpenMD {
     RealType getTaggedAtomPairDistance();
     
   private:    
+    /** \brief Fused pass that computes all velocity-dependent
+        properties of the current snapshot with a single reduction */
+    void calcKineticProperties();
+
+    /** \brief Fused pass that computes the net charge, system dipole
+        and system quadrupole with a single reduction */
+    void calcChargeMoments();
+
     SimInfo* info_;
   };
   
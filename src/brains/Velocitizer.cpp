@@ -40,9 +40,13 @@
  * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
  */
 
+#ifdef IS_MPI
+#include <mpi.h>
+#endif
+
 #include "brains/Velocitizer.hpp"
-#include "brains/Thermo.hpp"
 #include "math/SquareMatrix3.hpp"
+#include "math/CounterRandNumGen.hpp"
 #include "utils/Constants.hpp"
 #include "primitives/Molecule.hpp"
 #include "primitives/StuntDouble.hpp"
@@ -58,7 +62,9 @@
 
 namespace OpenMD {
 
-  Velocitizer::Velocitizer(SimInfo* info) : info_(info), thermo_(info) {
+  int Velocitizer::nCreated_ = 0;
+
+  Velocitizer::Velocitizer(SimInfo* info) : info_(info), nResamples_(0) {
 
     globals_ = info->getSimParams();
 
@@ -77,6 +83,19 @@ namespace OpenMD {
       randNumGen_ = new ParallelRandNumGen();
     }
 #endif
+
+    // Velocities are drawn from streams keyed on this seed, the
+    // instance, the resample count and each object's global index, so
+    // every processor must agree on the seed:
+    if (globals_->haveSeed()) {
+      seed_ = globals_->getSeed();
+    } else {
+      seed_ = randNumGen_->randInt();
+#ifdef IS_MPI
+      MPI_Bcast(&seed_, 1, MPI_UNSIGNED_LONG, 0, MPI_COMM_WORLD);
+#endif
+    }
+    instance_ = nCreated_++;
   }
 
   Velocitizer::~Velocitizer() {
@@ -84,106 +103,26 @@ namespace OpenMD {
   }
 
   void Velocitizer::scale(RealType lambda) {
-    SimInfo::MoleculeIterator mi;
-    Molecule::IntegrableObjectIterator ioi;
-    Molecule * mol;
-    StuntDouble * sd;
-    Vector3d v, j;
-
-    for( mol = info_->beginMolecule(mi); mol != NULL;
-	 mol = info_->nextMolecule(mi) ) {
-
-      for( sd = mol->beginIntegrableObject(ioi); sd != NULL;
-	   sd = mol->nextIntegrableObject(ioi) ) {
-
-	v = sd->getVel();
-        v *= lambda;
-	sd->setVel(v);
-
-	if (sd->isDirectional()) {
-          j = sd->getJ();
-          j *= lambda;
-	  sd->setJ(j);
-	}
-      }
-    }
+    RealType moments[nMoments];
 
-    removeComDrift();
+    sweep(smScale, lambda, moments);
 
     // Remove angular drift if we are not using periodic boundary
     // conditions:
-
-    if(!globals_->getUsePeriodicBoundaryConditions()) removeAngularDrift();
+    removeDrift(moments, !globals_->getUsePeriodicBoundaryConditions());
   }
 
   void Velocitizer::randomize(RealType temperature) {
-    Vector3d v;
-    Vector3d j;
-    Mat3x3d I;
-    int l, m, n;
-    Vector3d vdrift;
-    RealType vbar;
-    RealType jbar;
-    RealType av2;
-    RealType kebar;
-
-    SimInfo::MoleculeIterator mi;
-    Molecule::IntegrableObjectIterator ioi;
-    Molecule * mol;
-    StuntDouble * sd;
-
-    kebar = Constants::kB * temperature * info_->getNdfRaw() /
+    RealType moments[nMoments];
+    RealType kebar = Constants::kB * temperature * info_->getNdfRaw() /
       (2.0 * info_->getNdf());
-    for( mol = info_->beginMolecule(mi); mol != NULL;
-	 mol = info_->nextMolecule(mi) ) {
-
-      for( sd = mol->beginIntegrableObject(ioi); sd != NULL;
-	   sd = mol->nextIntegrableObject(ioi) ) {
-
-	// uses equipartition theory to solve for vbar in angstrom/fs
-
-	av2 = 2.0 * kebar / sd->getMass();
-	vbar = sqrt(av2);
-
-	// picks random velocities from a gaussian distribution
-	// centered on vbar
-
-	for( int k = 0; k < 3; k++ ) {
-	  v[k] = vbar * randNumGen_->randNorm(0.0, 1.0);
-	}
-	sd->setVel(v);
-
-	if (sd->isDirectional()) {
-	  I = sd->getI();
-
-	  if (sd->isLinear()) {
-	    l = sd->linearAxis();
-	    m = (l + 1) % 3;
-	    n = (l + 2) % 3;
-
-	    j[l] = 0.0;
-	    jbar = sqrt(2.0 * kebar * I(m, m));
-	    j[m] = jbar * randNumGen_->randNorm(0.0, 1.0);
-	    jbar = sqrt(2.0 * kebar * I(n, n));
-	    j[n] = jbar * randNumGen_->randNorm(0.0, 1.0);
-	  } else {
-	    for( int k = 0; k < 3; k++ ) {
-	      jbar = sqrt(2.0 * kebar * I(k, k));
-	      j[k] = jbar *randNumGen_->randNorm(0.0, 1.0);
-	    }
-	  }
-
-	  sd->setJ(j);
-	}
-      }
-    }
 
-    removeComDrift();
+    sweep(smRandomize, kebar, moments);
+    nResamples_++;
 
     // Remove angular drift if we are not using periodic boundary
     // conditions:
-
-    if(!globals_->getUsePeriodicBoundaryConditions()) removeAngularDrift();
+    removeDrift(moments, !globals_->getUsePeriodicBoundaryConditions());
   }
 
 
@@ -261,64 +200,196 @@ fqConstraints->applyConstraintsOnChargeVelocities();
 
 
   void Velocitizer::removeComDrift() {
-    // Get the Center of Mass drift velocity.
-    Vector3d vdrift = thermo_.getComVel();
+    RealType moments[nMoments];
+    sweep(smAccumulate, 0.0, moments);
+    removeDrift(moments, false);
+  }
+
+  void Velocitizer::removeAngularDrift() {
+    RealType moments[nMoments];
+    sweep(smAccumulate, 0.0, moments);
+    removeDrift(moments, true);
+  }
 
+  void Velocitizer::collectObjects() {
     SimInfo::MoleculeIterator mi;
     Molecule::IntegrableObjectIterator ioi;
-    Molecule * mol;
-    StuntDouble * sd;
+    Molecule* mol;
+    StuntDouble* sd;
+
+    sds_.clear();
+    sds_.reserve(info_->getNIntegrableObjects());
 
-    //  Corrects for the center of mass drift.
-    // sums all the momentum and divides by total mass.
     for( mol = info_->beginMolecule(mi); mol != NULL;
          mol = info_->nextMolecule(mi) ) {
-
       for( sd = mol->beginIntegrableObject(ioi); sd != NULL;
-	   sd = mol->nextIntegrableObject(ioi) ) {
-
-	sd->setVel(sd->getVel() - vdrift);
-
+           sd = mol->nextIntegrableObject(ioi) ) {
+        sds_.push_back(sd);
       }
     }
   }
 
-  void Velocitizer::removeAngularDrift() {
-    // Get the Center of Mass drift velocity.
+  void Velocitizer::sweep(SweepMode mode, RealType param, RealType* moments) {
+    collectObjects();
+    int nObjects = sds_.size();
+
+    for (int k = 0; k < nMoments; k++) moments[k] = 0.0;
+
+#pragma omp parallel
+    {
+      RealType local[nMoments];
+      for (int k = 0; k < nMoments; k++) local[k] = 0.0;
+
+#pragma omp for schedule(static) nowait
+      for (int i = 0; i < nObjects; i++) {
+        StuntDouble* sd = sds_[i];
+
+        switch (mode) {
+        case smScale:
+          sd->setVel(sd->getVel() * param);
+          if (sd->isDirectional()) sd->setJ(sd->getJ() * param);
+          break;
+        case smRandomize:
+          randomizeObject(sd, param);
+          break;
+        default:
+          break;
+        }
+
+        RealType mass = sd->getMass();
+        Vector3d pos = sd->getPos();
+        Vector3d vel = sd->getVel();
+        Vector3d l = cross(pos, vel);
+
+        local[mMass] += mass;
+        for (int k = 0; k < 3; k++) {
+          local[mMomentum + k] += mass * vel[k];
+          local[mFirstMoment + k] += mass * pos[k];
+          local[mAngularMomentum + k] += mass * l[k];
+        }
+        local[mSecondMoment]     += mass * pos[0] * pos[0];
+        local[mSecondMoment + 1] += mass * pos[1] * pos[1];
+        local[mSecondMoment + 2] += mass * pos[2] * pos[2];
+        local[mSecondMoment + 3] += mass * pos[0] * pos[1];
+        local[mSecondMoment + 4] += mass * pos[0] * pos[2];
+        local[mSecondMoment + 5] += mass * pos[1] * pos[2];
+      }
 
-    Vector3d vdrift;
-    Vector3d com;
+#pragma omp critical
+      for (int k = 0; k < nMoments; k++) moments[k] += local[k];
+    }
+  }
+
+  void Velocitizer::randomizeObject(StuntDouble* sd, RealType kebar) {
+    Vector3d v;
+    Vector3d j;
+    Mat3x3d I;
+    int l, m, n;
+    RealType vbar;
+    RealType jbar;
+    RealType av2;
 
-    thermo_.getComAll(com, vdrift);
+    // the stream depends only on the object, never on the processor
+    // or thread that owns it:
+    CounterRandNumGen rng(seed_, (uint64_t(instance_) << 32) | nResamples_,
+                          sd->getGlobalIntegrableObjectIndex());
 
-    Mat3x3d inertiaTensor;
-    Vector3d angularMomentum;
-    Vector3d omega;
+    // uses equipartition theory to solve for vbar in angstrom/fs
 
-    thermo_.getInertiaTensor(inertiaTensor, angularMomentum);
+    av2 = 2.0 * kebar / sd->getMass();
+    vbar = sqrt(av2);
 
-    // We now need the inverse of the inertia tensor.
-    inertiaTensor = inertiaTensor.inverse();
-    omega = inertiaTensor * angularMomentum;
+    // picks random velocities from a gaussian distribution
+    // centered on vbar
 
-    SimInfo::MoleculeIterator mi;
-    Molecule::IntegrableObjectIterator ioi;
-    Molecule* mol;
-    StuntDouble* sd;
-    Vector3d tempComPos;
+    for( int k = 0; k < 3; k++ ) {
+      v[k] = vbar * rng.randNorm(0.0, 1.0);
+    }
+    sd->setVel(v);
+
+    if (sd->isDirectional()) {
+      I = sd->getI();
+
+      if (sd->isLinear()) {
+        l = sd->linearAxis();
+        m = (l + 1) % 3;
+        n = (l + 2) % 3;
+
+        j[l] = 0.0;
+        jbar = sqrt(2.0 * kebar * I(m, m));
+        j[m] = jbar * rng.randNorm(0.0, 1.0);
+        jbar = sqrt(2.0 * kebar * I(n, n));
+        j[n] = jbar * rng.randNorm(0.0, 1.0);
+      } else {
+        for( int k = 0; k < 3; k++ ) {
+          jbar = sqrt(2.0 * kebar * I(k, k));
+          j[k] = jbar * rng.randNorm(0.0, 1.0);
+        }
+      }
 
-    // Corrects for the center of mass angular drift by summing all
-    // the angular momentum and dividing by the total mass.
+      sd->setJ(j);
+    }
+  }
 
-    for( mol = info_->beginMolecule(mi); mol != NULL;
-         mol = info_->nextMolecule(mi) ) {
+  void Velocitizer::removeDrift(RealType* moments, bool angular) {
+#ifdef IS_MPI
+    MPI_Allreduce(MPI_IN_PLACE, moments, nMoments, MPI_REALTYPE,
+                  MPI_SUM, MPI_COMM_WORLD);
+#endif
 
-      for( sd = mol->beginIntegrableObject(ioi); sd != NULL;
-           sd = mol->nextIntegrableObject(ioi) ) {
+    RealType totalMass = moments[mMass];
+    Vector3d vdrift(moments[mMomentum], moments[mMomentum + 1],
+                    moments[mMomentum + 2]);
+    Vector3d com(moments[mFirstMoment], moments[mFirstMoment + 1],
+                 moments[mFirstMoment + 2]);
+    vdrift /= totalMass;
+    com /= totalMass;
+
+    Vector3d omega(0.0);
+
+    if (angular) {
+      // Second moments about the center of mass, and the angular
+      // momentum relative to the center of mass motion:
+      RealType xx = moments[mSecondMoment]     - totalMass * com[0] * com[0];
+      RealType yy = moments[mSecondMoment + 1] - totalMass * com[1] * com[1];
+      RealType zz = moments[mSecondMoment + 2] - totalMass * com[2] * com[2];
+      RealType xy = moments[mSecondMoment + 3] - totalMass * com[0] * com[1];
+      RealType xz = moments[mSecondMoment + 4] - totalMass * com[0] * com[2];
+      RealType yz = moments[mSecondMoment + 5] - totalMass * com[1] * com[2];
+
+      Mat3x3d inertiaTensor;
+      inertiaTensor(0,0) = yy + zz;
+      inertiaTensor(0,1) = -xy;
+      inertiaTensor(0,2) = -xz;
+      inertiaTensor(1,0) = -xy;
+      inertiaTensor(1,1) = xx + zz;
+      inertiaTensor(1,2) = -yz;
+      inertiaTensor(2,0) = -xz;
+      inertiaTensor(2,1) = -yz;
+      inertiaTensor(2,2) = xx + yy;
+
+      Vector3d angularMomentum(moments[mAngularMomentum],
+                               moments[mAngularMomentum + 1],
+                               moments[mAngularMomentum + 2]);
+      angularMomentum -= totalMass * cross(com, vdrift);
+
+      // We now need the inverse of the inertia tensor.
+      omega = inertiaTensor.inverse() * angularMomentum;
+    }
 
-        tempComPos = sd->getPos() - com;
-        sd->setVel((sd->getVel() - vdrift) - cross(omega, tempComPos));
+    int nObjects = sds_.size();
+
+    // Corrects for the center of mass drift and, if requested, the
+    // angular drift about the center of mass in a single sweep.
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < nObjects; i++) {
+      StuntDouble* sd = sds_[i];
+      Vector3d vel = sd->getVel() - vdrift;
+      if (angular) {
+        Vector3d r = sd->getPos() - com;
+        vel -= cross(omega, r);
       }
+      sd->setVel(vel);
     }
   }
 }
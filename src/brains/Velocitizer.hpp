@@ -43,7 +43,6 @@
 #ifndef BRAINS_VELOCITIZER_HPP
 #define BRAINS_VELOCITIZER_HPP
 #include "brains/SimInfo.hpp"
-#include "brains/Thermo.hpp"
 #include "math/RandNumGen.hpp"
 
 namespace OpenMD {
@@ -93,10 +92,48 @@ namespace OpenMD {
     void removeAngularDrift();
 
   private:
+    enum SweepMode {
+      smAccumulate,
+      smScale,
+      smRandomize
+    };
+
+    /** Offsets of the mass moments gathered in a single sweep */
+    enum Moment {
+      mMass = 0,
+      mMomentum = 1,          // sum m v
+      mFirstMoment = 4,       // sum m r
+      mSecondMoment = 7,      // sum m r r (xx, yy, zz, xy, xz, yz)
+      mAngularMomentum = 13,  // sum m r x v
+      nMoments = 16
+    };
+
+    void collectObjects();
+
+    /**
+     * Walks the integrable objects once, optionally scaling or
+     * resampling their velocities, and sums the mass moments needed
+     * to remove the linear and angular drift.
+     */
+    void sweep(SweepMode mode, RealType param, RealType* moments);
+    void randomizeObject(StuntDouble* sd, RealType kebar);
+
+    /**
+     * Reduces the moments across processors and subtracts the center
+     * of mass velocity (and, if angular is true, the rigid rotation
+     * about the center of mass) from every integrable object.
+     */
+    void removeDrift(RealType* moments, bool angular);
+
     SimInfo* info_;
     Globals* globals_;
-    Thermo thermo_;
     RandNumGen* randNumGen_;
+
+    std::vector<StuntDouble*> sds_;
+    unsigned long seed_;
+    int instance_;
+    unsigned int nResamples_;
+    static int nCreated_;
   };
 
 }
@@ -54,10 +54,12 @@ namespace OpenMD {
   struct ZconstraintMol {
     Molecule* mol;
     ZconstraintParam param;
+    RealType mass;            /**< mass of the molecule (never changes) */
     RealType fz;
     RealType zpos;
     RealType cantPos;         /**< current position of cantilever */
     RealType endFixingTime;    
+    Vector3d com;             /**< center of mass in the current step */
   };
 
 
@@ -161,9 +161,8 @@ namespace OpenMD {
     // (never changes during the simulation)
     
     totMassUnconsMols_ = 0.0;    
-    std::vector<Molecule*>::iterator j;
-    for ( j = unzconsMols_.begin(); j !=  unzconsMols_.end(); ++j) {
-      totMassUnconsMols_ += (*j)->getMass();
+    for (unsigned int j = 0; j < unzconsMass_.size(); ++j) {
+      totMassUnconsMols_ += unzconsMass_[j];
     }    
 #ifdef IS_MPI
     MPI_Allreduce(MPI_IN_PLACE, &totMassUnconsMols_, 1,
@@ -189,6 +188,7 @@ namespace OpenMD {
     fixedZMols_.clear();
     movingZMols_.clear();
     unzconsMols_.clear();
+    unzconsMass_.clear();
 
     for (std::map<int, ZconstraintParam>::iterator i = allZMolIndices_.begin();
          i != allZMolIndices_.end(); ++i) {
@@ -199,11 +199,15 @@ namespace OpenMD {
 	zmol.mol = info_->getMoleculeByGlobalIndex(i->first);
 	assert(zmol.mol);
 	zmol.param = i->second;
+        zmol.mass = zmol.mol->getMass();
+        zmol.fz = 0.0;
 	zmol.cantPos = zmol.param.zTargetPos; /**@todo fix me when
                                                  zmol migrates, it is
                                                  incorrect*/
-	Vector3d com = zmol.mol->getCom();
-        Vector3d d =  Vector3d(0.0, 0.0, zmol.param.zTargetPos) - com;
+        zmol.endFixingTime = infiniteTime;
+	zmol.com = zmol.mol->getCom();
+        zmol.zpos = zmol.com[whichDirection];
+        Vector3d d =  Vector3d(0.0, 0.0, zmol.param.zTargetPos) - zmol.com;
         info_->getSnapshotManager()->getCurrentSnapshot()->wrapVector(d);
 	RealType diff = fabs(d[whichDirection]);
         
@@ -220,23 +224,13 @@ namespace OpenMD {
 
     calcTotalMassMovingZMols();
 
-    std::set<int> zmolSet;
-    for (std::list<ZconstraintMol>::iterator i = movingZMols_.begin();
-         i !=  movingZMols_.end(); ++i) {
-      zmolSet.insert(i->mol->getGlobalIndex());
-    }    
-
-    for (std::list<ZconstraintMol>::iterator i = fixedZMols_.begin();
-         i !=  fixedZMols_.end(); ++i) {
-      zmolSet.insert(i->mol->getGlobalIndex());
-    }
-
     SimInfo::MoleculeIterator mi;
     Molecule* mol;
     for(mol = info_->beginMolecule(mi); mol != NULL;
         mol = info_->nextMolecule(mi)) {
-      if (zmolSet.find(mol->getGlobalIndex()) == zmolSet.end()) {
+      if (!isZMol(mol)) {
 	unzconsMols_.push_back(mol);
+        unzconsMass_.push_back(mol->getMass());
       }
     }
   }
@@ -261,30 +255,77 @@ namespace OpenMD {
       updateZPos();
     }
 
-    if (checkZConsState()){
+    // checkZConsState caches the center of mass of every local
+    // z-constrained molecule.  One more pass gathers the quantities
+    // needed for the constraint and restraint forces, and a single
+    // reduction makes all of them global:
+    //
+    //   sums[0]  number of molecules that changed state
+    //   sums[1]  number of fixed z-constrained molecules
+    //   sums[2]  number of moving z-constrained molecules
+    //   sums[3]  mass of the moving z-constrained molecules
+    //   sums[4]  total z-constraint force on the fixed molecules
+    //   sums[5]  total harmonic force on the moving molecules
+
+    RealType sums[6];
+    sums[0] = checkZConsState() ? 1.0 : 0.0;
+    sums[1] = fixedZMols_.size();
+    sums[2] = movingZMols_.size();
+    sums[3] = 0.0;
+    sums[4] = 0.0;
+    sums[5] = 0.0;
+
+    std::vector<ZconstraintMol>::iterator i;
+    StuntDouble* sd;
+    Molecule::IntegrableObjectIterator ii;
+
+    for (i = fixedZMols_.begin(); i != fixedZMols_.end(); ++i) {
+      i->fz = 0.0;
+      for(sd = i->mol->beginIntegrableObject(ii); sd != NULL; 
+	  sd = i->mol->nextIntegrableObject(ii)) {
+	i->fz += sd->getFrc()[whichDirection];
+      }
+      sums[4] += i->fz;
+    }
+
+    RealType lrPot = currSnapshot_->getLongRangePotential();
+    for (i = movingZMols_.begin(); i != movingZMols_.end(); ++i) {
+      sums[3] += i->mass;
+
+      RealType resPos = usingSMD_? i->cantPos : i->param.zTargetPos;
+      Vector3d d = i->com - Vector3d(0.0, 0.0, resPos);
+      currSnapshot_->wrapVector(d);       
+      RealType diff = d[whichDirection];
+
+      lrPot += 0.5 * i->param.kz * diff * diff;
+      // for moving molecules fz holds the harmonic restraining force:
+      i->fz = -i->param.kz * diff;
+      sums[5] += i->fz;
+    }
+    currSnapshot_->setLongRangePotential(lrPot);
+
+#ifdef IS_MPI
+    MPI_Allreduce(MPI_IN_PLACE, sums, 6, MPI_REALTYPE, MPI_SUM,
+                  MPI_COMM_WORLD);
+#endif
+    totMassMovingZMols_ = sums[3];
+
+    if (sums[0] > 0.0) {
       zeroVelocity();    
-      calcTotalMassMovingZMols();
     }  
     
     //do zconstraint force; 
-    if (haveFixedZMols()){
-      doZconstraintForce();
+    if (sums[1] > 0.0) {
+      doZconstraintForce(sums[4]);
     }
 
     //use external force to move the molecules to the specified positions
-    if (haveMovingZMols()){
-      doHarmonic();
+    if (sums[2] > 0.0) {
+      doHarmonic(sums[5]);
     }
 
     //write out forces and current positions of z-constraint molecules    
     if (currSnapshot_->getTime() >= currZconsTime_){
-      std::list<ZconstraintMol>::iterator i;
-      Vector3d com;
-      for(i = fixedZMols_.begin(); i != fixedZMols_.end(); ++i) {
-	com = i->mol->getCom();
-	i->zpos = com[whichDirection];
-      }
-        
       fzOut->writeFZ(fixedZMols_);
       currZconsTime_ += zconsTime_;
     }
@@ -294,7 +335,7 @@ namespace OpenMD {
 
     Vector3d comVel;
     Vector3d vel;
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     Molecule* mol;
     StuntDouble* sd;
     Molecule::IntegrableObjectIterator ii;
@@ -322,16 +363,13 @@ namespace OpenMD {
     RealType pzMovingMols = 0.0;
     
     for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
-      mol = i->mol;        
-      comVel = mol->getComVel();
-      pzMovingMols +=  mol->getMass() * comVel[whichDirection];   
+      comVel = i->mol->getComVel();
+      pzMovingMols +=  i->mass * comVel[whichDirection];   
     }
 
-    std::vector<Molecule*>::iterator j;
-    for ( j = unzconsMols_.begin(); j !=  unzconsMols_.end(); ++j) {
-      mol =*j;
-      comVel = mol->getComVel();
-      pzMovingMols += mol->getMass() * comVel[whichDirection];
+    for (unsigned int j = 0; j < unzconsMols_.size(); ++j) {
+      comVel = unzconsMols_[j]->getComVel();
+      pzMovingMols += unzconsMass_[j] * comVel[whichDirection];
     }
     
 #ifdef IS_MPI
@@ -357,6 +395,7 @@ namespace OpenMD {
     }
 
     // Modify the velocites of unconstrained molecules
+    std::vector<Molecule*>::iterator j;
     for ( j = unzconsMols_.begin(); j !=  unzconsMols_.end(); ++j) {
 
       mol =*j;
@@ -372,45 +411,18 @@ namespace OpenMD {
   }
 
 
-  void ZconstraintForceManager::doZconstraintForce(){
-    RealType totalFZ; 
-    Vector3d com;
+  void ZconstraintForceManager::doZconstraintForce(RealType totalFZ){
     Vector3d force(0.0);
 
     // Constrain the molecules which have not reached the specified
-    // positions
+    // positions.  The per-molecule forces (fz) and their global sum
+    // (totalFZ) were gathered in calcForces.
 
-    // Zero out the forces of z-contrained molecules
-    totalFZ = 0.0;
-
-    // Calculate the total z-contrained force of the fixed
-    // z-contrained molecules
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     Molecule* mol;
     StuntDouble* sd;
     Molecule::IntegrableObjectIterator ii;
 
-    for ( i = fixedZMols_.begin(); i !=  fixedZMols_.end(); ++i) {
-
-      mol = i->mol;
-      i->fz = 0.0;
-
-      for( sd = mol->beginIntegrableObject(ii); sd != NULL; 
-           sd = mol->nextIntegrableObject(ii)) {
-        
-	force = sd->getFrc();    
-	i->fz += force[whichDirection]; 
-      }
-      totalFZ += i->fz;
-    }
-
-    //calculate total z-constraint force
-#ifdef IS_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &totalFZ, 1, 
-                  MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-
     // apply negative to fixed z-constrained molecues;
     for ( i = fixedZMols_.begin(); i !=  fixedZMols_.end(); ++i) {
 
@@ -419,7 +431,7 @@ namespace OpenMD {
       for(sd = mol->beginIntegrableObject(ii); sd != NULL; 
 	  sd = mol->nextIntegrableObject(ii)) {
 
-	force[whichDirection] = -getZFOfFixedZMols(mol, sd, i->fz);
+	force[whichDirection] = -getZFOfFixedZMols(*i, sd, i->fz);
 	sd->addFrc(force);
       }
     }
@@ -428,177 +440,127 @@ namespace OpenMD {
     for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
 
       mol = i->mol;
+      force[whichDirection] = -getZFOfMovingMols(i->mass, totalFZ);
 
       for(sd = mol->beginIntegrableObject(ii); sd != NULL; 
 	  sd = mol->nextIntegrableObject(ii)) {
-
-	force[whichDirection] = -getZFOfMovingMols(mol, totalFZ);
 	sd->addFrc(force);
       }
     }
 
     //modify the forces of unconstrained molecules
-    std::vector<Molecule*>::iterator j;
-    for ( j = unzconsMols_.begin(); j !=  unzconsMols_.end(); ++j) {
+    for (unsigned int j = 0; j < unzconsMols_.size(); ++j) {
 
-      mol = *j;
+      mol = unzconsMols_[j];
+      force[whichDirection] = -getZFOfMovingMols(unzconsMass_[j], totalFZ);
 
       for(sd = mol->beginIntegrableObject(ii); sd != NULL; 
 	  sd = mol->nextIntegrableObject(ii)) {
-
-	force[whichDirection] = -getZFOfMovingMols(mol, totalFZ);
 	sd->addFrc(force);
       }
     }
   }
 
 
-  void ZconstraintForceManager::doHarmonic(){
-    RealType totalFZ = 0.0;
+  void ZconstraintForceManager::doHarmonic(RealType totalFZ){
     Vector3d force(0.0);
-    Vector3d com;
-    RealType lrPot;
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     StuntDouble* sd;
     Molecule::IntegrableObjectIterator ii;
     Molecule* mol;
+
+    // The harmonic forces (fz) on the moving molecules, their global
+    // sum (totalFZ), and the restraint potential were computed in
+    // calcForces:
     for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
       mol = i->mol;
-      com = mol->getCom();   
-      RealType resPos = usingSMD_? i->cantPos : i->param.zTargetPos;
-      Vector3d d = com - Vector3d(0.0, 0.0, resPos);
-      info_->getSnapshotManager()->getCurrentSnapshot()->wrapVector(d);       
-
-      RealType diff = d[whichDirection];
-
-      RealType harmonicU = 0.5 * i->param.kz * diff * diff;
-      lrPot = currSnapshot_->getLongRangePotential();
-      lrPot += harmonicU;
-      currSnapshot_->setLongRangePotential(lrPot);
-      RealType harmonicF = -i->param.kz * diff;      
-      totalFZ += harmonicF;
 
       //adjust force
       for(sd = mol->beginIntegrableObject(ii); sd != NULL; 
 	  sd = mol->nextIntegrableObject(ii)) {
         
-	force[whichDirection] = getHFOfFixedZMols(mol, sd, harmonicF);
+	force[whichDirection] = getHFOfFixedZMols(*i, sd, i->fz);
 	sd->addFrc(force);            
       }
     }
 
-#ifdef IS_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &totalFZ, 1, MPI_REALTYPE, 
-                  MPI_SUM, MPI_COMM_WORLD);
-#endif
-    
     //modify the forces of unconstrained molecules
-    std::vector<Molecule*>::iterator j;
-    for ( j = unzconsMols_.begin(); j !=  unzconsMols_.end(); ++j) {
+    for (unsigned int j = 0; j < unzconsMols_.size(); ++j) {
 
-      mol = *j;
+      mol = unzconsMols_[j];
+      force[whichDirection] = getHFOfUnconsMols(unzconsMass_[j], totalFZ);
 
       for(sd = mol->beginIntegrableObject(ii); sd != NULL; 
 	  sd = mol->nextIntegrableObject(ii)) {
-
-	force[whichDirection] = getHFOfUnconsMols(mol, totalFZ);
 	sd->addFrc(force);            
       }
     }
   }
 
   bool ZconstraintForceManager::checkZConsState(){
-    Vector3d com;
-    RealType diff;
-    int changed = 0;
-
-    std::list<ZconstraintMol>::iterator i;
-    std::list<ZconstraintMol>::iterator j;
+    // Updates the cached center of mass of each local z-constrained
+    // molecule and moves molecules between the fixed and moving sets.
+    // Only local information is used; calcForces reduces the result.
+
+    bool changed = false;
+    std::vector<ZconstraintMol> newFixedZMols;
+    std::vector<ZconstraintMol> newMovingZMols;
+    std::vector<ZconstraintMol>::iterator i;
     
-    std::list<ZconstraintMol> newMovingZMols;
-    for ( i = fixedZMols_.begin(); i !=  fixedZMols_.end();) {
-      com = i->mol->getCom();
-      Vector3d d = com - Vector3d(0.0, 0.0, i->param.zTargetPos);
-      info_->getSnapshotManager()->getCurrentSnapshot()->wrapVector(d);       
-
-      RealType diff = fabs(d[whichDirection]);
+    for ( i = fixedZMols_.begin(); i !=  fixedZMols_.end(); ++i) {
+      i->com = i->mol->getCom();
+      i->zpos = i->com[whichDirection];
+      Vector3d d = i->com - Vector3d(0.0, 0.0, i->param.zTargetPos);
+      currSnapshot_->wrapVector(d);       
 
-      if (diff > zconsTol_) {
+      if (fabs(d[whichDirection]) > zconsTol_) {
 	if (usingZconsGap_) {
 	  i->endFixingTime = infiniteTime;
 	}
-	j = i++;
-	newMovingZMols.push_back(*j);
-	fixedZMols_.erase(j);
-	changed = 1;            
-      }else {
-	++i;
+	newMovingZMols.push_back(*i);
+	changed = true;
+      } else {
+        newFixedZMols.push_back(*i);
       }
     }  
 
-    std::list<ZconstraintMol> newFixedZMols;
-    for ( i = movingZMols_.begin(); i !=  movingZMols_.end();) {
-      com = i->mol->getCom();
-      Vector3d d = com - Vector3d(0.0, 0.0, i->param.zTargetPos);
-      info_->getSnapshotManager()->getCurrentSnapshot()->wrapVector(d);
-      diff = fabs(d[whichDirection]);
+    std::vector<ZconstraintMol> stillMoving;
+    for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
+      i->com = i->mol->getCom();
+      i->zpos = i->com[whichDirection];
+      Vector3d d = i->com - Vector3d(0.0, 0.0, i->param.zTargetPos);
+      currSnapshot_->wrapVector(d);
       
-      if (diff <= zconsTol_) {
+      if (fabs(d[whichDirection]) <= zconsTol_) {
 	if (usingZconsGap_) {
 	  i->endFixingTime = currSnapshot_->getTime() + zconsFixingTime_;
 	}
 	// This moving zconstraint molecule is now fixed
-	j = i++;
-	newFixedZMols.push_back(*j);
-	movingZMols_.erase(j);
-	changed = 1;            
-      }else {
-	++i;
+	newFixedZMols.push_back(*i);
+	changed = true;
+      } else {
+        stillMoving.push_back(*i);
       }
     }     
 
-    //merge the lists
-    fixedZMols_.insert(fixedZMols_.end(), newFixedZMols.begin(),
-                       newFixedZMols.end());
-    movingZMols_.insert(movingZMols_.end(), newMovingZMols.begin(),
-                        newMovingZMols.end());
-
-#ifdef IS_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-#endif
-
-    return (changed > 0);
-  }
+    if (changed) {
+      // preserve the ordering of the original lists: molecules that
+      // switched state are appended to the end of their new set.
+      stillMoving.insert(stillMoving.end(), newMovingZMols.begin(),
+                         newMovingZMols.end());
+      fixedZMols_.swap(newFixedZMols);
+      movingZMols_.swap(stillMoving);
+    }
 
-  bool ZconstraintForceManager::haveFixedZMols(){
-    int haveFixed = fixedZMols_.empty() ? 0 : 1;
-    
-#ifdef IS_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &haveFixed, 1, 
-                  MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-#endif
-    
-    return haveFixed > 0;
-  }
-  
-  
-  bool ZconstraintForceManager::haveMovingZMols(){
-    int haveMoving = movingZMols_.empty() ? 0 : 1;
-    
-#ifdef IS_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &haveMoving, 1, 
-                  MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-#endif
-    
-    return haveMoving > 0;
+    return changed;
   }
 
   void ZconstraintForceManager::calcTotalMassMovingZMols(){
 
     totMassMovingZMols_ = 0.0;
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
-      totMassMovingZMols_ += i->mol->getMass();
+      totMassMovingZMols_ += i->mass;
     }
     
 #ifdef IS_MPI
@@ -608,38 +570,37 @@ namespace OpenMD {
 
   }
 
-  RealType ZconstraintForceManager::getZFOfFixedZMols(Molecule* mol,
+  RealType ZconstraintForceManager::getZFOfFixedZMols(const ZconstraintMol& zmol,
                                                       StuntDouble* sd,
                                                       RealType totalForce){
-    return totalForce * sd->getMass() / mol->getMass();
+    return totalForce * sd->getMass() / zmol.mass;
   }
 
-  RealType ZconstraintForceManager::getZFOfMovingMols(Molecule* mol,
+  RealType ZconstraintForceManager::getZFOfMovingMols(RealType mass,
                                                       RealType totalForce){
-    return totalForce * mol->getMass() /
-      (totMassUnconsMols_ + totMassMovingZMols_);
+    return totalForce * mass / (totMassUnconsMols_ + totMassMovingZMols_);
   }
 
-  RealType ZconstraintForceManager::getHFOfFixedZMols(Molecule* mol,
+  RealType ZconstraintForceManager::getHFOfFixedZMols(const ZconstraintMol& zmol,
                                                       StuntDouble*sd,
                                                       RealType totalForce){
-    return totalForce * sd->getMass() / mol->getMass();
+    return totalForce * sd->getMass() / zmol.mass;
   }
 
-  RealType ZconstraintForceManager::getHFOfUnconsMols(Molecule* mol,
+  RealType ZconstraintForceManager::getHFOfUnconsMols(RealType mass,
                                                       RealType totalForce){
-    return totalForce * mol->getMass() / totMassUnconsMols_;
+    return totalForce * mass / totMassUnconsMols_;
   }
 
   void ZconstraintForceManager::updateZPos(){
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     for ( i = fixedZMols_.begin(); i !=  fixedZMols_.end(); ++i) {
       i->param.zTargetPos += zconsGap_;     
     }  
   }
 
   void ZconstraintForceManager::updateCantPos(){
-    std::list<ZconstraintMol>::iterator i;
+    std::vector<ZconstraintMol>::iterator i;
     for ( i = movingZMols_.begin(); i !=  movingZMols_.end(); ++i) {
       i->cantPos += i->param.cantVel * dt_;
     }
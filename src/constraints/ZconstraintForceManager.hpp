@@ -42,7 +42,6 @@
  
 #ifndef CONSTRAINTS_ZCONSTRAINTFORCEMANAGER_HPP
 #define CONSTRAINTS_ZCONSTRAINTFORCEMANAGER_HPP
-#include <list>
 #include <string>
 #include <vector>
 #include "brains/ForceManager.hpp"
@@ -56,6 +55,7 @@ namespace OpenMD {
     ~ZconstraintForceManager();
         
     virtual void calcForces();
+    virtual bool supportsForceGroups() { return false; }
 
     RealType getZConsTime() { return zconsTime_; }
     std::string getZConsOutput() { return zconsOutput_; }    
@@ -68,23 +68,24 @@ namespace OpenMD {
     void thermalize(void);
 
     void zeroVelocity();
-    void doZconstraintForce();
-    void doHarmonic();
+    void doZconstraintForce(RealType totalFZ);
+    void doHarmonic(RealType totalFZ);
     bool checkZConsState();        
     void updateZPos();
     void updateCantPos();
     void calcTotalMassMovingZMols();
-    bool haveMovingZMols();
-    bool haveFixedZMols();
     RealType getZTargetPos(int index);        
-    RealType getZFOfFixedZMols(Molecule* mol, StuntDouble* sd, RealType totalForce) ;
-    RealType getZFOfMovingMols(Molecule* mol, RealType totalForce) ;
-    RealType getHFOfFixedZMols(Molecule* mol, StuntDouble* sd, RealType totalForce);
-    RealType getHFOfUnconsMols(Molecule* mol, RealType totalForce);        
+    RealType getZFOfFixedZMols(const ZconstraintMol& zmol, StuntDouble* sd,
+                               RealType totalForce);
+    RealType getZFOfMovingMols(RealType mass, RealType totalForce);
+    RealType getHFOfFixedZMols(const ZconstraintMol& zmol, StuntDouble* sd,
+                               RealType totalForce);
+    RealType getHFOfUnconsMols(RealType mass, RealType totalForce);
 
-    std::list<ZconstraintMol> movingZMols_;/**<   moving zconstraint molecules*/
-    std::list<ZconstraintMol> fixedZMols_; /**< fixed zconstraint molecules*/
-    std::vector<Molecule*> unzconsMols_;   /**< free molecules*/
+    std::vector<ZconstraintMol> movingZMols_;/**< moving zconstraint molecules*/
+    std::vector<ZconstraintMol> fixedZMols_; /**< fixed zconstraint molecules*/
+    std::vector<Molecule*> unzconsMols_;     /**< free molecules*/
+    std::vector<RealType> unzconsMass_;      /**< masses of the free molecules */
 
     RealType zconsTime_;
     std::string zconsOutput_;
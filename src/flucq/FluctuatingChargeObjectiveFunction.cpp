@@ -55,7 +55,7 @@ namespace OpenMD{
   RealType FluctuatingChargeObjectiveFunction::value(const DynamicVector<RealType>& x) {
     
     setCoor(x);
-    forceMan_->calcForces();
+    forceMan_->calcChargeForces();
     fqConstraints_->applyConstraints();
     return thermo.getPotential();
   }
@@ -63,7 +63,7 @@ namespace OpenMD{
   void FluctuatingChargeObjectiveFunction::gradient(DynamicVector<RealType>& grad, const DynamicVector<RealType>& x) {
 
     setCoor(x);         
-    forceMan_->calcForces(); 
+    forceMan_->calcChargeForces();
     fqConstraints_->applyConstraints();
     getGrad(grad);
   }
@@ -72,7 +72,7 @@ namespace OpenMD{
                                                                 const DynamicVector<RealType>& x) {
 
     setCoor(x);
-    forceMan_->calcForces();
+    forceMan_->calcChargeForces();
     fqConstraints_->applyConstraints();    
     getGrad(grad); 
     return thermo.getPotential();
@@ -84,7 +84,9 @@ namespace OpenMD{
     Molecule* mol;
     Atom* atom;
 
-    info_->getSnapshotManager()->advance();
+    // the positions don't move during a charge optimization, so the
+    // current snapshot is reused rather than copied:
+    info_->getSnapshotManager()->getCurrentSnapshot()->clearDerivedProperties();
 
     int index;
 #ifdef IS_MPI
@@ -64,6 +64,12 @@ namespace OpenMD {
                                             "constrainRegions", false);
     DefineOptionalParameterWithDefaultValue(InitialStepSize, "initialStepSize",
                                             0.1);
+    // SD, CG and BFGS use the line search minimizers; Equilibrate
+    // uses a conjugate gradient solve with exact steps.  All of them
+    // stop when the relative change in the potential between
+    // iterations is below tolerance, or after maxIterations.
+    DefineOptionalParameterWithDefaultValue(OptimizationMethod,
+                                            "optimizationMethod", "SD");
   }
   
   FluctuatingChargeParameters::~FluctuatingChargeParameters() {    
@@ -88,6 +94,12 @@ namespace OpenMD {
     RealType one = 1.0;
     CheckParameter(InitialStepSize,
                    isGreaterThan(zero) && isLessThanOrEqualTo(one));
+    CheckParameter(OptimizationMethod,
+                   isEqualIgnoreCase("SD") ||
+                   isEqualIgnoreCase("CG") ||
+                   isEqualIgnoreCase("BFGS") ||
+                   isEqualIgnoreCase("Equilibrate")
+                   );
   }
   
 }
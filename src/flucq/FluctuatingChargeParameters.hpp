@@ -57,6 +57,7 @@ namespace OpenMD {
     DeclareParameter(DragCoefficient, RealType);
     DeclareParameter(ConstrainRegions, bool);
     DeclareParameter(InitialStepSize, RealType);
+    DeclareParameter(OptimizationMethod, std::string);
     
   public:
     FluctuatingChargeParameters();
@@ -47,6 +47,10 @@
 #include "optimization/EndCriteria.hpp"
 #include "optimization/StatusFunction.hpp"
 #include "optimization/OptimizationFactory.hpp"
+#include "utils/CaseConversion.hpp"
+#include "utils/simError.h"
+
+#include <limits>
 
 #ifdef IS_MPI
 #include <mpi.h>
@@ -102,6 +106,14 @@ namespace OpenMD {
 
 
     if (fqParams_->getDoInitialOptimization()) {
+
+      std::string method = toUpperCopy(fqParams_->getOptimizationMethod());
+
+      if (method == "EQUILIBRATE") {
+        equilibrateCharges();
+        initialized_ = true;
+        return;
+      }
     
       FluctuatingChargeObjectiveFunction flucQobjf(info_, forceMan_, 
                                                    fqConstraints_);
@@ -119,7 +131,7 @@ namespace OpenMD {
       EndCriteria endCriteria(maxIter, maxIter, tolerance, tolerance,
                               tolerance);
       
-      OptimizationMethod* minim = OptimizationFactory::getInstance()->createOptimization("SD", info_);
+      OptimizationMethod* minim = OptimizationFactory::getInstance()->createOptimization(method, info_);
       
       minim->minimize(problem, endCriteria, initialStepSize);
     }
@@ -127,6 +139,151 @@ namespace OpenMD {
     initialized_ = true;
   }
 
+  RealType FluctuatingChargePropagator::getChargeGradient(std::vector<Atom*>& atoms,
+                                                          std::vector<RealType>& grad) {
+    forceMan_->calcChargeForces();
+    fqConstraints_->applyConstraints();
+
+    RealType gg(0.0);
+    for (unsigned int i = 0; i < atoms.size(); i++) {
+      grad[i] = -atoms[i]->getFlucQFrc();
+      gg += grad[i] * grad[i];
+    }
+#ifdef IS_MPI
+    MPI_Allreduce(MPI_IN_PLACE, &gg, 1, MPI_REALTYPE, MPI_SUM,
+                  MPI_COMM_WORLD);
+#endif
+    return gg;
+  }
+
+  void FluctuatingChargePropagator::equilibrateCharges() {
+    SimInfo::MoleculeIterator i;
+    Molecule::FluctuatingChargeIterator  j;
+    Molecule* mol;
+    Atom* atom;
+
+    std::vector<Atom*> atoms;
+    for (mol = info_->beginMolecule(i); mol != NULL; 
+         mol = info_->nextMolecule(i)) {
+      for (atom = mol->beginFluctuatingCharge(j); atom != NULL;
+           atom = mol->nextFluctuatingCharge(j)) {
+        atoms.push_back(atom);
+      }
+    }
+
+    unsigned int n = atoms.size();
+    int maxIter = fqParams_->getMaxIterations();
+    RealType tolerance = fqParams_->getTolerance();
+    // the largest charge displacement used to probe the curvature:
+    const RealType probe = 0.01;
+
+    std::vector<RealType> q(n), g(n), gNew(n), p(n);
+    for (unsigned int k = 0; k < n; k++) 
+      q[k] = atoms[k]->getFlucQPos();
+
+    Snapshot* snap = info_->getSnapshotManager()->getCurrentSnapshot();
+    Thermo thermo(info_);
+
+    // the gradients have already been projected onto the charge
+    // constraints, so the search directions never violate them:
+    RealType gg = getChargeGradient(atoms, g);
+    RealType fOld = thermo.getPotential();
+    for (unsigned int k = 0; k < n; k++) p[k] = -g[k];
+
+    // same exit strategy as the line search minimizers: stop when the
+    // relative change in the energy falls below the tolerance
+    bool converged = false;
+    int iter = 0;
+    while (!converged && iter < maxIter) {
+
+      RealType pmax(0.0);
+      for (unsigned int k = 0; k < n; k++) pmax = max(pmax, fabs(p[k]));
+#ifdef IS_MPI
+      MPI_Allreduce(MPI_IN_PLACE, &pmax, 1, MPI_REALTYPE, MPI_MAX,
+                    MPI_COMM_WORLD);
+#endif
+      if (pmax == 0.0) {
+        converged = true;
+        break;
+      }
+      RealType sigma = probe / pmax;
+
+      // curvature along p from the change in the gradient over a
+      // small step:
+      for (unsigned int k = 0; k < n; k++) 
+        atoms[k]->setFlucQPos(q[k] + sigma * p[k]);
+      snap->clearDerivedProperties();
+      getChargeGradient(atoms, gNew);
+
+      RealType gp(0.0), pHp(0.0);
+      for (unsigned int k = 0; k < n; k++) {
+        gp += g[k] * p[k];
+        pHp += p[k] * (gNew[k] - g[k]);
+      }
+#ifdef IS_MPI
+      RealType sums[2] = {gp, pHp};
+      MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_REALTYPE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      gp = sums[0];
+      pHp = sums[1];
+#endif
+      pHp /= sigma;
+
+      if (pHp <= 0.0) {
+        sprintf(painCave.errMsg,
+                "FluctuatingChargePropagator: the charge energy is not\n"
+                "\tconvex along the search direction, so the charge\n"
+                "\tequilibration stopped after %d iterations.\n", iter);
+        painCave.isFatal = 0;
+        painCave.severity = OPENMD_WARNING;
+        simError();
+        for (unsigned int k = 0; k < n; k++) atoms[k]->setFlucQPos(q[k]);
+        break;
+      }
+
+      RealType alpha = -gp / pHp;
+      for (unsigned int k = 0; k < n; k++) {
+        q[k] += alpha * p[k];
+        atoms[k]->setFlucQPos(q[k]);
+      }
+      snap->clearDerivedProperties();
+      RealType ggNew = getChargeGradient(atoms, gNew);
+      RealType fNew = thermo.getPotential();
+
+      // Polak-Ribiere, restarting with steepest descent when needed:
+      RealType gdg(0.0);
+      for (unsigned int k = 0; k < n; k++) gdg += gNew[k] * (gNew[k] - g[k]);
+#ifdef IS_MPI
+      MPI_Allreduce(MPI_IN_PLACE, &gdg, 1, MPI_REALTYPE, MPI_SUM,
+                    MPI_COMM_WORLD);
+#endif
+      RealType beta = max(RealType(0.0), gdg / gg);
+      
+      for (unsigned int k = 0; k < n; k++) {
+        p[k] = -gNew[k] + beta * p[k];
+        g[k] = gNew[k];
+      }
+      gg = ggNew;
+      iter++;
+
+      RealType fdiff = 2.0 * fabs(fNew - fOld) /
+        (fabs(fNew) + fabs(fOld) + std::numeric_limits<RealType>::epsilon());
+      converged = (fdiff < tolerance);
+      fOld = fNew;
+    }
+
+    if (!converged) {
+      sprintf(painCave.errMsg,
+              "FluctuatingChargePropagator: charge equilibration did not\n"
+              "\tconverge in %d iterations.\n", iter);
+      painCave.isFatal = 0;
+      painCave.severity = OPENMD_WARNING;
+      simError();
+    }
+
+    snap->clearDerivedProperties();
+  }
+
   void FluctuatingChargePropagator::applyConstraints() {
     if (!initialized_) initialize();
     if (!hasFlucQ_) return;
@@ -70,6 +70,17 @@ namespace OpenMD {
     virtual void setForceManager(ForceManager* forceMan);
 
   protected:
+    /**
+     * Minimizes the electrostatic energy with respect to the
+     * fluctuating charges by a projected conjugate gradient descent.
+     * Curvatures along each search direction come from one extra
+     * charge-only force evaluation, so each iteration costs two
+     * charge-force calls and no line search.
+     */
+    void equilibrateCharges();
+    RealType getChargeGradient(std::vector<Atom*>& atoms,
+                               std::vector<RealType>& grad);
+    
     FluctuatingChargeParameters* fqParams_;
     FluctuatingChargeConstraints* fqConstraints_;
     SimInfo* info_;
@@ -41,14 +41,39 @@
  */
  
 #include "DLM.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMD {
 
   void DLM::doRotate(StuntDouble* sd, Vector3d& ji, RealType dt) {
+    RotMat3x3d A = sd->getA();
+    propagate(sd, A, ji, dt);
+    sd->setA( A  );
+  }
+
+  void DLM::doRotateBatch(std::vector<StuntDouble*>& sds, RealType dt) {
+    int n = sds.size();
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+      StuntDouble* sd = sds[i];
+      RotMat3x3d A = sd->getA();
+      Vector3d ji = sd->getJ();
+
+      propagate(sd, A, ji, dt);
+
+      sd->setA(A);
+      sd->setJ(ji);
+    }
+  }
+
+  void DLM::propagate(StuntDouble* sd, RotMat3x3d& A, Vector3d& ji,
+                      RealType dt) {
     RealType dt2 = 0.5 * dt;    
     RealType angle;
 
-    RotMat3x3d A = sd->getA();
     Mat3x3d I = sd->getI();
 
     // use the angular velocities to propagate the rotation matrix a full time step
@@ -89,8 +114,6 @@ namespace OpenMD {
       rotateStep( 1, 2, angle, ji, A );
 
     }
-
-    sd->setA( A  );
   }
 
 
@@ -101,11 +124,7 @@ namespace OpenMD {
     RealType angleSqr;
     RealType angleSqrOver4;
     RealType top, bottom;
-
-    RotMat3x3d tempA(A);  // initialize the tempA
-    Vector3d tempJ(0.0);
-
-    RotMat3x3d rot = RotMat3x3d::identity(); // initalize rot as a unit matrix
+    RealType a1, a2;
 
     // use a small angle aproximation for sin and cosine
 
@@ -120,14 +139,17 @@ namespace OpenMD {
     // or don't use the small angle approximation:
     //cosAngle = cos(angle);
     //sinAngle = sin(angle);
-    rot(axes1, axes1) = cosAngle;
-    rot(axes2, axes2) = cosAngle;
 
-    rot(axes1, axes2) = sinAngle;
-    rot(axes2, axes1) = -sinAngle;
+    // rot is the identity except in the (axes1, axes2) plane:
+    //   rot(axes1, axes1) = rot(axes2, axes2) = cosAngle
+    //   rot(axes1, axes2) = -rot(axes2, axes1) = sinAngle
+    // so only two components of ji and two rows of A ever change.
 
     // rotate the momentum acoording to: ji[] = rot[][] * ji[]
-    ji = rot * ji;
+    a1 = ji[axes1];
+    a2 = ji[axes2];
+    ji[axes1] =  cosAngle * a1 + sinAngle * a2;
+    ji[axes2] = -sinAngle * a1 + cosAngle * a2;
 
     // This code comes from converting an algorithm detailed in 
     // J. Chem. Phys. 107 (15), pp. 5840-5851 by Dullweber, 
@@ -147,9 +169,15 @@ namespace OpenMD {
     // So, using the identity:
     //  (A * B).transpose() = B.transpose() * A.transpose(),  we
     // get the equivalent of Q = Q * rot.transpose() for our code to be:
+    //
+    //  A = rot * A
 
-    A = rot * A;
-  
+    for (int k = 0; k < 3; k++) {
+      a1 = A(axes1, k);
+      a2 = A(axes2, k);
+      A(axes1, k) =  cosAngle * a1 + sinAngle * a2;
+      A(axes2, k) = -sinAngle * a1 + cosAngle * a2;
+    }
   }
 
 
@@ -49,13 +49,20 @@ namespace OpenMD {
 
   /**
    * @class DLM
-   * @brief 
-   * @todo document
+   * @brief Symplectic splitting propagator for rotations by
+   * Dullweber, Leimkuhler and McLachlan (J. Chem. Phys. 107, 5840 (1997)).
+   *
+   * Batches of objects are propagated in parallel (with OpenMP when
+   * it is available) since each object is rotated independently.
    */
   class DLM : public RotationAlgorithm {
   private:
     virtual void doRotate(StuntDouble* sd, Vector3d& ji, RealType dt); 
-    void rotateStep(int axes1, int axes2, RealType angle, Vector3d& ji, RotMat3x3d& A);            
+    virtual void doRotateBatch(std::vector<StuntDouble*>& sds, RealType dt);
+    static void propagate(StuntDouble* sd, RotMat3x3d& A, Vector3d& ji,
+                          RealType dt);
+    static void rotateStep(int axes1, int axes2, RealType angle, Vector3d& ji,
+                           RotMat3x3d& A);
   };
 
 }
@@ -47,6 +47,7 @@
 #include "brains/Snapshot.hpp"
 #include "integrators/Integrator.hpp"
 #include "integrators/DLM.hpp"
+#include "integrators/QuaternionDLM.hpp"
 #include "flucq/FluctuatingChargeDamped.hpp"
 #include "flucq/FluctuatingChargeLangevin.hpp"
 #include "flucq/FluctuatingChargeNVE.hpp"
@@ -154,7 +155,11 @@ namespace OpenMD {
       }
     }
     
-    rotAlgo_ = new DLM();
+    std::string rotProp = toUpperCopy(simParams->getRotationPropagator());
+    if (rotProp.compare("QDLM") == 0)
+      rotAlgo_ = new QuaternionDLM();
+    else
+      rotAlgo_ = new DLM();
     rattle_ = new Rattle(info);
     
     if (simParams->getFluctuatingChargeParameters()->havePropagator()) {
@@ -120,6 +120,7 @@ namespace OpenMD {
     Globals* simParams;
     ForceManager* forceMan_;
     RotationAlgorithm* rotAlgo_;
+    std::vector<StuntDouble*> rotatables_; /**< directional objects rotated in moveA */
     FluctuatingChargePropagator* flucQ_;
     Rattle* rattle_;
     Velocitizer* velocitizer_;
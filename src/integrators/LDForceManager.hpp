@@ -71,6 +71,7 @@ namespace OpenMD {
     
   public:
     LDForceManager(SimInfo * info);
+    virtual bool supportsForceGroups() { return false; }
     
     int getMaxIterationNumber() {
       return maxIterNum_;
@@ -74,6 +74,8 @@ namespace OpenMD {
     Vector3d ji;
     RealType mass;
     
+    rotatables_.clear();
+
     for (mol = info_->beginMolecule(i); mol != NULL; 
          mol = info_->nextMolecule(i)) {
 
@@ -106,15 +108,17 @@ namespace OpenMD {
 
 	  ji += (dt2  * Constants::energyConvert) * Tb;
 
-	  rotAlgo_->rotate(sd, ji, dt);
-
 	  sd->setJ(ji);
+	  rotatables_.push_back(sd);
 	}
 
             
       }
     } //end for(mol = info_->beginMolecule(i))
     
+    // propagate the rotations of all of the directional objects at once
+    rotAlgo_->rotate(rotatables_, dt);
+
     flucQ_->moveA();
     rattle_->constraintA();    
   }    
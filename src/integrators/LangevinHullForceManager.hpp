@@ -67,6 +67,7 @@ namespace OpenMD {
   public:
     LangevinHullForceManager(SimInfo * info);
     virtual ~LangevinHullForceManager();
+    virtual bool supportsForceGroups() { return false; }
     
   protected:
     virtual void postCalculation();
@@ -78,6 +78,8 @@ namespace OpenMD {
 
     calcVelScale();
 
+    rotatables_.clear();
+
     for (mol = info_->beginMolecule(i); mol != NULL; 
          mol = info_->nextMolecule(i)) {
 
@@ -109,12 +111,14 @@ namespace OpenMD {
 	  ji += dt2*Constants::energyConvert * Tb 
             - dt2*thermostat.first* ji;
           
-	  rotAlgo_->rotate(sd, ji, dt);
-          
 	  sd->setJ(ji);
+	  rotatables_.push_back(sd);
 	}            
       }
     }
+    // propagate the rotations of all of the directional objects at once
+    rotAlgo_->rotate(rotatables_, dt);
+
     // evolve eta a half step
     
     evolveEtaA();    
@@ -159,6 +159,8 @@ namespace OpenMD {
 
     calcVelScale();
 
+    rotatables_.clear();
+
     for (mol = info_->beginMolecule(i); mol != NULL; 
          mol = info_->nextMolecule(i)) {
 
@@ -190,13 +192,15 @@ namespace OpenMD {
 	  ji += dt2*Constants::energyConvert * Tb 
             - dt2*thermostat.first* ji;
                 
-	  rotAlgo_->rotate(sd, ji, dt);
-
 	  sd->setJ(ji);
+	  rotatables_.push_back(sd);
 	}
             
       }
     }
+    // propagate the rotations of all of the directional objects at once
+    rotAlgo_->rotate(rotatables_, dt);
+
     // evolve chi and eta  half step
 
     thermostat.first += dt2 * (instaTemp / targetTemp - 1.0) / tt2;
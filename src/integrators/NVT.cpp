@@ -105,6 +105,8 @@ namespace OpenMD {
 
     RealType instTemp = thermo.getTemperature();
 
+    rotatables_.clear();
+
     for (mol = info_->beginMolecule(i); mol != NULL; 
          mol = info_->nextMolecule(i)) {
 
@@ -139,14 +141,16 @@ namespace OpenMD {
 	  ji += dt2*Constants::energyConvert*Tb 
             - dt2*thermostat.first *ji;
 
-	  rotAlgo_->rotate(sd, ji, dt);
-
 	  sd->setJ(ji);
+	  rotatables_.push_back(sd);
         }
       }
       
     }
     
+    // propagate the rotations of all of the directional objects at once
+    rotAlgo_->rotate(rotatables_, dt);
+
     flucQ_->moveA();
     rattle_->constraintA();
 
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2014 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2014).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#include "integrators/QuaternionDLM.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMD {
+
+  void QuaternionDLM::doRotate(StuntDouble* sd, Vector3d& ji, RealType dt) {
+    RotMat3x3d A = sd->getA();
+    propagate(sd, A, ji, dt);
+    sd->setA(A);
+  }
+
+  void QuaternionDLM::doRotateBatch(std::vector<StuntDouble*>& sds,
+                                    RealType dt) {
+    int n = sds.size();
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; i++) {
+      StuntDouble* sd = sds[i];
+      RotMat3x3d A = sd->getA();
+      Vector3d ji = sd->getJ();
+
+      propagate(sd, A, ji, dt);
+
+      sd->setA(A);
+      sd->setJ(ji);
+    }
+  }
+
+  void QuaternionDLM::propagate(StuntDouble* sd, RotMat3x3d& A, Vector3d& ji,
+                                RealType dt) {
+    RealType dt2 = 0.5 * dt;    
+    RealType angle;
+
+    Mat3x3d I = sd->getI();
+    Quat4d q = A.toQuaternion();
+
+    if (sd->isLinear()) {
+
+      int i = sd->linearAxis();
+      int j = (i+1)%3;
+      int k = (i+2)%3;
+
+      angle = dt2 * ji[j] / I(j, j);
+      rotateStep( k, i, angle, ji, q );
+
+      angle = dt * ji[k] / I(k, k);
+      rotateStep( i, j, angle, ji, q );
+
+      angle = dt2 * ji[j] / I(j, j);
+      rotateStep( k, i, angle, ji, q );
+
+    } else {
+
+      angle = dt2 * ji[0] / I(0, 0);
+      rotateStep( 1, 2, angle, ji, q );
+
+      angle = dt2 * ji[1] / I(1, 1);
+      rotateStep( 2, 0, angle, ji, q );
+
+      angle = dt * ji[2] / I(2, 2);
+      rotateStep( 0, 1, angle, ji, q );
+
+      angle = dt2 * ji[1] / I(1, 1);
+      rotateStep( 2, 0, angle, ji, q );
+
+      angle = dt2 * ji[0] / I(0, 0);
+      rotateStep( 1, 2, angle, ji, q );
+    }
+
+    q.normalize();
+    A.setupRotMat(q);
+  }
+
+  void QuaternionDLM::rotateStep(int axes1, int axes2, RealType angle,
+                                 Vector3d& ji, Quat4d& q) {
+    RealType angleSqrOver4 = 0.25 * angle * angle;
+    RealType bottom = 1.0 + angleSqrOver4;
+    RealType cosAngle = (1.0 - angleSqrOver4) / bottom;
+    RealType sinAngle = angle / bottom;
+    RealType a1, a2;
+
+    // the momentum is rotated exactly as in DLM::rotateStep:
+    a1 = ji[axes1];
+    a2 = ji[axes2];
+    ji[axes1] =  cosAngle * a1 + sinAngle * a2;
+    ji[axes2] = -sinAngle * a1 + cosAngle * a2;
+
+    // The small angle (Cayley) form of the rotation above turns by
+    // phi with tan(phi/2) = angle/2, so the half-angle terms of the
+    // matching quaternion follow directly.  (axes1, axes2) is always
+    // a cyclic pair, so the rotation axis is the remaining one.  In
+    // OpenMD's convention the matrix of (q * r) is mat(r) * mat(q),
+    // so A = rot * A becomes q = q * r:
+
+    RealType norm = 1.0 / sqrt(bottom);
+    Quat4d r(norm, 0.0, 0.0, 0.0);
+    r[3 - axes1 - axes2 + 1] = 0.5 * angle * norm;
+
+    q *= r;
+  }
+
+}
@@ -43,6 +43,7 @@
 #ifndef INTEGRATORS_ROTATIONALGORITHM_HPP
 #define INTEGRATORS_ROTATIONALGORITHM_HPP
 
+#include <vector>
 #include "primitives/StuntDouble.hpp"
 #include "math/Vector3.hpp"
 
@@ -58,9 +59,28 @@ namespace OpenMD {
     void rotate(StuntDouble* sd, Vector3d& ji,  RealType dt) {
       doRotate(sd, ji, dt);
     }
+
+    /**
+     * Rotates a batch of directional objects by a full time step.
+     * The angular momenta are read from (and written back to) the
+     * current snapshot, so callers must call setJ on each object
+     * before handing the batch over.
+     */
+    void rotate(std::vector<StuntDouble*>& sds, RealType dt) {
+      doRotateBatch(sds, dt);
+    }
   private:
     virtual void doRotate(StuntDouble* sd, Vector3d& ji,  RealType dt) = 0;
 
+    virtual void doRotateBatch(std::vector<StuntDouble*>& sds, RealType dt) {
+      Vector3d ji;
+      for (std::size_t i = 0; i < sds.size(); ++i) {
+        ji = sds[i]->getJ();
+        doRotate(sds[i], ji, dt);
+        sds[i]->setJ(ji);
+      }
+    }
+
   };
 
 }
@@ -44,15 +44,145 @@
  */
 
 #include "integrators/VelocityVerletIntegrator.hpp"
+#include "primitives/Molecule.hpp"
+#include "utils/simError.h"
 
 namespace OpenMD {
   VelocityVerletIntegrator::VelocityVerletIntegrator(SimInfo *info)
-    : Integrator(info) { 
+    : Integrator(info), respaStep_(0) { 
+
+    pairSteps_ = simParams->getRespaPairSteps();
+    reciprocalSteps_ = pairSteps_;
+    if (simParams->haveRespaReciprocalSteps())
+      reciprocalSteps_ = simParams->getRespaReciprocalSteps();
+
+    if (reciprocalSteps_ % pairSteps_ != 0) {
+      sprintf(painCave.errMsg,
+              "VelocityVerletIntegrator: respaReciprocalSteps (%d) must be\n"
+              "\ta multiple of respaPairSteps (%d).\n",
+              reciprocalSteps_, pairSteps_);
+      painCave.isFatal = 1;
+      painCave.severity = OPENMD_ERROR;
+      simError();
+    }
+  }
+
+  void VelocityVerletIntegrator::initialize() {
+    if (reciprocalSteps_ > 1) {
+      if (!forceMan_->supportsForceGroups()) {
+        sprintf(painCave.errMsg,
+                "VelocityVerletIntegrator: Multiple time step integration\n"
+                "\t(respaPairSteps or respaReciprocalSteps > 1) can't be\n"
+                "\tcombined with restraints, z-constraints, thermodynamic\n"
+                "\tintegration, or Langevin force managers.\n");
+        painCave.isFatal = 1;
+        painCave.severity = OPENMD_ERROR;
+        simError();
+      }
+      if (info_->usesFluctuatingCharges()) {
+        sprintf(painCave.errMsg,
+                "VelocityVerletIntegrator: Multiple time step integration\n"
+                "\tis not available with fluctuating charges.\n");
+        painCave.isFatal = 1;
+        painCave.severity = OPENMD_ERROR;
+        simError();
+      }
+
+      sprintf(painCave.errMsg,
+              "VelocityVerletIntegrator: Using r-RESPA with a %g fs inner\n"
+              "\tstep.  The pair loop is evaluated every %d steps, and\n"
+              "\treciprocal-space terms every %d steps.\n",
+              dt, pairSteps_, reciprocalSteps_);
+      painCave.isFatal = 0;
+      painCave.severity = OPENMD_INFO;
+      simError();
+      painCave.severity = OPENMD_ERROR;
+    }
+    Integrator::initialize();
   }
 
   void VelocityVerletIntegrator::step() {
     moveA();
+    ++respaStep_;
     calcForce();
     moveB();
   }
+
+  void VelocityVerletIntegrator::calcForce() {
+    if (reciprocalSteps_ == 1) {
+      Integrator::calcForce();
+      return;
+    }
+
+    bool pairDue = (respaStep_ % pairSteps_ == 0);
+    bool reciprocalDue = (respaStep_ % reciprocalSteps_ == 0);
+
+    if (pairDue || reciprocalDue) {
+      impulseFrc_.assign(info_->getNIntegrableObjects(), V3Zero);
+      impulseTrq_.assign(info_->getNIntegrableObjects(), V3Zero);
+    }
+
+    if (reciprocalDue && reciprocalSteps_ == pairSteps_) {
+      addGroupImpulse(PAIR_FORCE_GROUP | RECIPROCAL_FORCE_GROUP,
+                      RealType(pairSteps_));
+    } else {
+      if (reciprocalDue)
+        addGroupImpulse(RECIPROCAL_FORCE_GROUP, RealType(reciprocalSteps_));
+      if (pairDue)
+        addGroupImpulse(PAIR_FORCE_GROUP, RealType(pairSteps_));
+    }
+
+    // The bonded group is evaluated last so that its potentials and
+    // the carried-over pair virial end up in the snapshot together.
+    forceMan_->setForceGroups(BONDED_FORCE_GROUP);
+    forceMan_->calcForces();
+    forceMan_->setForceGroups(ALL_FORCE_GROUPS);
+
+    if (pairDue || reciprocalDue) {
+      SimInfo::MoleculeIterator i;
+      Molecule::IntegrableObjectIterator j;
+      Molecule* mol;
+      StuntDouble* sd;
+      int index = 0;
+
+      for (mol = info_->beginMolecule(i); mol != NULL;
+           mol = info_->nextMolecule(i)) {
+        for (sd = mol->beginIntegrableObject(j); sd != NULL;
+             sd = mol->nextIntegrableObject(j)) {
+          sd->addFrc(impulseFrc_[index]);
+          if (sd->isDirectional())
+            sd->addTrq(impulseTrq_[index]);
+          ++index;
+        }
+      }
+    }
+
+    flucQ_->applyConstraints();
+  }
+
+  /**
+   * Evaluates one force group on its own and accumulates the scaled
+   * forces and torques on the integrable objects.
+   */
+  void VelocityVerletIntegrator::addGroupImpulse(int group, RealType scale) {
+    SimInfo::MoleculeIterator i;
+    Molecule::IntegrableObjectIterator j;
+    Molecule* mol;
+    StuntDouble* sd;
+    int index = 0;
+
+    forceMan_->setForceGroups(group);
+    forceMan_->calcForces();
+
+    for (mol = info_->beginMolecule(i); mol != NULL;
+         mol = info_->nextMolecule(i)) {
+      for (sd = mol->beginIntegrableObject(j); sd != NULL;
+           sd = mol->nextIntegrableObject(j)) {
+        impulseFrc_[index] += scale * sd->getFrc();
+        if (sd->isDirectional())
+          impulseTrq_[index] += scale * sd->getTrq();
+        ++index;
+      }
+    }
+  }
 } //End OpenMD
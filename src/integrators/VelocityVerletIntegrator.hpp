@@ -50,17 +50,42 @@
 
 namespace OpenMD {
 
+  /**
+   * @brief Velocity Verlet integrators, with optional r-RESPA
+   * multiple time stepping.
+   *
+   * When respaPairSteps (k) or respaReciprocalSteps (m) are larger
+   * than 1, dt is the inner time step used for the bonded forces.
+   * The cutoff pair loop is evaluated every k steps and the
+   * reciprocal-space and surface terms every m steps (m must be a
+   * multiple of k).  The slow forces are applied as impulses: on the
+   * steps where they are evaluated, they are scaled by their interval
+   * and added to the bonded forces used in moveB and in the following
+   * moveA, which reproduces the half kicks of the outer RESPA levels.
+   * Thermostats and barostats in moveA and moveB are propagated with
+   * the inner time step.
+   */
   class VelocityVerletIntegrator : public Integrator {
 
   protected:
 
     VelocityVerletIntegrator(SimInfo* info);
+    virtual void initialize();
     virtual void step();
+    virtual void calcForce();
         
   private:
         
     virtual void moveA() = 0;
     virtual void moveB() = 0;
+
+    void addGroupImpulse(int group, RealType scale);
+
+    int pairSteps_;        /**< inner steps between pair loop evaluations */
+    int reciprocalSteps_;  /**< inner steps between reciprocal evaluations */
+    int respaStep_;        /**< inner steps taken so far */
+    std::vector<Vector3d> impulseFrc_;
+    std::vector<Vector3d> impulseTrq_;
   };
 
 } //end namespace OpenMD
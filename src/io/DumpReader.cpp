@@ -49,6 +49,10 @@
  
 #include <sys/types.h> 
 #include <sys/stat.h> 
+#ifndef _MSC_VER
+#include <fcntl.h>
+#include <unistd.h>
+#endif
  
 #include <iostream> 
 #include <cmath> 
@@ -69,7 +73,7 @@ namespace OpenMD {
    
   DumpReader::DumpReader(SimInfo* info, const std::string& filename) 
     : info_(info), filename_(filename), isScanned_(false), nframes_(0),
-      needCOMprops_(false) { 
+      needCOMprops_(false), rbBatch_(NULL), prefetchFd_(-1) { 
     
 #ifdef IS_MPI     
     if (worldRank == 0) { 
@@ -96,12 +100,17 @@ namespace OpenMD {
   } 
   
   DumpReader::~DumpReader() { 
+
+    delete rbBatch_;
     
 #ifdef IS_MPI     
     if (worldRank == 0) { 
 #endif
 
       delete inFile_; 
+#ifndef _MSC_VER
+      if (prefetchFd_ >= 0) close(prefetchFd_);
+#endif
       
 #ifdef IS_MPI       
     }     
@@ -112,6 +121,40 @@ namespace OpenMD {
     return; 
   } 
   
+  void DumpReader::prefetchFrames(int first, int last) {
+#if !defined(_MSC_VER) && defined(POSIX_FADV_WILLNEED)
+#ifdef IS_MPI
+    if (worldRank != 0) return;
+#endif
+    if (!isScanned_) scanFile();
+    if (first < 0 || first >= last || first >= nframes_) return;
+
+    if (prefetchFd_ < 0) {
+      prefetchFd_ = open(filename_.c_str(), O_RDONLY);
+      if (prefetchFd_ < 0) return;
+    }
+
+    // The kernel reads the range in the background; a length of
+    // zero means "to the end of the file".
+    off_t begin = framePos_[first];
+    off_t length = (last < nframes_) ? off_t(framePos_[last]) - begin : 0;
+    posix_fadvise(prefetchFd_, begin, length, POSIX_FADV_WILLNEED);
+#endif
+  }
+
+  const std::vector<std::streampos>& DumpReader::getFrameIndex() {
+    if (!isScanned_)
+      scanFile();
+
+    return framePos_;
+  }
+
+  void DumpReader::setFrameIndex(const std::vector<std::streampos>& framePos) {
+    framePos_ = framePos;
+    nframes_ = framePos_.size();
+    isScanned_ = true;
+  }
+
   int DumpReader::getNFrames(void) { 
      
     if (!isScanned_) 
@@ -316,6 +359,17 @@ namespace OpenMD {
     //read StuntDoubles
     int nSD = readStuntDoubles(inputStream);     
 
+    // This should let us use various atom-based selections even if
+    // we have only rigid bodies:
+    if (info_->getNRigidBodies() > 0 && (needPos_ || needVel_)) {
+      if (rbBatch_ == NULL) {
+        rbBatch_ = new RigidBodyBatch(info_);
+        rbBatch_->build();
+      }
+      if (needPos_) rbBatch_->updateAtoms();
+      if (needVel_) rbBatch_->updateAtomVel();
+    }
+
     inputStream.getline(buffer, bufferSize);
     line = buffer;
 
@@ -543,17 +597,6 @@ namespace OpenMD {
 
       }      
     }
-    if (sd->isRigidBody()) {
-      RigidBody* rb = static_cast<RigidBody*>(sd);
-      if (needPos_) {
-        // This should let us use various atom-based selections even
-        // if we have only rigid bodies:
-        rb->updateAtoms();
-      }
-      if (needVel_) {
-        rb->updateAtomVel();
-      }
-    }    
   } 
    
 
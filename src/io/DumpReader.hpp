@@ -54,6 +54,7 @@
 #include <string> 
 #include "brains/SimInfo.hpp" 
 #include "primitives/StuntDouble.hpp" 
+#include "brains/RigidBodyBatch.hpp"
 namespace OpenMD { 
  
   /** 
@@ -77,6 +78,27 @@ namespace OpenMD {
          
     virtual void readFrame(int whichFrame); 
  
+    /**
+     * Asks the operating system to start reading frames [first,
+     * last) into the page cache, so that a later readFrame of those
+     * frames doesn't wait on the disk.  Does nothing on platforms
+     * without posix_fadvise.
+     */
+    void prefetchFrames(int first, int last);
+
+    /**
+     * Returns the offsets of the frames in the dump file, scanning
+     * the file first if that hasn't been done yet.
+     */
+    const std::vector<std::streampos>& getFrameIndex();
+
+    /**
+     * Adopts a frame index built by another DumpReader of the same
+     * file, so that readers created for worker threads don't each
+     * have to scan the whole file again.
+     */
+    void setFrameIndex(const std::vector<std::streampos>& framePos);
+ 
   protected: 
  
     void scanFile();  
@@ -104,6 +126,10 @@ namespace OpenMD {
     bool needAngMom_;
     bool needCOMprops_;
 
+    RigidBodyBatch* rbBatch_; /**< places rigid body members after each read */
+
+    int prefetchFd_;  /**< descriptor used only for read-ahead hints */
+
     const static int bufferSize = 4096;
     char buffer[bufferSize];
   }; 
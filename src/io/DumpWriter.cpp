@@ -786,6 +786,16 @@ namespace OpenMD {
     writeFrame(*dumpFile_);
   }
 
+  void DumpWriter::writeFormattedFrame(const std::string& frame) {
+#ifdef IS_MPI
+    if (worldRank == 0) {
+#endif // is_mpi
+      (*dumpFile_) << frame;
+#ifdef IS_MPI
+    }
+#endif // is_mpi
+  }
+
   void DumpWriter::writeEor() {
 
     std::ostream* eorStream = NULL;
@@ -78,10 +78,20 @@ namespace OpenMD {
     void writeDumpAndEor();
     void writeDump();
     void writeEor();
+
+    /**
+     * Formats the current frame into os rather than the dump file.
+     * Tools which convert frames on several threads use this to
+     * format frames concurrently and writeFormattedFrame to append
+     * them to the dump file in order.
+     */
+    void writeFrame(std::ostream& os);
+
+    /** Appends a frame formatted by writeFrame to the dump file. */
+    void writeFormattedFrame(const std::string& frame);
     
   private:  
         
-    void writeFrame(std::ostream& os);
     void writeFrameProperties(std::ostream& os, Snapshot* s);
     std::string prepareDumpLine(StuntDouble* sd);
     std::string prepareSiteLine(StuntDouble* sd, int ioIndex, int siteIndex);
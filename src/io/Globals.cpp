@@ -151,6 +151,8 @@ namespace OpenMD {
                                             "compressDumpFile", false);
     DefineOptionalParameterWithDefaultValue(PrintHeatFlux, "printHeatFlux",
                                             false);
+    DefineOptionalParameterWithDefaultValue(PrintDiagnostics,
+                                            "printDiagnostics", false);
     DefineOptionalParameterWithDefaultValue(OutputForceVector,
                                             "outputForceVector", false);
     DefineOptionalParameterWithDefaultValue(OutputParticlePotential,
@@ -188,6 +190,12 @@ namespace OpenMD {
 
     DefineOptionalParameterWithDefaultValue(PrivilegedAxis,"privilegedAxis","z");
 
+    DefineOptionalParameterWithDefaultValue(RotationPropagator,
+                                            "rotationPropagator", "DLM");
+    DefineOptionalParameterWithDefaultValue(RespaPairSteps, "respaPairSteps",
+                                            1);
+    DefineOptionalParameter(RespaReciprocalSteps, "respaReciprocalSteps");
+
     deprecatedKeywords_.insert("nComponents");
     deprecatedKeywords_.insert("nZconstraints");
     deprecatedKeywords_.insert("initialConfig");
@@ -287,6 +295,10 @@ namespace OpenMD {
     CheckParameter(PrivilegedAxis,isEqualIgnoreCase("x") ||
 		   isEqualIgnoreCase("y") ||
 		   isEqualIgnoreCase("z"));
+    CheckParameter(RotationPropagator, isEqualIgnoreCase("DLM") ||
+                   isEqualIgnoreCase("QDLM"));
+    CheckParameter(RespaPairSteps, isPositive());
+    CheckParameter(RespaReciprocalSteps, isPositive());
 
     for(std::vector<Component*>::iterator i = components_.begin();
         i != components_.end(); ++i) {
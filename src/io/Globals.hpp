@@ -107,6 +107,7 @@ namespace OpenMD {
     DeclareParameter(PrintHeatFlux, bool);
     DeclareParameter(TaggedAtomPair, intPair);
     DeclareParameter(PrintTaggedPairDistance, bool);
+    DeclareParameter(PrintDiagnostics, bool);
     DeclareParameter(ElectrostaticSummationMethod, std::string);
     DeclareParameter(ElectrostaticScreeningMethod, std::string);
     DeclareParameter(UseSurfaceTerm, bool);
@@ -158,6 +159,10 @@ namespace OpenMD {
 
     DeclareParameter(PrivilegedAxis, std::string);
 
+    DeclareParameter(RotationPropagator, std::string);
+    DeclareParameter(RespaPairSteps, int);
+    DeclareParameter(RespaReciprocalSteps, int);
+
   public:
     bool addComponent(Component* comp);
     bool addZConsStamp(ZConsStamp* zcons);
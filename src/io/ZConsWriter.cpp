@@ -89,13 +89,13 @@ namespace OpenMD {
 #endif
   }
 
-  void ZConsWriter::writeFZ(const std::list<ZconstraintMol>& fixedZmols){
+  void ZConsWriter::writeFZ(const std::vector<ZconstraintMol>& fixedZmols){
 #ifndef IS_MPI
     output_ << info_->getSnapshotManager()->getCurrentSnapshot()->getTime() 
 	    << std::endl;
     output_ << fixedZmols.size() << std::endl;
 
-    std::list<ZconstraintMol>::const_iterator i;
+    std::vector<ZconstraintMol>::const_iterator i;
     for ( i = fixedZmols.begin(); i != fixedZmols.end(); ++i) {
       output_ << i->mol->getGlobalIndex() <<"\t" << i->fz << "\t" << i->zpos 
 	      << "\t" << i->param.zTargetPos <<std::endl;
@@ -127,7 +127,7 @@ namespace OpenMD {
       ZconsData tmpData;       
       for(int i =0 ; i < nproc; ++i) {
 	if (i == masterNode) {
-	  std::list<ZconstraintMol>::const_iterator j;
+	  std::vector<ZconstraintMol>::const_iterator j;
 	  for ( j = fixedZmols.begin(); j != fixedZmols.end(); ++j) {
 	    tmpData.zmolIndex = j->mol->getGlobalIndex() ;
 	    tmpData.zforce= j->fz;
@@ -161,7 +161,7 @@ namespace OpenMD {
       
     } else {
       
-      std::list<ZconstraintMol>::const_iterator j;
+      std::vector<ZconstraintMol>::const_iterator j;
       for (j = fixedZmols.begin(); j != fixedZmols.end(); ++j) {
 	zmolIndex = j->mol->getGlobalIndex();            
 	data[0] = j->fz;
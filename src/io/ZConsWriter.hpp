@@ -51,6 +51,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "brains/SimInfo.hpp"
 #include "constraints/ZconsStruct.hpp"
@@ -63,7 +64,7 @@ namespace OpenMD {
     ZConsWriter(SimInfo* info, const std::string& filename);
     ~ZConsWriter();  
 
-    void writeFZ(const std::list<ZconstraintMol>& fixedZmols);
+    void writeFZ(const std::vector<ZconstraintMol>& fixedZmols);
           
   private:
     void writeZPos();
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2005 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+
+#ifndef MATH_COUNTERRANDNUMGEN_HPP
+#define MATH_COUNTERRANDNUMGEN_HPP
+
+#include <cmath>
+#include <stdint.h>
+#include "config.h"
+
+namespace OpenMD {
+
+  /**
+   * @class CounterRandNumGen
+   * @brief a random number stream determined entirely by a key
+   *
+   * The stream is the SplitMix64 sequence started from a hash of the
+   * three key words, so the numbers drawn for a given key do not
+   * depend on which processor or thread draws them, or in what
+   * order.  Keying a stream on (seed, call, global index) gives every
+   * object its own reproducible draws regardless of the decomposition.
+   */
+  class CounterRandNumGen {
+  public:
+    CounterRandNumGen(uint64_t key0, uint64_t key1, uint64_t key2) {
+      state_ = mix(mix(mix(key0) ^ key1) ^ key2);
+    }
+
+    /** Returns a real number in (0, 1) */
+    RealType randDblExc() {
+      return (RealType(next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    /** Returns a normally distributed number (Box-Muller method) */
+    RealType randNorm(const RealType mean, const RealType variance) {
+      RealType r = sqrt(-2.0 * log(randDblExc()) * variance);
+      RealType phi = 2.0 * 3.14159265358979323846264338328 * randDblExc();
+      return mean + r * cos(phi);
+    }
+
+  private:
+    uint64_t next() {
+      state_ += 0x9E3779B97F4A7C15ULL;
+      return mix(state_);
+    }
+
+    static uint64_t mix(uint64_t z) {
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      return z ^ (z >> 31);
+    }
+
+    uint64_t state_;
+  };
+}
+#endif
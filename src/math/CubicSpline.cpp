@@ -131,6 +131,7 @@ void CubicSpline::generate() {
     d[1] = 0.0;
     dx = 1.0 / (x_[1] - x_[0]);
     isUniform = true;
+    pack();
     generated = true;
     return;
   }
@@ -193,10 +194,26 @@ void CubicSpline::generate() {
   
   if (isUniform) dx = 1.0 / (x_[1] - x_[0]); 
   
+  pack();
   generated = true;
   return;
 }
 
+void CubicSpline::pack() {
+  // Interleave the knot and coefficients of each interval so that an
+  // evaluation touches a single contiguous record instead of five
+  // separate arrays.
+
+  coeffs_.resize(5 * n);
+  for (int i = 0; i < n; i++) {
+    coeffs_[5*i    ] = x_[i];
+    coeffs_[5*i + 1] = y_[i];
+    coeffs_[5*i + 2] = b[i];
+    coeffs_[5*i + 3] = c[i];
+    coeffs_[5*i + 4] = d[i];
+  }
+}
+
 RealType CubicSpline::getValueAt(const RealType& t) {
   // Evaluate the spline at t using coefficients 
   //
@@ -231,8 +248,9 @@ RealType CubicSpline::getValueAt(const RealType& t) {
   
   //  Evaluate the cubic polynomial.
   
-  dt = t - x_[j];
-  return y_[j] + dt*(b[j] + dt*(c[j] + dt*d[j]));  
+  const RealType* k = &coeffs_[5*j];
+  dt = t - k[0];
+  return k[1] + dt*(k[2] + dt*(k[3] + dt*k[4]));  
 }
 
 
@@ -270,8 +288,9 @@ void CubicSpline::getValueAt(const RealType& t, RealType& v) {
   
   //  Evaluate the cubic polynomial.
   
-  dt = t - x_[j];
-  v = y_[j] + dt*(b[j] + dt*(c[j] + dt*d[j]));  
+  const RealType* k = &coeffs_[5*j];
+  dt = t - k[0];
+  v = k[1] + dt*(k[2] + dt*(k[3] + dt*k[4]));  
 }
 
 pair<RealType, RealType> CubicSpline::getLimits(){
@@ -319,10 +338,11 @@ void CubicSpline::getValueAndDerivativeAt(const RealType& t, RealType& v,
   
   //  Evaluate the cubic polynomial.
   
-  dt = t - x_[j];
+  const RealType* k = &coeffs_[5*j];
+  dt = t - k[0];
 
-  v = y_[j] + dt*(b[j] + dt*(c[j] + dt*d[j]));
-  dv = b[j] + dt*(2.0 * c[j] + 3.0 * dt * d[j]); 
+  v = k[1] + dt*(k[2] + dt*(k[3] + dt*k[4]));
+  dv = k[2] + dt*(2.0 * k[3] + 3.0 * dt * k[4]); 
 }
 
 std::vector<int> CubicSpline::sort_permutation(std::vector<RealType>& v) {
@@ -64,6 +64,7 @@ namespace OpenMD {
     
   private:
     void generate();
+    void pack();
     std::vector<int> sort_permutation(std::vector<RealType>& v);
     std::vector<RealType> apply_permutation(std::vector<RealType> const& v,
                                             std::vector<int> const& p);
@@ -77,6 +78,7 @@ namespace OpenMD {
     vector<RealType> b;
     vector<RealType> c;
     vector<RealType> d;    
+    vector<RealType> coeffs_; /**< x, y, b, c, d interleaved per knot */
   };
 
   class Comparator{
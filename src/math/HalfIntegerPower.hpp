@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2009 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#ifndef MATH_HALFINTEGERPOWER_HPP
+#define MATH_HALFINTEGERPOWER_HPP
+
+#include <cmath>
+#include <cstdlib>
+#include "config.h"
+
+namespace OpenMD {
+
+  /**
+   * @class HalfIntegerPower
+   * Evaluates x^p for a fixed exponent p.  Integer and half-integer
+   * exponents up to maxTwoP/2 in magnitude use repeated
+   * multiplication (plus one sqrt for the half-integer part).  Other
+   * exponents fall back to pow().
+   */
+  class HalfIntegerPower {
+  public:
+    HalfIntegerPower(RealType p = 1.0) { setExponent(p); }
+
+    void setExponent(RealType p) {
+      p_ = p;
+      RealType twoP = 2.0 * p;
+      int n = int(floor(twoP + 0.5));
+      special_ = (fabs(twoP - n) < 1.0e-12) && (abs(n) <= maxTwoP);
+      twoP_ = special_ ? abs(n) : 0;
+      negative_ = (n < 0);
+    }
+
+    RealType getExponent() const { return p_; }
+
+    /** Returns true when x^p avoids the call to pow() */
+    bool isSpecialized() const { return special_; }
+
+    RealType operator()(RealType x) const {
+      if (!special_) return pow(x, p_);
+
+      RealType result = (twoP_ & 1) ? sqrt(x) : RealType(1.0);
+      for (int i = 0; i < (twoP_ >> 1); i++) result *= x;
+      return negative_ ? RealType(1.0) / result : result;
+    }
+
+  private:
+    static const int maxTwoP = 16;
+
+    RealType p_;
+    int twoP_;
+    bool special_;
+    bool negative_;
+  };
+
+}
+#endif
@@ -870,22 +870,34 @@ namespace OpenMD {
     if (haveCutoffRadius_)
       if ( *(idat.rij) > eamRcut_) return;
 
+    // The derivatives are evaluated here as well (they come from the
+    // same spline interval) and handed on to calcForce:
+    RealType* cached = pairCache_.record(idat.atid1, idat.atid2, *(idat.rij));
+    RealType rha(0.0), drha(0.0), rhb(0.0), drhb(0.0);
+
     if ( *(idat.rij) < data1.rcut) {
+      data1.rho->getValueAndDerivativeAt( *(idat.rij), rha, drha);
       m = 1.0;
       if (data1.isFluctuatingCharge) {
         m = (oss_ * data1.nValence - *(idat.flucQ1)) / (oss_ * data1.nMobile);
       }
-      *(idat.rho2) += m * data1.rho->getValueAt( *(idat.rij) );
+      *(idat.rho2) += m * rha;
     }
 
     if ( *(idat.rij) < data2.rcut) {
+      data2.rho->getValueAndDerivativeAt( *(idat.rij), rhb, drhb);
       m = 1.0;
       if (data2.isFluctuatingCharge) {
         m = (oss_ * data2.nValence - *(idat.flucQ2)) / (oss_ * data2.nMobile);
       }
-      *(idat.rho1) += m * data2.rho->getValueAt( *(idat.rij));
+      *(idat.rho1) += m * rhb;
     }
 
+    cached[0] = rha;
+    cached[1] = drha;
+    cached[2] = rhb;
+    cached[3] = drhb;
+
     return;
   }
 
@@ -933,15 +945,29 @@ namespace OpenMD {
     RealType phab(0.0), dvpdr(0.0);
     RealType drhoidr(0.0), drhojdr(0.0), dudr(0.0);
 
+    // densities recorded for this pair by calcDensity, if available:
+    const RealType* cached = pairCache_.lookup(idat.atid1, idat.atid2,
+                                               *(idat.rij));
+
     rhat =  *(idat.d) / *(idat.rij);
     if ( *(idat.rij) < rci && *(idat.rij) < rcij ) {
-      data1.rho->getValueAndDerivativeAt( *(idat.rij), rha, drha);
+      if (cached) {
+        rha = cached[0];
+        drha = cached[1];
+      } else {
+        data1.rho->getValueAndDerivativeAt( *(idat.rij), rha, drha);
+      }
       CubicSpline* phi = MixingMap[eamtid1][eamtid1].phi;
       phi->getValueAndDerivativeAt( *(idat.rij), pha, dpha);
     }
 
     if ( *(idat.rij) < rcj && *(idat.rij) < rcij ) {
-      data2.rho->getValueAndDerivativeAt( *(idat.rij), rhb, drhb );
+      if (cached) {
+        rhb = cached[2];
+        drhb = cached[3];
+      } else {
+        data2.rho->getValueAndDerivativeAt( *(idat.rij), rhb, drhb );
+      }
       CubicSpline* phi = MixingMap[eamtid2][eamtid2].phi;
       phi->getValueAndDerivativeAt( *(idat.rij), phb, dphb);
     }
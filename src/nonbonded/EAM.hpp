@@ -49,6 +49,7 @@
 #include "brains/ForceField.hpp"
 #include "math/Vector3.hpp"
 #include "math/CubicSpline.hpp"
+#include "nonbonded/MetallicPairCache.hpp"
 
 namespace OpenMD {
 
@@ -153,6 +154,7 @@ namespace OpenMD {
     RealType eamRcut_;
     RealType oss_;
     Vector3d rhat;
+    MetallicPairCache<4> pairCache_; /**< rho and drho/dr for both atoms */
 
     EAMMixingMethod mixMeth_;
     string name_;
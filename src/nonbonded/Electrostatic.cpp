@@ -623,6 +623,19 @@ namespace OpenMD {
 
     haveElectroSplines_ = true;
 
+    // pick a pair kernel for every combination of electrostatic types:
+    vector<int> mpClass(nElectro_);
+    for (int i = 0; i < nElectro_; i++)
+      mpClass[i] = getMultipoleClass(ElectrostaticMap[i]);
+
+    pairKernels_.clear();
+    pairKernels_.resize(nElectro_);
+    for (int i = 0; i < nElectro_; i++) {
+      pairKernels_[i].resize(nElectro_);
+      for (int j = 0; j < nElectro_; j++)
+        pairKernels_[i][j] = getPairKernel(mpClass[i], mpClass[j]);
+    }
+
     initialized_ = true;
   }
 
@@ -770,46 +783,107 @@ namespace OpenMD {
     haveDielectric_ = true;
   }
 
-  void Electrostatic::calcForce(InteractionData &idat) {
+  int Electrostatic::getMultipoleClass(const ElectrostaticAtomData &data) {
+    // Fluctuating and Slater-type sites carry extra state and always
+    // go through the general kernel:
+    if (data.is_Fluctuating || data.uses_SlaterElectrostatics ||
+        data.uses_SlaterIntramolecular)
+      return MP_GENERAL;
+
+    int mpClass = 0;
+    if (data.is_Charge) mpClass |= MP_CHARGE;
+    if (data.is_Dipole) mpClass |= MP_DIPOLE;
+    if (data.is_Quadrupole) mpClass |= MP_QUADRUPOLE;
+
+    // only pure multipole sites get specialized kernels:
+    if (mpClass == MP_CHARGE || mpClass == MP_DIPOLE ||
+        mpClass == MP_QUADRUPOLE)
+      return mpClass;
+    return MP_GENERAL;
+  }
 
-    if (!initialized_) initialize();
+  template<int A>
+  Electrostatic::PairKernel Electrostatic::getPairKernel(int mpClassB) {
+    switch (mpClassB) {
+    case MP_CHARGE:
+      return &Electrostatic::calcMultipoleForce<A, MP_CHARGE>;
+    case MP_DIPOLE:
+      return &Electrostatic::calcMultipoleForce<A, MP_DIPOLE>;
+    case MP_QUADRUPOLE:
+      return &Electrostatic::calcMultipoleForce<A, MP_QUADRUPOLE>;
+    default:
+      return &Electrostatic::calcMultipoleForce<MP_GENERAL, MP_GENERAL>;
+    }
+  }
 
-    if (Etids[idat.atid1] != -1) {
-      data1 = ElectrostaticMap[Etids[idat.atid1]];
-      a_is_Charge = data1.is_Charge;
-      a_is_Dipole = data1.is_Dipole;
-      a_is_Quadrupole = data1.is_Quadrupole;
-      a_is_Fluctuating = data1.is_Fluctuating;
-      a_uses_Slater = data1.uses_SlaterElectrostatics;
-      a_uses_SlaterIntra = data1.uses_SlaterIntramolecular;
+  Electrostatic::PairKernel Electrostatic::getPairKernel(int mpClassA,
+                                                         int mpClassB) {
+    switch (mpClassA) {
+    case MP_CHARGE:
+      return getPairKernel<MP_CHARGE>(mpClassB);
+    case MP_DIPOLE:
+      return getPairKernel<MP_DIPOLE>(mpClassB);
+    case MP_QUADRUPOLE:
+      return getPairKernel<MP_QUADRUPOLE>(mpClassB);
+    default:
+      return &Electrostatic::calcMultipoleForce<MP_GENERAL, MP_GENERAL>;
+    }
+  }
 
+  void Electrostatic::calcForce(InteractionData &idat) {
 
-    } else {
-      a_is_Charge = false;
-      a_is_Dipole = false;
-      a_is_Quadrupole = false;
-      a_is_Fluctuating = false;
-      a_uses_Slater = false;
-      a_uses_SlaterIntra = false;
+    if (!initialized_) initialize();
 
-    }
-    if (Etids[idat.atid2] != -1) {
-      data2 = ElectrostaticMap[Etids[idat.atid2]];
-      b_is_Charge = data2.is_Charge;
-      b_is_Dipole = data2.is_Dipole;
-      b_is_Quadrupole = data2.is_Quadrupole;
-      b_is_Fluctuating = data2.is_Fluctuating;
-      b_uses_Slater = data2.uses_SlaterElectrostatics;
-      b_uses_SlaterIntra = data2.uses_SlaterIntramolecular;
+    int et1 = Etids[idat.atid1];
+    int et2 = Etids[idat.atid2];
 
-    } else {
-      b_is_Charge = false;
-      b_is_Dipole = false;
-      b_is_Quadrupole = false;
-      b_is_Fluctuating = false;
-      b_uses_Slater = false;
-      b_uses_SlaterIntra = false;
-    }
+    if (et1 == -1 || et2 == -1)
+      calcMultipoleForce<MP_GENERAL, MP_GENERAL>(idat);
+    else
+      (this->*pairKernels_[et1][et2])(idat);
+  }
+
+  /**
+   * The electrostatic pair kernel.  A and B are the multipole classes
+   * of the two sites.  For pure charge, dipole, or quadrupole sites
+   * these are compile-time constants, so the type tests below fold
+   * away and only the radial functions and interaction terms that the
+   * pair actually needs are evaluated.  MP_GENERAL reads every flag
+   * from the ElectrostaticMap at run time.
+   */
+  template<int A, int B>
+  void Electrostatic::calcMultipoleForce(InteractionData &idat) {
+
+    const int et1 = Etids[idat.atid1];
+    const int et2 = Etids[idat.atid2];
+    const ElectrostaticAtomData* d1 = (et1 != -1) ? &ElectrostaticMap[et1] : NULL;
+    const ElectrostaticAtomData* d2 = (et2 != -1) ? &ElectrostaticMap[et2] : NULL;
+
+    const bool a_is_Charge = (A == MP_GENERAL) ? (d1 && d1->is_Charge) :
+      ((A & MP_CHARGE) != 0);
+    const bool a_is_Dipole = (A == MP_GENERAL) ? (d1 && d1->is_Dipole) :
+      ((A & MP_DIPOLE) != 0);
+    const bool a_is_Quadrupole = (A == MP_GENERAL) ?
+      (d1 && d1->is_Quadrupole) : ((A & MP_QUADRUPOLE) != 0);
+    const bool a_is_Fluctuating = (A == MP_GENERAL) &&
+      d1 && d1->is_Fluctuating;
+    const bool a_uses_Slater = (A == MP_GENERAL) &&
+      d1 && d1->uses_SlaterElectrostatics;
+    const bool a_uses_SlaterIntra = (A == MP_GENERAL) &&
+      d1 && d1->uses_SlaterIntramolecular;
+
+    const bool b_is_Charge = (B == MP_GENERAL) ? (d2 && d2->is_Charge) :
+      ((B & MP_CHARGE) != 0);
+    const bool b_is_Dipole = (B == MP_GENERAL) ? (d2 && d2->is_Dipole) :
+      ((B & MP_DIPOLE) != 0);
+    const bool b_is_Quadrupole = (B == MP_GENERAL) ?
+      (d2 && d2->is_Quadrupole) : ((B & MP_QUADRUPOLE) != 0);
+    const bool b_is_Fluctuating = (B == MP_GENERAL) &&
+      d2 && d2->is_Fluctuating;
+    const bool b_uses_Slater = (B == MP_GENERAL) &&
+      d2 && d2->uses_SlaterElectrostatics;
+    const bool b_uses_SlaterIntra = (B == MP_GENERAL) &&
+      d2 && d2->uses_SlaterIntramolecular;
 
     U = 0.0;  // Potential
     F.zero();  // Force
@@ -878,7 +952,7 @@ namespace OpenMD {
     // calculate the single-site contributions (fields, etc).
 
     if (a_is_Charge) {
-      C_a = data1.fixedCharge;
+      C_a = d1->fixedCharge;
 
       if (a_is_Fluctuating) {
         C_a += *(idat.flucQ1);
@@ -919,7 +993,7 @@ namespace OpenMD {
     }
 
     if (b_is_Charge) {
-      C_b = data2.fixedCharge;
+      C_b = d2->fixedCharge;
 
       if (b_is_Fluctuating) {
         C_b += *(idat.flucQ2);
@@ -115,6 +115,25 @@ namespace OpenMD {
 
   private:
     void initialize();
+
+    /**
+     * Multipole classes used to select a specialized pair kernel.
+     * Sites that mix multipole orders, fluctuate, or use Slater
+     * electrostatics fall into MP_GENERAL.
+     */
+    enum MultipoleClass {
+      MP_GENERAL = 0,
+      MP_CHARGE = 1,
+      MP_DIPOLE = 2,
+      MP_QUADRUPOLE = 4
+    };
+    typedef void (Electrostatic::*PairKernel)(InteractionData &idat);
+
+    int getMultipoleClass(const ElectrostaticAtomData &data);
+    PairKernel getPairKernel(int mpClassA, int mpClassB);
+    template<int A> PairKernel getPairKernel(int mpClassB);
+    template<int A, int B> void calcMultipoleForce(InteractionData &idat);
+
     string name_;
     bool initialized_;
     bool haveCutoffRadius_;
@@ -131,6 +150,7 @@ namespace OpenMD {
     vector<int> FQtids;          /**< The mapping from AtomType ident -> fluctuating ident */
     vector<ElectrostaticAtomData> ElectrostaticMap; /**< data about Electrostatic types */
     vector<vector<CubicSpline*> > Jij;              /**< Coulomb integral for two fq types */
+    vector<vector<PairKernel> > pairKernels_;       /**< pair kernel for two electrostatic types */
     
 
     SimInfo* info_;
@@ -103,6 +103,8 @@ namespace OpenMD {
     ForceFieldOptions& fopts = forceField_->getForceFieldOptions();
     mu_ = fopts.getGayBerneMu();
     nu_ = fopts.getGayBerneNu();
+    muPow_.setExponent(mu_);
+    nuPow_.setExponent(nu_);
 
     // GB handles all of the GB-GB interactions as well as GB-LJ cross
     // interactions:
@@ -112,7 +114,7 @@ namespace OpenMD {
       if ((*at)->isLennardJones()) nGB_++;
     }
 
-    MixingMap.resize(nGB_);
+    MixingMap.resize(nGB_ * nGB_);
     for (at = simTypes_.begin(); at != simTypes_.end(); ++at) {
       if ((*at)->isGayBerne() || (*at)->isLennardJones()) addType( *at );
     }
@@ -138,7 +140,6 @@ namespace OpenMD {
     }
 
     GBtids[atid] = gbtid;
-    MixingMap[gbtid].resize( nGB_ );
     
     RealType d1(0.0), l1(0.0), eX1(0.0), eS1(0.0), eE1(0.0), dw1(0.0);
     
@@ -239,18 +240,29 @@ namespace OpenMD {
       mixer2.dw = mixer1.dw;
       mixer2.eps0 = mixer1.eps0;
       
-      RealType mi = RealType(1.0)/mu_;
-      
-      mixer1.xpap2  = (pow(eS1, mi) - pow(eE1, mi)) / (pow(eS1, mi) + pow(eE2, mi));
-      mixer1.xpapi2 = (pow(eS2, mi) - pow(eE2, mi)) / (pow(eS2, mi) + pow(eE1, mi));
-      mixer1.xp2    = (pow(eS1, mi) - pow(eE1, mi)) * (pow(eS2, mi) - pow(eE2, mi))  / 
-        (pow(eS2, mi) + pow(eE1, mi)) / (pow(eS1, mi) + pow(eE2, mi)) ;
+      HalfIntegerPower miPow(RealType(1.0)/mu_);
+      RealType pS1 = miPow(eS1);
+      RealType pE1 = miPow(eE1);
+      RealType pS2 = miPow(eS2);
+      RealType pE2 = miPow(eE2);
+
+      mixer1.xpap2  = (pS1 - pE1) / (pS1 + pE2);
+      mixer1.xpapi2 = (pS2 - pE2) / (pS2 + pE1);
+      mixer1.xp2    = (pS1 - pE1) * (pS2 - pE2) / (pS2 + pE1) / (pS1 + pE2);
       
       // xpap2 and xpapi2 for j-i pairs are reversed from the same i-j pairing.
       // Swapping the particles reverses the anisotropy parameters:
       mixer2.xpap2 = mixer1.xpapi2;
       mixer2.xpapi2 = mixer1.xpap2;
       mixer2.xp2 = mixer1.xp2;
+
+      // constants used by every pair evaluation:
+      mixer1.dwSigma0 = mixer1.dw * mixer1.sigma0;
+      mixer1.sigma02 = mixer1.sigma0 * mixer1.sigma0;
+      mixer1.dwS03 = mixer1.dwSigma0 * mixer1.sigma02;
+      mixer2.dwSigma0 = mixer1.dwSigma0;
+      mixer2.sigma02 = mixer1.sigma02;
+      mixer2.dwS03 = mixer1.dwS03;
       // keep track of who is the LJ atom:
       mixer1.i_is_LJ = atomType->isLennardJones();
       mixer1.j_is_LJ = atype2->isLennardJones();
@@ -261,10 +273,9 @@ namespace OpenMD {
       // only add this pairing if at least one of the atoms is a Gay-Berne atom
 
       if (gba1.isGayBerne() || gba2.isGayBerne()) {
-        MixingMap[gbtid2].resize( nGB_ );        
-        MixingMap[gbtid][gbtid2] = mixer1;
+        MixingMap[gbtid * nGB_ + gbtid2] = mixer1;
         if (gbtid2 != gbtid)  {
-          MixingMap[gbtid2][gbtid] = mixer2;
+          MixingMap[gbtid2 * nGB_ + gbtid] = mixer2;
         }          
       }
     }
@@ -274,10 +285,10 @@ namespace OpenMD {
 
     if (!initialized_) initialize();
     
-    GBInteractionData &mixer = MixingMap[GBtids[idat.atid1]][GBtids[idat.atid2]];
+    const GBInteractionData &mixer = MixingMap[GBtids[idat.atid1] * nGB_ +
+                                               GBtids[idat.atid2]];
 
     RealType sigma0 = mixer.sigma0;
-    RealType dw     = mixer.dw;
     RealType eps0   = mixer.eps0;  
     RealType x2     = mixer.x2;    
     RealType xa2    = mixer.xa2;   
@@ -286,45 +297,34 @@ namespace OpenMD {
     RealType xpap2  = mixer.xpap2; 
     RealType xpapi2 = mixer.xpapi2;
 
-    Vector3d ul1 = idat.A1->getRow(2);
-    Vector3d ul2 = idat.A2->getRow(2);
-
-    RealType a, b, g;
-    
-    if (mixer.i_is_LJ) {
-      a = 0.0;
-      ul1 = V3Zero;
-    } else {
-      a = dot(*(idat.d), ul1);
-    }
-
-    if (mixer.j_is_LJ) {
-      b = 0.0;
-      ul2 = V3Zero;
-    } else {
-      b = dot(*(idat.d), ul2);
-    }
+    RealType r = *(idat.rij);
+    RealType ri = 1.0 / r;
+    const Vector3d &d = *(idat.d);
 
-    if (mixer.i_is_LJ || mixer.j_is_LJ) 
-      g = 0.0;
-    else
-      g = dot(ul1, ul2);
+    // Lennard-Jones sites have no orientation, so their unit vectors
+    // (and every dot product involving them) are zero:
+    Vector3d ul1 = mixer.i_is_LJ ? V3Zero : Vector3d(idat.A1->getRow(2));
+    Vector3d ul2 = mixer.j_is_LJ ? V3Zero : Vector3d(idat.A2->getRow(2));
 
-    RealType au = a / *(idat.rij);
-    RealType bu = b / *(idat.rij);
+    RealType au = dot(d, ul1) * ri;
+    RealType bu = dot(d, ul2) * ri;
+    RealType g  = dot(ul1, ul2);
     
     RealType au2 = au * au;
     RealType bu2 = bu * bu;
     RealType g2 = g * g;
 
-    RealType H  = (xa2 * au2 + xai2 * bu2 - 2.0*x2*au*bu*g)  / (1.0 - x2*g2);
-    RealType Hp = (xpap2*au2 + xpapi2*bu2 - 2.0*xp2*au*bu*g) / (1.0 - xp2*g2);
+    RealType ix  = 1.0 / (1.0 - x2*g2);
+    RealType ixp = 1.0 / (1.0 - xp2*g2);
+
+    RealType H  = (xa2 * au2 + xai2 * bu2 - 2.0*x2*au*bu*g)  * ix;
+    RealType Hp = (xpap2*au2 + xpapi2*bu2 - 2.0*xp2*au*bu*g) * ixp;
 
     RealType sigma = sigma0 / sqrt(1.0 - H);
-    RealType e1 = 1.0 / sqrt(1.0 - x2*g2);
+    RealType e1 = sqrt(ix);
     RealType e2 = 1.0 - Hp;
-    RealType eps = eps0 * pow(e1,nu_) * pow(e2,mu_);
-    RealType BigR = dw*sigma0 / (*(idat.rij) - sigma + dw*sigma0);
+    RealType eps = eps0 * nuPow_(e1) * muPow_(e2);
+    RealType BigR = mixer.dwSigma0 / (r - sigma + mixer.dwSigma0);
     
     RealType R3 = BigR*BigR*BigR;
     RealType R6 = R3*R3;
@@ -335,31 +335,28 @@ namespace OpenMD {
     RealType U = *(idat.vdwMult) * 4.0 * eps * (R12 - R6);
 
     RealType s3 = sigma*sigma*sigma;
-    RealType s03 = sigma0*sigma0*sigma0;
 
-    RealType pref1 = - *(idat.vdwMult) * 8.0 * eps * mu_ * (R12 - R6) / 
-      (e2 * *(idat.rij));
+    RealType pref1 = - *(idat.vdwMult) * 8.0 * eps * mu_ * (R12 - R6) * ri / e2;
 
-    RealType pref2 = *(idat.vdwMult) * 8.0 * eps * s3 * (6.0*R13 - 3.0*R7) /
-      (dw*  *(idat.rij) * s03);
+    RealType pref2 = *(idat.vdwMult) * 8.0 * eps * s3 * (6.0*R13 - 3.0*R7) *
+      ri / mixer.dwS03;
 
-    RealType dUdr = - (pref1 * Hp + pref2 * (sigma0 * sigma0 *  
-                                             *(idat.rij) / s3 + H));
+    RealType dUdr = - (pref1 * Hp + pref2 * (mixer.sigma02 * r / s3 + H));
     
-    RealType dUda = pref1 * (xpap2*au - xp2*bu*g) / (1.0 - xp2 * g2) 
-      + pref2 * (xa2 * au - x2 *bu*g) / (1.0 - x2 * g2);
+    RealType dUda = pref1 * (xpap2*au - xp2*bu*g) * ixp
+      + pref2 * (xa2 * au - x2 *bu*g) * ix;
     
-    RealType dUdb = pref1 * (xpapi2*bu - xp2*au*g) / (1.0 - xp2 * g2) 
-      + pref2 * (xai2 * bu - x2 *au*g) / (1.0 - x2 * g2);
+    RealType dUdb = pref1 * (xpapi2*bu - xp2*au*g) * ixp
+      + pref2 * (xai2 * bu - x2 *au*g) * ix;
     
-    RealType dUdg = 4.0 * eps * nu_ * (R12 - R6) * x2 * g / (1.0 - x2*g2)
-      + 8.0 * eps * mu_ * (R12 - R6) * (xp2*au*bu - Hp*xp2*g) / 
-      (1.0 - xp2 * g2) / e2 + 8.0 * eps * s3 * (3.0 * R7 - 6.0 * R13) * 
-      (x2 * au * bu - H * x2 * g) / (1.0 - x2 * g2) / (dw * s03);
+    RealType dUdg = 4.0 * eps * nu_ * (R12 - R6) * x2 * g * ix
+      + 8.0 * eps * mu_ * (R12 - R6) * (xp2*au*bu - Hp*xp2*g) * ixp / e2
+      + 8.0 * eps * s3 * (3.0 * R7 - 6.0 * R13) * (x2 * au * bu - H * x2 * g)
+      * ix / mixer.dwS03;
     
-    Vector3d rhat = *(idat.d) / *(idat.rij);   
-    Vector3d rxu1 = cross(*(idat.d), ul1);
-    Vector3d rxu2 = cross(*(idat.d), ul2);
+    Vector3d rhat = d * ri;
+    Vector3d rxu1 = cross(d, ul1);
+    Vector3d rxu2 = cross(d, ul2);
     Vector3d uxu = cross(ul1, ul2);
     
     (*(idat.pot))[VANDERWAALS_FAMILY] += U *  *(idat.sw);
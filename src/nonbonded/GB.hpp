@@ -46,6 +46,7 @@
 #include "nonbonded/NonBondedInteraction.hpp"
 #include "brains/ForceField.hpp"
 #include "math/SquareMatrix3.hpp"
+#include "math/HalfIntegerPower.hpp"
 
 using namespace std;
 namespace OpenMD {
@@ -60,6 +61,9 @@ namespace OpenMD {
     RealType xp2;
     RealType xpap2;
     RealType xpapi2;
+    RealType dwSigma0;  /**< dw * sigma0 */
+    RealType sigma02;   /**< sigma0^2 */
+    RealType dwS03;     /**< dw * sigma0^3 */
     bool i_is_LJ;
     bool j_is_LJ;
   };
@@ -83,14 +87,17 @@ namespace OpenMD {
     string name_;
     set<int> GBtypes;               /**< The set of AtomType idents that are GB types */
     vector<int> GBtids;             /**< The mapping from AtomType ident -> GB type ident */
-    vector<vector<GBInteractionData> > MixingMap;  /**< The mixing parameters between two 
-                                                      GB types */
+    vector<GBInteractionData> MixingMap;  /**< The mixing parameters between two
+                                             GB types, stored as a flat
+                                             nGB_ x nGB_ table */
     int nGB_;
 
     ForceField* forceField_;
     set<AtomType*> simTypes_;
     RealType mu_;
     RealType nu_;
+    HalfIntegerPower muPow_;   /**< evaluates x^mu */
+    HalfIntegerPower nuPow_;   /**< evaluates x^nu */
     
   };
 }
@@ -53,6 +53,7 @@ namespace OpenMD {
   InteractionManager::InteractionManager() {
 
     initialized_ = false;
+    chargeOnly_ = false;
 
     lj_ = new LJ();
     gb_ = new GB();
@@ -524,6 +525,7 @@ namespace OpenMD {
     int& iHash = iHash_[idat.atid1][idat.atid2];
 
     if ((iHash & EAM_INTERACTION) != 0) eam_->calcDensity(idat);
+    if (chargeOnly_) return;
     if ((iHash & SC_INTERACTION) != 0)  sc_->calcDensity(idat);
 
     // set<NonBondedInteraction*>::iterator it;
@@ -545,6 +547,7 @@ namespace OpenMD {
     int& sHash = sHash_[sdat.atid];
 
     if ((sHash & EAM_INTERACTION) != 0)  eam_->calcFunctional(sdat);
+    if (chargeOnly_) return;
     if ((sHash & SC_INTERACTION) != 0)  sc_->calcFunctional(sdat);
 
     // set<NonBondedInteraction*>::iterator it;
@@ -573,6 +576,12 @@ namespace OpenMD {
 
     if (idat.excluded) return;
 
+    // of the remaining interactions, only EAM couples to the charges:
+    if (chargeOnly_) {
+      if ((iHash & EAM_INTERACTION) != 0) eam_->calcForce(idat);
+      return;
+    }
+
     if ((iHash & LJ_INTERACTION) != 0)             lj_->calcForce(idat);
     if ((iHash & GB_INTERACTION) != 0)             gb_->calcForce(idat);
     if ((iHash & STICKY_INTERACTION) != 0)         sticky_->calcForce(idat);
@@ -88,9 +88,17 @@ namespace OpenMD {
     void setCutoffRadius(RealType rCut);
     RealType getSuggestedCutoffRadius(int *atid1);   
     RealType getSuggestedCutoffRadius(AtomType *atype);
+
+    /**
+     * When set, doPrePair, doPreForce and doPair only evaluate the
+     * interactions that depend on the fluctuating charges
+     * (electrostatics and EAM).
+     */
+    void setChargeOnly(bool chargeOnly) { chargeOnly_ = chargeOnly; }
     
   private:
     bool initialized_;
+    bool chargeOnly_;
 
     void setupElectrostatics();
 
@@ -0,0 +1,120 @@
+ /*
+ * Copyright (c) 2009 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#ifndef NONBONDED_METALLICPAIRCACHE_HPP
+#define NONBONDED_METALLICPAIRCACHE_HPP
+
+#include "config.h"
+#include <cstddef>
+#include <vector>
+
+namespace OpenMD {
+
+  /**
+   * @class MetallicPairCache
+   * Carries per-pair spline results from the density pass of a
+   * metallic interaction to the force pass.
+   *
+   * ForceManager walks the same neighbor list in the same order in
+   * the pre-pair (density) loop and the pair (force) loop, so entries
+   * are recorded sequentially during the first pass and consumed
+   * sequentially during the second.  Each entry remembers the atom
+   * types and separation it was computed for; a lookup that does not
+   * match returns NULL, so callers can always fall back to evaluating
+   * the splines directly.
+   *
+   * The first record() after a lookup() (or the first ever) starts a
+   * new density pass, and the first lookup() after a record() starts
+   * the matching force pass.
+   */
+  template<int N>
+  class MetallicPairCache {
+  public:
+    MetallicPairCache() : inDensityPass_(false), cursor_(0) {}
+
+    /**
+     * Appends an entry for this pair and returns storage for N values.
+     */
+    RealType* record(int atid1, int atid2, RealType r) {
+      if (!inDensityPass_) {
+        entries_.clear();
+        inDensityPass_ = true;
+      }
+      entries_.push_back(Entry());
+      Entry& e = entries_.back();
+      e.atid1 = atid1;
+      e.atid2 = atid2;
+      e.r = r;
+      return e.values;
+    }
+
+    /**
+     * Returns the values recorded for this pair during the density
+     * pass, or NULL if the next entry was recorded for another pair.
+     */
+    const RealType* lookup(int atid1, int atid2, RealType r) {
+      if (inDensityPass_) {
+        cursor_ = 0;
+        inDensityPass_ = false;
+      }
+      if (cursor_ >= entries_.size()) return NULL;
+      Entry& e = entries_[cursor_];
+      if (e.atid1 != atid1 || e.atid2 != atid2 || e.r != r) return NULL;
+      ++cursor_;
+      return e.values;
+    }
+
+  private:
+    struct Entry {
+      int atid1;
+      int atid2;
+      RealType r;
+      RealType values[N];
+    };
+
+    std::vector<Entry> entries_;
+    bool inDensityPass_;
+    size_t cursor_;
+  };
+}
+
+#endif
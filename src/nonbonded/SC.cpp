@@ -279,9 +279,16 @@ namespace OpenMD {
     RealType rcij = mixer.rCut;
 
     if ( *(idat.rij)  < rcij) {
-      RealType rho = mixer.phi->getValueAt( *(idat.rij) );
+      RealType rho, drhodr;
+      mixer.phi->getValueAndDerivativeAt( *(idat.rij), rho, drhodr );
       *(idat.rho1) += rho;
       *(idat.rho2) += rho;
+
+      // keep both for calcForce:
+      RealType* cached = pairCache_.record(idat.atid1, idat.atid2,
+                                           *(idat.rij));
+      cached[0] = rho;
+      cached[1] = drhodr;
     } 
     
     return;
@@ -329,7 +336,14 @@ namespace OpenMD {
       RealType vcij = mixer.vCut; 
       RealType rhtmp, drhodr, vptmp, dvpdr;
       
-      mixer.phi->getValueAndDerivativeAt( *(idat.rij), rhtmp, drhodr );      
+      const RealType* cached = pairCache_.lookup(idat.atid1, idat.atid2,
+                                                 *(idat.rij));
+      if (cached) {
+        rhtmp = cached[0];
+        drhodr = cached[1];
+      } else {
+        mixer.phi->getValueAndDerivativeAt( *(idat.rij), rhtmp, drhodr );
+      }
       mixer.V->getValueAndDerivativeAt( *(idat.rij), vptmp, dvpdr);
       
       RealType pot_temp = vptmp - vcij;
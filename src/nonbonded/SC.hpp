@@ -46,6 +46,7 @@
 #include "nonbonded/NonBondedInteraction.hpp"
 #include "brains/ForceField.hpp"
 #include "math/CubicSpline.hpp"
+#include "nonbonded/MetallicPairCache.hpp"
 #include "types/SuttonChenAdapter.hpp"
 
 namespace OpenMD {
@@ -107,6 +108,7 @@ namespace OpenMD {
 
     RealType scRcut_;
     int np_;
+    MetallicPairCache<2> pairCache_; /**< rho and drho/dr for each pair */
     
   };
 }
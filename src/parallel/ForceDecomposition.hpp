@@ -127,6 +127,10 @@ namespace OpenMD {
 
     virtual Vector3d getAtomToGroupVectorRow(int atom1, int cg1) = 0;
     virtual Vector3d getAtomToGroupVectorColumn(int atom2, int cg2) = 0;
+    virtual RealType getGroupRadiusRow(int cg1) = 0;
+    virtual RealType getGroupRadiusColumn(int cg2) = 0;
+    virtual Vector3d& getGroupToAtomVectorRow(int atom1) = 0;
+    virtual Vector3d& getGroupToAtomVectorColumn(int atom2) = 0;
     virtual RealType& getMassFactorRow(int atom1) = 0;
     virtual RealType& getMassFactorColumn(int atom2) = 0;
 
@@ -517,8 +517,44 @@ namespace OpenMD {
                                  atomColData.flucQPos);
     }
 
+    updateGroupExtents(groupListRow_, atomRowData.position,
+                       cgRowData.position, groupToAtomRow_, groupRadiusRow_);
+    updateGroupExtents(groupListCol_, atomColData.position,
+                       cgColData.position, groupToAtomCol_, groupRadiusCol_);
+#else
+    updateGroupExtents(groupList_, snap_->atomData.position,
+                       snap_->cgData.position, groupToAtom_, groupRadius_);
 #endif      
   }
+
+  /**
+   * Finds the vector from each cutoff group's center to each of its
+   * atoms, and the bounding radius of each group.  Single-atom groups
+   * have zero extent.
+   */
+  void ForceMatrixDecomposition::updateGroupExtents(vector<vector<int> >& groupList,
+                                                    vector<Vector3d>& atomPos,
+                                                    vector<Vector3d>& groupPos,
+                                                    vector<Vector3d>& groupToAtom,
+                                                    vector<RealType>& groupRadius) {
+    groupToAtom.resize(atomPos.size());
+    groupRadius.resize(groupList.size());
+
+    for (unsigned int cg = 0; cg < groupList.size(); cg++) {
+      RealType r2max(0.0);
+      vector<int>& atoms = groupList[cg];
+
+      if (atoms.size() == 1) {
+        groupToAtom[atoms[0]] = V3Zero;
+      } else {
+        for (vector<int>::iterator i = atoms.begin(); i != atoms.end(); ++i) {
+          groupToAtom[*i] = atomPos[*i] - groupPos[cg];
+          r2max = max(r2max, groupToAtom[*i].lengthSquare());
+        }
+      }
+      groupRadius[cg] = sqrt(r2max);
+    }
+  }
   
   /* collects information obtained during the pre-pair loop onto local
    * data structures.
@@ -929,6 +965,38 @@ namespace OpenMD {
     return d;    
   }
 
+  RealType ForceMatrixDecomposition::getGroupRadiusRow(int cg1) {
+#ifdef IS_MPI
+    return groupRadiusRow_[cg1];
+#else
+    return groupRadius_[cg1];
+#endif
+  }
+
+  RealType ForceMatrixDecomposition::getGroupRadiusColumn(int cg2) {
+#ifdef IS_MPI
+    return groupRadiusCol_[cg2];
+#else
+    return groupRadius_[cg2];
+#endif
+  }
+
+  Vector3d& ForceMatrixDecomposition::getGroupToAtomVectorRow(int atom1) {
+#ifdef IS_MPI
+    return groupToAtomRow_[atom1];
+#else
+    return groupToAtom_[atom1];
+#endif
+  }
+
+  Vector3d& ForceMatrixDecomposition::getGroupToAtomVectorColumn(int atom2) {
+#ifdef IS_MPI
+    return groupToAtomCol_[atom2];
+#else
+    return groupToAtom_[atom2];
+#endif
+  }
+
   RealType& ForceMatrixDecomposition::getMassFactorRow(int atom1) {
 #ifdef IS_MPI
     return massFactorsRow[atom1];
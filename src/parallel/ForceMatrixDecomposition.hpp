@@ -77,6 +77,10 @@ namespace OpenMD {
     vector<int>& getAtomsInGroupColumn(int cg2);
     Vector3d getAtomToGroupVectorRow(int atom1, int cg1);
     Vector3d getAtomToGroupVectorColumn(int atom2, int cg2);
+    RealType getGroupRadiusRow(int cg1);
+    RealType getGroupRadiusColumn(int cg2);
+    Vector3d& getGroupToAtomVectorRow(int atom1);
+    Vector3d& getGroupToAtomVectorColumn(int atom2);
     RealType& getMassFactorRow(int atom1);
     RealType& getMassFactorColumn(int atom2);
 
@@ -102,6 +106,12 @@ namespace OpenMD {
     void unpackInteractionData(InteractionData &idat, int atom1, int atom2);
 
   private:     
+    void updateGroupExtents(vector<vector<int> >& groupList,
+                            vector<Vector3d>& atomPos,
+                            vector<Vector3d>& groupPos,
+                            vector<Vector3d>& groupToAtom,
+                            vector<RealType>& groupRadius);
+
     int nLocal_;
     int nGroups_;
     vector<int> AtomLocalToGlobal;
@@ -109,6 +119,15 @@ namespace OpenMD {
     vector<RealType> groupCutoff;
     vector<int> groupToGtype;
 
+    /**
+     * Unwrapped vectors from each atom's cutoff group center to the
+     * atom, and the largest of these in each group, refreshed by
+     * distributeData.  Molecules are kept whole, so no periodic
+     * wrapping is needed to compute them.
+     */
+    vector<Vector3d> groupToAtom_;
+    vector<RealType> groupRadius_;
+
 #ifdef IS_MPI    
     DataStorage atomRowData;
     DataStorage atomColData;
@@ -176,6 +195,11 @@ private:
     vector<RealType> massFactorsRow;
     vector<RealType> massFactorsCol;
 
+    vector<Vector3d> groupToAtomRow_;
+    vector<Vector3d> groupToAtomCol_;
+    vector<RealType> groupRadiusRow_;
+    vector<RealType> groupRadiusCol_;
+
     vector<int> regionRow;
     vector<int> regionCol;
 #endif
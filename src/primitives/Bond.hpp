@@ -98,6 +98,11 @@ namespace OpenMD {
     RealType getPotential() {
       return potential_;
     }
+
+    /** Sets the potential (used when the force is computed in a batch) */
+    void setPotential(RealType pot) {
+      potential_ = pot;
+    }
     
     Atom* getAtomA() {
       return atoms_[0];
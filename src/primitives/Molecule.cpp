@@ -62,20 +62,34 @@ namespace OpenMD {
                                    stampId_(stampId),
 				   region_(region),
 				   moleculeName_(molName),
-                                   constrainTotalCharge_(false) {
+                                   constrainTotalCharge_(false),
+                                   primitivesInArena_(false) {
   }
   
   Molecule::~Molecule() {
     
-    MemoryUtils::deletePointers(atoms_);
-    MemoryUtils::deletePointers(bonds_);
-    MemoryUtils::deletePointers(bends_);
-    MemoryUtils::deletePointers(torsions_);
-    MemoryUtils::deletePointers(inversions_);
+    if (primitivesInArena_) {
+      MemoryUtils::destroyPointers(atoms_);
+      MemoryUtils::destroyPointers(bonds_);
+      MemoryUtils::destroyPointers(bends_);
+      MemoryUtils::destroyPointers(torsions_);
+      MemoryUtils::destroyPointers(inversions_);
+      MemoryUtils::destroyPointers(cutoffGroups_);
+      // ~ConstraintPair would delete its elements, which are in the
+      // arena as well, and ConstraintElem has nothing to release:
+      constraintPairs_.clear();
+      constraintElems_.clear();
+    } else {
+      MemoryUtils::deletePointers(atoms_);
+      MemoryUtils::deletePointers(bonds_);
+      MemoryUtils::deletePointers(bends_);
+      MemoryUtils::deletePointers(torsions_);
+      MemoryUtils::deletePointers(inversions_);
+      MemoryUtils::deletePointers(cutoffGroups_);
+      MemoryUtils::deletePointers(constraintPairs_);
+      MemoryUtils::deletePointers(constraintElems_);
+    }
     MemoryUtils::deletePointers(rigidBodies_);
-    MemoryUtils::deletePointers(cutoffGroups_);
-    MemoryUtils::deletePointers(constraintPairs_);
-    MemoryUtils::deletePointers(constraintElems_);
 
     // integrableObjects_ don't own the objects
     integrableObjects_.clear();
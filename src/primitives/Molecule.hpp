@@ -140,6 +140,16 @@ namespace OpenMD{
       return constrainTotalCharge_;
     }
 
+    /**
+     * Marks the atoms, bonds, bends, torsions, inversions, cutoff
+     * groups and constraints of this molecule as living in a
+     * MemoryArena. The molecule then only runs their destructors and
+     * leaves the storage to the arena.
+     */
+    void setPrimitivesInArena(bool inArena) {
+      primitivesInArena_ = inArena;
+    }
+
     /** add an atom into this molecule */
     void addAtom(Atom* atom);
     
@@ -468,6 +478,7 @@ namespace OpenMD{
     std::string moleculeName_;
     PropertyMap properties_;
     bool constrainTotalCharge_;
+    bool primitivesInArena_;
 
   };
 
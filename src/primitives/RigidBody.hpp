@@ -214,6 +214,15 @@ namespace OpenMD{
 
     Vector3d getRefCOM() { return refCOM_; }
 
+    /**
+     * Returns the body-fixed reference orientation of a (directional)
+     * atom which belongs to this rigid body.
+     * @param index the index of the atom in rigid body's private data member atoms_
+     */
+    RotMat3x3d getAtomRefOrient(unsigned int index) {
+      return refOrients_[index];
+    }
+
   private:
     std::string name_;        
     Mat3x3d inertiaTensor_;     
@@ -57,6 +57,7 @@ namespace OpenMD {
 
     virtual void init();
     virtual void calcForces();
+    virtual bool supportsForceGroups() { return false; }
 
     RealType doRestraints(RealType scalingFactor);
     RealType getUnscaledPotential() { return unscaledPotential_; }
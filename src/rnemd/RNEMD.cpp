@@ -487,6 +487,11 @@ namespace OpenMD {
     outputSeleMan_.setSelectionSet(outputEvaluator_.evaluate());
     std::set<AtomType*> osTypes = outputSeleMan_.getSelectedAtomTypes();
     std::copy(osTypes.begin(), osTypes.end(), std::back_inserter(outputTypes_));
+
+    // map from AtomType ident to the column in the activity output:
+    outputTypeIndex_.assign(info_->getForceField()->getNAtomType(), -1);
+    for (unsigned int i = 0; i < outputTypes_.size(); i++)
+      outputTypeIndex_[outputTypes_[i]->getIdent()] = i;
     
     areaAccumulator_ = new Accumulator();
     Jc_totalAccumulator_ = new Accumulator();
@@ -503,7 +508,7 @@ namespace OpenMD {
     z.dataType = "RealType";
     z.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      z.accumulator.push_back( new Accumulator() );
+      z.accumulator.push_back( new BlockAccumulator() );
     data_[Z] = z;
     outputMap_["Z"] =  Z;
     
@@ -513,7 +518,7 @@ namespace OpenMD {
     r.dataType = "RealType";
     r.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      r.accumulator.push_back( new Accumulator() );
+      r.accumulator.push_back( new BlockAccumulator() );
     data_[R] = r;
     outputMap_["R"] =  R;
     
@@ -523,7 +528,7 @@ namespace OpenMD {
     temperature.dataType = "RealType";
     temperature.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      temperature.accumulator.push_back( new Accumulator() );
+      temperature.accumulator.push_back( new BlockAccumulator() );
     data_[TEMPERATURE] = temperature;
     outputMap_["TEMPERATURE"] =  TEMPERATURE;
     
@@ -533,7 +538,7 @@ namespace OpenMD {
     velocity.dataType = "Vector3d";
     velocity.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      velocity.accumulator.push_back( new VectorAccumulator() );
+      velocity.accumulator.push_back( new VectorBlockAccumulator() );
     data_[VELOCITY] = velocity;
     outputMap_["VELOCITY"] = VELOCITY;
     
@@ -543,7 +548,7 @@ namespace OpenMD {
     angularVelocity.dataType = "Vector3d";
     angularVelocity.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      angularVelocity.accumulator.push_back( new VectorAccumulator() );
+      angularVelocity.accumulator.push_back( new VectorBlockAccumulator() );
     data_[ANGULARVELOCITY] = angularVelocity;
     outputMap_["ANGULARVELOCITY"] = ANGULARVELOCITY;
     
@@ -553,7 +558,7 @@ namespace OpenMD {
     density.dataType = "RealType";
     density.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      density.accumulator.push_back( new Accumulator() );
+      density.accumulator.push_back( new BlockAccumulator() );
     data_[DENSITY] = density;
     outputMap_["DENSITY"] =  DENSITY;
 
@@ -566,7 +571,7 @@ namespace OpenMD {
     for (unsigned int i = 0; i < nBins_; i++) {
       activity.accumulatorArray2d[i].resize(nTypes);
       for (unsigned int j = 0 ; j < nTypes; j++) {       
-        activity.accumulatorArray2d[i][j] = new Accumulator();        
+        activity.accumulatorArray2d[i][j] = new BlockAccumulator();        
       }
     }
     data_[ACTIVITY] = (activity);
@@ -578,7 +583,7 @@ namespace OpenMD {
     eField.dataType = "Vector3d";
     eField.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      eField.accumulator.push_back( new VectorAccumulator() );
+      eField.accumulator.push_back( new VectorBlockAccumulator() );
     data_[ELECTRICFIELD] = eField;
     outputMap_["ELECTRICFIELD"] =  ELECTRICFIELD;
 
@@ -588,7 +593,7 @@ namespace OpenMD {
     ePot.dataType = "RealType";
     ePot.accumulator.reserve(nBins_);
     for (unsigned int i = 0; i < nBins_; i++) 
-      ePot.accumulator.push_back( new Accumulator() );
+      ePot.accumulator.push_back( new BlockAccumulator() );
     data_[ELECTROSTATICPOTENTIAL] = ePot;
     outputMap_["ELECTROSTATICPOTENTIAL"] =  ELECTROSTATICPOTENTIAL;
 
@@ -2637,53 +2642,25 @@ namespace OpenMD {
 
     int selei(0);
     StuntDouble* sd;
-    AtomType* atype;
 
     int binNo;
     int typeIndex(-1);
     RealType mass;
     Vector3d vel; 
     Vector3d rPos;
-    RealType KE;
-    Vector3d L;
-    Mat3x3d I;
     RealType r2;
     Vector3d eField;
 
-    vector<RealType> binMass(nBins_, 0.0);
-    vector<Vector3d> binP(nBins_, V3Zero);
-    vector<RealType> binOmega(nBins_, 0.0);
-    vector<Vector3d> binL(nBins_, V3Zero);
-    vector<Mat3x3d>  binI(nBins_);
-    vector<RealType> binKE(nBins_, 0.0);
-    vector<Vector3d> binEField(nBins_, V3Zero);    
-    vector<int> binDOF(nBins_, 0);
-    vector<int> binCount(nBins_, 0);
-    vector<int> binAtomCount(nBins_, 0);
-    vector<vector<int> > binTypeCounts;
-
-    if (outputMask_[ACTIVITY]) {
-      binTypeCounts.resize(nBins_);
-      for (unsigned int i = 0; i < nBins_; i++) {
-        binTypeCounts[i].resize( outputTypes_.size(), 0);
-      }
-    }
-    std::vector<AtomType*>::iterator at;
-    
-    // alternative approach, track all molecules instead of only those
-    // selected for scaling/swapping:
-    /*
-      SimInfo::MoleculeIterator miter;
-      vector<StuntDouble*>::iterator iiter;
-      Molecule* mol;
-      StuntDouble* sd;
-      for (mol = info_->beginMolecule(miter); mol != NULL;
-      mol = info_->nextMolecule(miter))
-      sd is essentially sd
-      for (sd = mol->beginIntegrableObject(iiter);
-      sd != NULL;
-      sd = mol->nextIntegrableObject(iiter))
-    */
+    // All of the per-bin sums live in one packed buffer (binStride_
+    // values per bin) so that they can be reduced in a single call:
+
+    unsigned int nTypes = outputMask_[ACTIVITY] ? outputTypes_.size() : 0;
+    binStride_ = BIN_TYPES + nTypes;
+    binData_.assign(nBins_ * binStride_, 0.0);
+
+    int axis = usePeriodicBoundaryConditions_ ? rnemdPrivilegedAxis_ : 0;
+    RealType binScale = usePeriodicBoundaryConditions_ ?
+      RealType(nBins_) / hmat(axis, axis) : 1.0 / binWidth_;
 
     for (sd = outputSeleMan_.beginSelected(selei); sd != NULL; 
          sd = outputSeleMan_.nextSelected(selei)) {     
@@ -2699,44 +2676,47 @@ namespace OpenMD {
         // Shift molecules by half a box to have bins start at 0
         // The modulo operator is used to wrap the case when we are 
         // beyond the end of the bins back to the beginning.
-        switch(rnemdPrivilegedAxis_) {
-        case rnemdX:
-          binNo = int(nBins_ * (pos.x() / hmat(rnemdX,rnemdX) + 0.5)) % nBins_;
-          break;
-        case rnemdY:
-          binNo = int(nBins_ * (pos.y() / hmat(rnemdY,rnemdY) + 0.5)) % nBins_;
-          break;
-        case rnemdZ:
-        default:
-          binNo = int(nBins_ * (pos.z() / hmat(rnemdZ,rnemdZ) + 0.5)) % nBins_;
-        }
+        binNo = int(binScale * pos[axis] + 0.5 * nBins_) % nBins_;
       } else {
         Vector3d rPos = pos - coordinateOrigin_;
-        binNo = int(rPos.length() / binWidth_);
+        binNo = int(rPos.length() * binScale);
       }
 
+      if (binNo < 0 || binNo >= int(nBins_)) continue;
+
+      RealType* bin = &binData_[binNo * binStride_];
+
       mass = sd->getMass();
       vel = sd->getVel();
       rPos = sd->getPos() - coordinateOrigin_;
-      KE = 0.5 * mass * vel.lengthSquare();
-      L = mass * cross(rPos, vel);
-      I = outProduct(rPos, rPos) * mass;
       r2 = rPos.lengthSquare();
-      I(0, 0) += mass * r2;
-      I(1, 1) += mass * r2;
-      I(2, 2) += mass * r2;
 
-      if (outputMask_[ELECTRICFIELD]) 
-        eField = sd->getElectricField(); // kcal/mol/e/Angstrom
+      Vector3d p = mass * vel;
+      Vector3d L = cross(rPos, p);
+
+      bin[BIN_COUNT] += 1.0;
+      bin[BIN_MASS] += mass;
+      bin[BIN_KE] += 0.5 * dot(p, vel);
+      bin[BIN_DOF] += 3.0;
+      for (int k = 0; k < 3; k++) {
+        bin[BIN_P + k] += p[k];
+        bin[BIN_L + k] += L[k];
+        for (int l = 0; l < 3; l++) 
+          bin[BIN_I + 3 * k + l] += mass * (rPos[k] * rPos[l]);
+        bin[BIN_I + 4 * k] += mass * r2;
+      }
 
-      if (outputMask_[ACTIVITY]) {
-        typeIndex = -1;
-        if (sd->isAtom()) {
-          atype = static_cast<Atom*>(sd)->getAtomType();
-          at = std::find(outputTypes_.begin(), outputTypes_.end(), atype);
-          if (at != outputTypes_.end()) {
-            typeIndex = std::distance(outputTypes_.begin(), at);
-          }
+      if (sd->isAtom()) {
+        bin[BIN_ATOMCOUNT] += 1.0;
+        if (outputMask_[ELECTRICFIELD]) {
+          eField = sd->getElectricField(); // kcal/mol/e/Angstrom
+          bin[BIN_EFIELD] += eField[0];
+          bin[BIN_EFIELD + 1] += eField[1];
+          bin[BIN_EFIELD + 2] += eField[2];
+        }
+        if (nTypes > 0) {
+          typeIndex = outputTypeIndex_[static_cast<Atom*>(sd)->getAtomType()->getIdent()];
+          if (typeIndex != -1) bin[BIN_TYPES + typeIndex] += 1.0;
         }
       }
       
@@ -2749,77 +2729,29 @@ namespace OpenMD {
       // Compute angular velocity vector (should be nearly parallel to
       // angularMomentumFluxVector
       // Vector3d aVel = cross(rProj, vProj);
-
-      if (binNo >= 0 && binNo < int(nBins_))  {
-        binCount[binNo]++;
-        binMass[binNo] += mass;
-        binP[binNo] += mass*vel;
-        binKE[binNo] += KE;
-        binI[binNo] += I;
-        binL[binNo] += L;
-        binDOF[binNo] += 3;
-
-        if (outputMask_[ACTIVITY]) {          
-          if (typeIndex != -1) binTypeCounts[binNo][typeIndex]++;
-        }
-
-        if (sd->isAtom()) {
-          binAtomCount[binNo]++;
-          if (outputMask_[ELECTRICFIELD]) 
-            binEField[binNo] += eField;
-        }
         
-        if (sd->isDirectional()) {
-          Vector3d angMom = sd->getJ();
-          Mat3x3d Ia = sd->getI();
-          if (sd->isLinear()) {
-            int i = sd->linearAxis();
-            int j = (i + 1) % 3;
-            int k = (i + 2) % 3;
-            binKE[binNo] += 0.5 * (angMom[j] * angMom[j] / Ia(j, j) + 
-                                   angMom[k] * angMom[k] / Ia(k, k));
-            binDOF[binNo] += 2;
-          } else {
-            binKE[binNo] += 0.5 * (angMom[0] * angMom[0] / Ia(0, 0) +
-                                   angMom[1] * angMom[1] / Ia(1, 1) +
-                                   angMom[2] * angMom[2] / Ia(2, 2));
-            binDOF[binNo] += 3;
-          }
+      if (sd->isDirectional()) {
+        Vector3d angMom = sd->getJ();
+        Mat3x3d Ia = sd->getI();
+        if (sd->isLinear()) {
+          int i = sd->linearAxis();
+          int j = (i + 1) % 3;
+          int k = (i + 2) % 3;
+          bin[BIN_KE] += 0.5 * (angMom[j] * angMom[j] / Ia(j, j) + 
+                                angMom[k] * angMom[k] / Ia(k, k));
+          bin[BIN_DOF] += 2.0;
+        } else {
+          bin[BIN_KE] += 0.5 * (angMom[0] * angMom[0] / Ia(0, 0) +
+                                angMom[1] * angMom[1] / Ia(1, 1) +
+                                angMom[2] * angMom[2] / Ia(2, 2));
+          bin[BIN_DOF] += 3.0;
         }
       }
     }
 
 #ifdef IS_MPI
-
-    for (unsigned int i = 0; i < nBins_; i++) {
-      
-      MPI_Allreduce(MPI_IN_PLACE, &binCount[i],
-                    1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &binMass[i],
-                    1, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, binP[i].getArrayPointer(),
-                    3, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, binL[i].getArrayPointer(),
-                    3, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, binI[i].getArrayPointer(),
-                    9, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &binKE[i],
-                    1, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &binDOF[i],
-                    1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-      MPI_Allreduce(MPI_IN_PLACE, &binAtomCount[i],
-                    1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-
-      if (outputMask_[ELECTRICFIELD]) {
-        MPI_Allreduce(MPI_IN_PLACE, binEField[i].getArrayPointer(),
-                      3, MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
-      }
-      if (outputMask_[ACTIVITY]) {
-        MPI_Allreduce(MPI_IN_PLACE, &binTypeCounts[i][0],
-                      outputTypes_.size(), MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-      }      
-    }
-    
+    MPI_Allreduce(MPI_IN_PLACE, &binData_[0], binData_.size(),
+                  MPI_REALTYPE, MPI_SUM, MPI_COMM_WORLD);
 #endif
 
     Vector3d omega;
@@ -2829,6 +2761,9 @@ namespace OpenMD {
     RealType ePot(0.0);
 
     for (unsigned int i = 0; i < nBins_; i++) {
+      RealType* bin = &binData_[i * binStride_];
+      RealType binMass = bin[BIN_MASS];
+
       if (usePeriodicBoundaryConditions_) {
         z = (((RealType)i + 0.5) / (RealType)nBins_) * hmat(rnemdPrivilegedAxis_,rnemdPrivilegedAxis_);
         binVolume = boxVolume / nBins_;
@@ -2840,26 +2775,26 @@ namespace OpenMD {
         binVolume = (4.0 * Constants::PI * (pow(router,3) - pow(rinner,3))) / 3.0;
       }
 
-      den = binMass[i] * Constants::densityConvert / binVolume;
+      den = binMass * Constants::densityConvert / binVolume;
 
       if (outputMask_[ACTIVITY]) {
-        for (unsigned int k = 0; k < outputTypes_.size(); k++) {
-          nden[k] = (binTypeCounts[i][k]  / binVolume)
+        for (unsigned int k = 0; k < nTypes; k++) {
+          nden[k] = (bin[BIN_TYPES + k]  / binVolume)
             * Constants::concentrationConvert;
         }
       }     
 
-      vel = binP[i] / binMass[i];
-      omega = binI[i].inverse() * binL[i];
+      vel = Vector3d(&bin[BIN_P]) / binMass;
+      omega = Mat3x3d(&bin[BIN_I]).inverse() * Vector3d(&bin[BIN_L]);
 
-      if (binCount[i] > 0) {
+      if (bin[BIN_COUNT] > 0) {
         // only add values if there are things to add
-        temp = 2.0 * binKE[i] / (binDOF[i] * Constants::kb *
+        temp = 2.0 * bin[BIN_KE] / (bin[BIN_DOF] * Constants::kb *
                                  Constants::energyConvert);
 
         if (outputMask_[ELECTRICFIELD]) {
-          if (binAtomCount[i] > 0 ) {
-            eField = binEField[i] / RealType(binAtomCount[i]);
+          if (bin[BIN_ATOMCOUNT] > 0 ) {
+            eField = Vector3d(&bin[BIN_EFIELD]) / bin[BIN_ATOMCOUNT];
           } else {
             eField = V3Zero;
           }
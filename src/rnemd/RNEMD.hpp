@@ -128,6 +128,23 @@ namespace OpenMD {
       rnemdZ = 2
     };
 
+    /**
+     * Offsets of the per-bin sums in the packed binData_ buffer.  The
+     * activity counts for each output type follow BIN_TYPES.
+     */
+    enum BinField {
+      BIN_COUNT = 0,
+      BIN_MASS = 1,
+      BIN_P = 2,             // 3 components
+      BIN_L = 5,             // 3 components
+      BIN_I = 8,             // 9 components
+      BIN_KE = 17,
+      BIN_DOF = 18,
+      BIN_ATOMCOUNT = 19,
+      BIN_EFIELD = 20,       // 3 components
+      BIN_TYPES = 23
+    };
+
     struct OutputData {
       string title;
       string units;
@@ -225,6 +242,9 @@ namespace OpenMD {
     OutputMapType outputMap_;
     int outputTypeCount_;
     std::vector<AtomType*> outputTypes_;
+    std::vector<int> outputTypeIndex_; // AtomType ident -> outputTypes_ index
+    std::vector<RealType> binData_;    // packed per-bin sums for collectData
+    unsigned int binStride_;
     Accumulator* areaAccumulator_;
     Accumulator* Jc_totalAccumulator_;
     Accumulator* Jc_cationAccumulator_;
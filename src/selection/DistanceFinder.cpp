@@ -44,12 +44,18 @@
 #include <mpi.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+
 #include "selection/DistanceFinder.hpp"
 #include "primitives/Molecule.hpp"
 
 namespace OpenMD {
   
-  DistanceFinder::DistanceFinder(SimInfo* info) : info_(info) {
+  DistanceFinder::DistanceFinder(SimInfo* info) : info_(info), 
+                                                  indexBuilt_(false),
+                                                  indexFrame_(-1),
+                                                  snapshot_(NULL) {
     nObjects_.push_back(info_->getNGlobalAtoms()+info_->getNGlobalRigidBodies());
     nObjects_.push_back(info_->getNGlobalBonds());
     nObjects_.push_back(info_->getNGlobalBends());
@@ -114,128 +120,72 @@ namespace OpenMD {
   }
 
   SelectionSet DistanceFinder::find(const SelectionSet& bs, RealType distance) {
-    StuntDouble* center;
-    Vector3d centerPos;
-    Snapshot* currSnapshot = info_->getSnapshotManager()->getCurrentSnapshot();
+    return find(bs, distance, -1, false);
+  }
+  
+  SelectionSet DistanceFinder::find(const SelectionSet& bs, RealType distance, int frame ) {
+    return find(bs, distance, frame, true);
+  }
+
+  SelectionSet DistanceFinder::find(const SelectionSet& bs, RealType distance,
+                                    int frame, bool useFrame) {
     SelectionSet bsResult(nObjects_);   
     assert(bsResult.size() == bs.size());
-    
-#ifdef IS_MPI
-    int mol;
-    int proc;
-    RealType data[3];
-    int worldRank;
-    MPI_Comm_rank( MPI_COMM_WORLD, &worldRank);
-#endif
 
-    
-    for (unsigned int j = 0; j < stuntdoubles_.size(); ++j) {
-      if (stuntdoubles_[j] != NULL) {
-        if (stuntdoubles_[j]->isRigidBody()) {
-          RigidBody* rb = static_cast<RigidBody*>(stuntdoubles_[j]);
-          rb->updateAtoms();
-        }
-      }
+    if (!indexBuilt_ || indexFrame_ != (useFrame ? frame : -1))
+      buildIndex(distance, frame, useFrame);
+
+    std::vector<Vector3d> centers;
+    gatherCenters(bs, frame, useFrame, centers);
+
+    // the number of cell planes that can hold a location within
+    // distance of a center:
+    Vector3i range;
+    for (int d = 0; d < 3; ++d) {
+      if (cellWidth_[d] > 0.0) 
+        range[d] = int(ceil(distance / cellWidth_[d]));
+      else
+        range[d] = nCells_[d];
     }
-            
-    SelectionSet bsTemp = bs;
-    bsTemp = bsTemp.parallelReduce();
 
-    for(int i = 0; i < bsTemp.bitsets_[STUNTDOUBLE].size(); ++i) {
-      if (bsTemp.bitsets_[STUNTDOUBLE][i]) {
-             
-#ifdef IS_MPI
-        
-        // Now, if we own stuntdouble i, we can use the position, but in
-        // parallel, we'll need to let everyone else know what that
-        // position is!
-        
-        mol = info_->getGlobalMolMembership(i);
-        proc = info_->getMolToProc(mol);        
-        
-        if (proc == worldRank) {
-          center = stuntdoubles_[i];
-          centerPos = center->getPos();
-          data[0] = centerPos.x();
-          data[1] = centerPos.y();
-          data[2] = centerPos.z();
-          MPI_Bcast(data, 3, MPI_REALTYPE, proc, MPI_COMM_WORLD);
+    int lo[3], hi[3], c[3];
+
+    for (std::size_t i = 0; i < centers.size(); ++i) {
+      Vector3d centerPos = centers[i];
+      int cell = getCell(centerPos);
+      c[2] = cell % nCells_[2];
+      c[1] = (cell / nCells_[2]) % nCells_[1];
+      c[0] = cell / (nCells_[2] * nCells_[1]);
+
+      for (int d = 0; d < 3; ++d) {
+        if (2 * range[d] + 1 >= nCells_[d]) {
+          // the search wraps all the way around this direction:
+          lo[d] = 0;
+          hi[d] = nCells_[d] - 1;
         } else {
-          MPI_Bcast(data, 3, MPI_REALTYPE, proc, MPI_COMM_WORLD);
-          centerPos = Vector3d(data);
-        }
-#else
-        center = stuntdoubles_[i];
-        centerPos = center->getPos();
-#endif               
-        for (unsigned int j = 0; j < molecules_.size(); ++j) {
-          if (molecules_[j] != NULL) {
-            Vector3d r =centerPos - molecules_[j]->getCom();
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[MOLECULE].setBitOn(j);
-            }
-          }
-        }
-        for (unsigned int j = 0; j < stuntdoubles_.size(); ++j) {
-          if (stuntdoubles_[j] != NULL) {
-            Vector3d r =centerPos - stuntdoubles_[j]->getPos();
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[STUNTDOUBLE].setBitOn(j);
-            }
-          }
+          lo[d] = c[d] - range[d];
+          hi[d] = c[d] + range[d];
         }
-        for (unsigned int j = 0; j < bonds_.size(); ++j) {
-          if (bonds_[j] != NULL) {
-            Vector3d loc = bonds_[j]->getAtomA()->getPos();
-            loc += bonds_[j]->getAtomB()->getPos();
-            loc = loc / 2.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[BOND].setBitOn(j);
-            }
-          }
-        }
-        for (unsigned int j = 0; j < bends_.size(); ++j) {
-          if (bends_[j] != NULL) {          
-            Vector3d loc = bends_[j]->getAtomA()->getPos();
-            loc += bends_[j]->getAtomB()->getPos();
-            loc += bends_[j]->getAtomC()->getPos();
-            loc = loc / 3.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[BEND].setBitOn(j);
-            }
-          }
-        }
-        for (unsigned int j = 0; j < torsions_.size(); ++j) {
-          if (torsions_[j] != NULL) {
-            Vector3d loc = torsions_[j]->getAtomA()->getPos();
-            loc += torsions_[j]->getAtomB()->getPos();
-            loc += torsions_[j]->getAtomC()->getPos();
-            loc += torsions_[j]->getAtomD()->getPos();
-            loc = loc / 4.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[TORSION].setBitOn(j);
-            }
-          }
-        }
-        for (unsigned int j = 0; j < inversions_.size(); ++j) {
-          if (inversions_[j] != NULL) {
-            Vector3d loc = inversions_[j]->getAtomA()->getPos();
-            loc += inversions_[j]->getAtomB()->getPos();
-            loc += inversions_[j]->getAtomC()->getPos();
-            loc += inversions_[j]->getAtomD()->getPos();
-            loc = loc / 4.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[INVERSION].setBitOn(j);
+      }
+
+      for (int i0 = lo[0]; i0 <= hi[0]; ++i0) {
+        int j0 = (i0 + nCells_[0]) % nCells_[0];
+        for (int i1 = lo[1]; i1 <= hi[1]; ++i1) {
+          int j1 = (i1 + nCells_[1]) % nCells_[1];
+          for (int i2 = lo[2]; i2 <= hi[2]; ++i2) {
+            int j2 = (i2 + nCells_[2]) % nCells_[2];
+            int neighbor = (j0 * nCells_[1] + j1) * nCells_[2] + j2;
+
+            for (int l = cellStart_[neighbor]; l < cellStart_[neighbor + 1]; 
+                 ++l) {
+              Location& loc = locations_[l];
+              if (bsResult.bitsets_[loc.type][loc.index]) continue;
+
+              Vector3d r = centerPos - loc.pos;
+              snapshot_->wrapVector(r);
+              if (r.length() <= distance) {
+                bsResult.bitsets_[loc.type].setBitOn(loc.index);
+              }
             }
           }
         }
@@ -243,136 +193,230 @@ namespace OpenMD {
     }
     return bsResult;
   }
-  
-  
-  SelectionSet DistanceFinder::find(const SelectionSet& bs, RealType distance, int frame ) {
-    StuntDouble * center;
-    Vector3d centerPos;
-    Snapshot* currSnapshot = info_->getSnapshotManager()->getSnapshot(frame);
-    SelectionSet bsResult(nObjects_);   
-    assert(bsResult.size() == bs.size());
 
+  void DistanceFinder::gatherCenters(const SelectionSet& bs, int frame, 
+                                     bool useFrame,
+                                     std::vector<Vector3d>& centers) {
+    SelectionSet bsTemp = bs;
+    bsTemp = bsTemp.parallelReduce();
+    OpenMDBitSet& selected = bsTemp.bitsets_[STUNTDOUBLE];
+
+    // positions of the selected centers that live on this processor:
+    std::vector<RealType> localPos;
+    for (int i = selected.firstOnBit(); i != -1; i = selected.nextOnBit(i)) {
+      if (stuntdoubles_[i] != NULL) {
+        Vector3d pos = useFrame ? stuntdoubles_[i]->getPos(frame) : 
+          stuntdoubles_[i]->getPos();
+        localPos.push_back(pos.x());
+        localPos.push_back(pos.y());
+        localPos.push_back(pos.z());
+      }
+    }
+    
 #ifdef IS_MPI
-    int mol;
-    int proc;
-    RealType data[3];
-    int worldRank;
-    MPI_Comm_rank( MPI_COMM_WORLD, &worldRank);
+    // Everyone needs every center position, so we gather them all at
+    // once rather than broadcasting them one at a time.
+    int nProc;
+    MPI_Comm_size(MPI_COMM_WORLD, &nProc);
+    
+    int nLocal = localPos.size();
+    std::vector<int> counts(nProc), displs(nProc);
+    MPI_Allgather(&nLocal, 1, MPI_INT, &counts[0], 1, MPI_INT, 
+                  MPI_COMM_WORLD);
+    
+    int nTotal = 0;
+    for (int i = 0; i < nProc; ++i) {
+      displs[i] = nTotal;
+      nTotal += counts[i];
+    }
+
+    std::vector<RealType> allPos(nTotal);
+    if (nTotal > 0) {
+      if (localPos.empty()) localPos.resize(1);
+      MPI_Allgatherv(&localPos[0], nLocal, MPI_REALTYPE, &allPos[0], 
+                     &counts[0], &displs[0], MPI_REALTYPE, MPI_COMM_WORLD);
+    }
+#else
+    std::vector<RealType>& allPos = localPos;
 #endif
- 
+
+    centers.resize(allPos.size() / 3);
+    for (std::size_t i = 0; i < centers.size(); ++i) 
+      centers[i] = Vector3d(&allPos[3*i]);
+  }
+
+  int DistanceFinder::getCell(const Vector3d& pos) {
+    if (nCells_[0] * nCells_[1] * nCells_[2] == 1) return 0;
+
+    Vector3d scaled = invHmat_ * pos;
+    int c[3];
+    for (int d = 0; d < 3; ++d) {
+      scaled[d] -= floor(scaled[d]);
+      c[d] = int(scaled[d] * nCells_[d]);
+      if (c[d] >= nCells_[d]) c[d] = nCells_[d] - 1;
+      if (c[d] < 0) c[d] = 0;
+    }
+    return (c[0] * nCells_[1] + c[1]) * nCells_[2] + c[2];
+  }
+
+  void DistanceFinder::buildIndex(RealType distance, int frame, 
+                                  bool useFrame) {
+    SnapshotManager* sman = info_->getSnapshotManager();
+    snapshot_ = useFrame ? sman->getSnapshot(frame) : 
+      sman->getCurrentSnapshot();
+
     for (unsigned int j = 0; j < stuntdoubles_.size(); ++j) {
-      if (stuntdoubles_[j] != NULL) {        
+      if (stuntdoubles_[j] != NULL) {
         if (stuntdoubles_[j]->isRigidBody()) {
           RigidBody* rb = static_cast<RigidBody*>(stuntdoubles_[j]);
-          rb->updateAtoms(frame);
+          if (useFrame) 
+            rb->updateAtoms(frame);
+          else
+            rb->updateAtoms();
         }
       }
     }
-    
-    SelectionSet bsTemp = bs;
-    bsTemp = bsTemp.parallelReduce();
-    
-    for(int i = 0; i < bsTemp.bitsets_[STUNTDOUBLE].size(); ++i) {
-      if (bsTemp.bitsets_[STUNTDOUBLE][i]) {
-        
-        // Now, if we own stuntdouble i, we can use the position, but in
-        // parallel, we'll need to let everyone else know what that
-        // position is!
-        
-#ifdef IS_MPI
-        mol = info_->getGlobalMolMembership(i);
-        proc = info_->getMolToProc(mol);
-        
-        if (proc == worldRank) {
-          center = stuntdoubles_[i];
-          centerPos = center->getPos(frame);
-          data[0] = centerPos.x();
-          data[1] = centerPos.y();
-          data[2] = centerPos.z();          
-          MPI_Bcast(data, 3, MPI_REALTYPE, proc, MPI_COMM_WORLD);
+
+    std::vector<Location> locs;
+    Location loc;
+
+    for (unsigned int j = 0; j < molecules_.size(); ++j) {
+      if (molecules_[j] != NULL) {
+        loc.type = MOLECULE;
+        loc.index = j;
+        loc.pos = useFrame ? molecules_[j]->getCom(frame) : 
+          molecules_[j]->getCom();
+        locs.push_back(loc);
+      }
+    }
+    for (unsigned int j = 0; j < stuntdoubles_.size(); ++j) {
+      if (stuntdoubles_[j] != NULL) {
+        loc.type = STUNTDOUBLE;
+        loc.index = j;
+        loc.pos = useFrame ? stuntdoubles_[j]->getPos(frame) : 
+          stuntdoubles_[j]->getPos();
+        locs.push_back(loc);
+      }
+    }
+    for (unsigned int j = 0; j < bonds_.size(); ++j) {
+      if (bonds_[j] != NULL) {
+        loc.type = BOND;
+        loc.index = j;
+        if (useFrame) {
+          loc.pos = bonds_[j]->getAtomA()->getPos(frame);
+          loc.pos += bonds_[j]->getAtomB()->getPos(frame);
         } else {
-          MPI_Bcast(data, 3, MPI_REALTYPE, proc, MPI_COMM_WORLD);
-          centerPos = Vector3d(data);
-        }
-#else
-        center = stuntdoubles_[i];
-        centerPos = center->getPos(frame);
-#endif
-        for (unsigned int j = 0; j < molecules_.size(); ++j) {
-          if (molecules_[j] != NULL) {
-            Vector3d r =centerPos - molecules_[j]->getCom(frame);
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[MOLECULE].setBitOn(j);
-            }
-          }
-        }
-        
-        for (unsigned int j = 0; j < stuntdoubles_.size(); ++j) {
-          if (stuntdoubles_[j] != NULL) {          
-            Vector3d r =centerPos - stuntdoubles_[j]->getPos(frame);
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[STUNTDOUBLE].setBitOn(j);
-            }
-          }
+          loc.pos = bonds_[j]->getAtomA()->getPos();
+          loc.pos += bonds_[j]->getAtomB()->getPos();
         }
-        for (unsigned int j = 0; j < bonds_.size(); ++j) {
-          if (bonds_[j] != NULL) {
-            Vector3d loc = bonds_[j]->getAtomA()->getPos(frame);
-            loc += bonds_[j]->getAtomB()->getPos(frame);
-            loc = loc / 2.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[BOND].setBitOn(j);
-            }
-          }
+        loc.pos /= 2.0;
+        locs.push_back(loc);
+      }
+    }
+    for (unsigned int j = 0; j < bends_.size(); ++j) {
+      if (bends_[j] != NULL) {
+        loc.type = BEND;
+        loc.index = j;
+        if (useFrame) {
+          loc.pos = bends_[j]->getAtomA()->getPos(frame);
+          loc.pos += bends_[j]->getAtomB()->getPos(frame);
+          loc.pos += bends_[j]->getAtomC()->getPos(frame);
+        } else {
+          loc.pos = bends_[j]->getAtomA()->getPos();
+          loc.pos += bends_[j]->getAtomB()->getPos();
+          loc.pos += bends_[j]->getAtomC()->getPos();
         }
-        for (unsigned int j = 0; j < bends_.size(); ++j) {
-          if (bends_[j] != NULL) {
-            Vector3d loc = bends_[j]->getAtomA()->getPos(frame);
-            loc += bends_[j]->getAtomB()->getPos(frame);
-            loc += bends_[j]->getAtomC()->getPos(frame);
-            loc = loc / 3.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[BEND].setBitOn(j);
-            }
-          }
+        loc.pos /= 3.0;
+        locs.push_back(loc);
+      }
+    }
+    for (unsigned int j = 0; j < torsions_.size(); ++j) {
+      if (torsions_[j] != NULL) {
+        loc.type = TORSION;
+        loc.index = j;
+        if (useFrame) {
+          loc.pos = torsions_[j]->getAtomA()->getPos(frame);
+          loc.pos += torsions_[j]->getAtomB()->getPos(frame);
+          loc.pos += torsions_[j]->getAtomC()->getPos(frame);
+          loc.pos += torsions_[j]->getAtomD()->getPos(frame);
+        } else {
+          loc.pos = torsions_[j]->getAtomA()->getPos();
+          loc.pos += torsions_[j]->getAtomB()->getPos();
+          loc.pos += torsions_[j]->getAtomC()->getPos();
+          loc.pos += torsions_[j]->getAtomD()->getPos();
         }
-        for (unsigned int j = 0; j < torsions_.size(); ++j) {
-          if (torsions_[j] != NULL) {
-            Vector3d loc = torsions_[j]->getAtomA()->getPos(frame);
-            loc += torsions_[j]->getAtomB()->getPos(frame);
-            loc += torsions_[j]->getAtomC()->getPos(frame);
-            loc += torsions_[j]->getAtomD()->getPos(frame);
-            loc = loc / 4.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[TORSION].setBitOn(j);
-            }
-          }
+        loc.pos /= 4.0;
+        locs.push_back(loc);
+      }
+    }
+    for (unsigned int j = 0; j < inversions_.size(); ++j) {
+      if (inversions_[j] != NULL) {
+        loc.type = INVERSION;
+        loc.index = j;
+        if (useFrame) {
+          loc.pos = inversions_[j]->getAtomA()->getPos(frame);
+          loc.pos += inversions_[j]->getAtomB()->getPos(frame);
+          loc.pos += inversions_[j]->getAtomC()->getPos(frame);
+          loc.pos += inversions_[j]->getAtomD()->getPos(frame);
+        } else {
+          loc.pos = inversions_[j]->getAtomA()->getPos();
+          loc.pos += inversions_[j]->getAtomB()->getPos();
+          loc.pos += inversions_[j]->getAtomC()->getPos();
+          loc.pos += inversions_[j]->getAtomD()->getPos();
         }
-        for (unsigned int j = 0; j < inversions_.size(); ++j) {
-          if (inversions_[j] != NULL) {
-            Vector3d loc = inversions_[j]->getAtomA()->getPos(frame);
-            loc += inversions_[j]->getAtomB()->getPos(frame);
-            loc += inversions_[j]->getAtomC()->getPos(frame);
-            loc += inversions_[j]->getAtomD()->getPos(frame);
-            loc = loc / 4.0;
-            Vector3d r = centerPos - loc;
-            currSnapshot->wrapVector(r);
-            if (r.length() <= distance) {
-              bsResult.bitsets_[INVERSION].setBitOn(j);
-            }
-          }
-        }      
+        loc.pos /= 4.0;
+        locs.push_back(loc);
       }
     }
-    return bsResult;    
+
+    // Size the cells from the first search distance of this frame.
+    // The width of a cell is measured between its lattice planes, so
+    // this also works for non-orthorhombic boxes.
+    Mat3x3d hmat = snapshot_->getHmat();
+    invHmat_ = snapshot_->getInvHmat();
+    RealType volume = snapshot_->getVolume();
+    Vector3d planeSpacing(0.0);
+
+    for (int d = 0; d < 3; ++d) {
+      nCells_[d] = 1;
+      if (snapshot_->frameData.usePBC && volume > 0.0) {
+        Vector3d a = hmat.getColumn((d + 1) % 3);
+        Vector3d b = hmat.getColumn((d + 2) % 3);
+        planeSpacing[d] = volume / cross(a, b).length();
+        if (distance > 0.0) 
+          nCells_[d] = std::max(1, int(planeSpacing[d] / distance));
+      }
+    }
+
+    // don't build more cells than there are locations to put in them:
+    int maxCells = std::max(1, int(locs.size()));
+    while (nCells_[0] * nCells_[1] * nCells_[2] > maxCells) {
+      int d = 0;
+      if (nCells_[1] > nCells_[d]) d = 1;
+      if (nCells_[2] > nCells_[d]) d = 2;
+      nCells_[d] = (nCells_[d] + 1) / 2;
+    }
+
+    for (int d = 0; d < 3; ++d) 
+      cellWidth_[d] = planeSpacing[d] / nCells_[d];
+
+    // counting sort of the locations into their cells:
+    int nCells = nCells_[0] * nCells_[1] * nCells_[2];
+    std::vector<int> cellOf(locs.size());
+    cellStart_.assign(nCells + 1, 0);
+    for (std::size_t l = 0; l < locs.size(); ++l) {
+      cellOf[l] = getCell(locs[l].pos);
+      cellStart_[cellOf[l] + 1]++;
+    }
+    for (int c = 0; c < nCells; ++c) 
+      cellStart_[c + 1] += cellStart_[c];
+
+    std::vector<int> next(cellStart_.begin(), cellStart_.end() - 1);
+    locations_.resize(locs.size());
+    for (std::size_t l = 0; l < locs.size(); ++l) 
+      locations_[next[cellOf[l]]++] = locs[l];
+
+    indexFrame_ = useFrame ? frame : -1;
+    indexBuilt_ = true;
   }
 }
-  
@@ -50,6 +50,18 @@
 #include "primitives/Inversion.hpp"
 namespace OpenMD {
 
+  /**
+   * @class DistanceFinder DistanceFinder.hpp "selection/DistanceFinder.hpp"
+   * @brief Finds the objects within a distance of a set of centers.
+   *
+   * The locations of all local objects (StuntDoubles, molecular
+   * centers of mass, and the centroids of bonds, bends, torsions and
+   * inversions) are binned into a periodic cell list the first time
+   * a frame is searched.  The list is reused by every "within" clause
+   * until reset() is called, so each search costs O(N) instead of
+   * O(N*M) for M centers.  In parallel, all of the center positions
+   * are shared with a single gather.
+   */
   class DistanceFinder {
   public:
     DistanceFinder(SimInfo* si);
@@ -57,6 +69,9 @@ namespace OpenMD {
     SelectionSet find(const SelectionSet& bs, RealType distance);
     SelectionSet find(const SelectionSet& bs, RealType distance, int frame);
 
+    /** Discards the cell list (call when the positions have changed) */
+    void reset() { indexBuilt_ = false; }
+
     SimInfo* info_;
     std::vector<StuntDouble*> stuntdoubles_;
     std::vector<Bond*> bonds_;
@@ -65,7 +80,30 @@ namespace OpenMD {
     std::vector<Inversion*> inversions_;
     std::vector<Molecule*> molecules_;
     vector<int> nObjects_;
-        
+
+  private:
+    /** A located object: its SelectionType, global index and position */
+    struct Location {
+      int type;
+      int index;
+      Vector3d pos;
+    };
+
+    SelectionSet find(const SelectionSet& bs, RealType distance, 
+                      int frame, bool useFrame);
+    void buildIndex(RealType distance, int frame, bool useFrame);
+    void gatherCenters(const SelectionSet& bs, int frame, bool useFrame,
+                       std::vector<Vector3d>& centers);
+    int getCell(const Vector3d& pos);
+
+    bool indexBuilt_;
+    int indexFrame_;
+    Snapshot* snapshot_;
+    Mat3x3d invHmat_;
+    Vector3i nCells_;
+    Vector3d cellWidth_;          /**< distance between cell planes */
+    std::vector<int> cellStart_;  /**< locations_ offsets of each cell */
+    std::vector<Location> locations_;  /**< sorted by cell */
   };
 
 }
@@ -180,7 +180,7 @@ namespace OpenMD {
     vector<int> bsSize = bs.size();
    
     for (unsigned int pc = pcStart; pc < code.size(); ++pc) {
-      Token instruction = code[pc];
+      const Token& instruction = code[pc];
 
       switch (instruction.tok) {
       case Token::expressionBegin:
@@ -226,6 +226,9 @@ namespace OpenMD {
       case Token::index:
           stack.push(indexInstruction(instruction.value));
         break;
+      case Token::precomputed:
+          stack.push(boost::any_cast<SelectionSet>(instruction.value));
+        break;
       case Token::identifier:
           stack.push(lookupValue(boost::any_cast<std::string>(instruction.value)));
         break;
@@ -254,7 +257,7 @@ namespace OpenMD {
     std::stack<SelectionSet> stack; 
    
     for (unsigned int pc = pcStart; pc < code.size(); ++pc) {
-      Token instruction = code[pc];
+      const Token& instruction = code[pc];
 
       switch (instruction.tok) {
       case Token::expressionBegin:
@@ -300,6 +303,9 @@ namespace OpenMD {
       case Token::index:
         stack.push(indexInstruction(instruction.value));
         break;
+      case Token::precomputed:
+        stack.push(boost::any_cast<SelectionSet>(instruction.value));
+        break;
       case Token::identifier:
         stack.push(lookupValue(boost::any_cast<std::string>(instruction.value)));
         break;
@@ -337,6 +343,17 @@ namespace OpenMD {
     Molecule::RigidBodyIterator rbIter;
     RigidBody* rb;
 
+    if (property != Token::mass && property != Token::charge) {
+      // positional properties are scanned straight from the snapshot
+      comparePositions(bs, info->getSnapshotManager()->getCurrentSnapshot(),
+                       property, comparator, comparisonValue);
+      for (mol = info->beginMolecule(mi); mol != NULL; 
+           mol = info->nextMolecule(mi)) {
+        compareProperty(mol, bs, property, comparator, comparisonValue);
+      }
+      return bs.parallelReduce();
+    }
+
     for (mol = info->beginMolecule(mi); mol != NULL; 
          mol = info->nextMolecule(mi)) {
 
@@ -369,6 +386,18 @@ namespace OpenMD {
     Molecule::RigidBodyIterator rbIter;
     RigidBody* rb;
 
+    if (property != Token::mass && property != Token::charge) {
+      // positional properties are scanned straight from the snapshot
+      comparePositions(bs, info->getSnapshotManager()->getSnapshot(frame),
+                       property, comparator, comparisonValue);
+      for (mol = info->beginMolecule(mi); mol != NULL; 
+           mol = info->nextMolecule(mi)) {
+        compareProperty(mol, bs, property, comparator, comparisonValue, 
+                        frame);
+      }
+      return bs.parallelReduce();
+    }
+
     for (mol = info->beginMolecule(mi); mol != NULL; 
          mol = info->nextMolecule(mi)) {
 
@@ -703,6 +732,111 @@ namespace OpenMD {
   }
   
   
+  static inline bool compareValue(RealType value, int comparator, 
+                                  float comparisonValue) {
+    switch (comparator) {
+    case Token::opLT:
+      return value < comparisonValue;
+    case Token::opLE:
+      return value <= comparisonValue;
+    case Token::opGE:
+      return value >= comparisonValue;
+    case Token::opGT:
+      return value > comparisonValue;
+    case Token::opEQ:
+      return value == comparisonValue;
+    case Token::opNE:
+      return value != comparisonValue;
+    }
+    return false;
+  }
+
+  void SelectionEvaluator::buildLocalToGlobal() {
+    if (atomGlobalIndex_.size() == info->getNAtoms() &&
+        rigidBodyGlobalIndex_.size() == info->getNRigidBodies()) return;
+
+    atomGlobalIndex_.resize(info->getNAtoms());
+    rigidBodyGlobalIndex_.resize(info->getNRigidBodies());
+
+    SimInfo::MoleculeIterator mi;
+    Molecule* mol;
+    Molecule::AtomIterator ai;
+    Atom* atom;
+    Molecule::RigidBodyIterator rbIter;
+    RigidBody* rb;
+
+    for (mol = info->beginMolecule(mi); mol != NULL; 
+         mol = info->nextMolecule(mi)) {
+      for(atom = mol->beginAtom(ai); atom != NULL; atom = mol->nextAtom(ai)) {
+        atomGlobalIndex_[atom->getLocalIndex()] = atom->getGlobalIndex();
+      }
+      for (rb = mol->beginRigidBody(rbIter); rb != NULL; 
+           rb = mol->nextRigidBody(rbIter)) {
+        rigidBodyGlobalIndex_[rb->getLocalIndex()] = rb->getGlobalIndex();
+      }
+    }
+  }
+
+  void SelectionEvaluator::comparePositions(SelectionSet& bs, Snapshot* snap,
+                                            int property, int comparator,
+                                            float comparisonValue) {
+    buildLocalToGlobal();
+
+    bool wrapped = (property == Token::wrappedX || 
+                    property == Token::wrappedY ||
+                    property == Token::wrappedZ);
+    int component = -1;
+    switch (property) {
+    case Token::x:
+    case Token::wrappedX:
+      component = 0;
+      break;
+    case Token::y:
+    case Token::wrappedY:
+      component = 1;
+      break;
+    case Token::z:
+    case Token::wrappedZ:
+      component = 2;
+      break;
+    case Token::r:
+      break;
+    default:
+      unrecognizedAtomProperty(property);
+      return;
+    }
+
+    std::vector<RealType> values;
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<Vector3d>& positions = (pass == 0) ? 
+        snap->atomData.position : snap->rigidbodyData.position;
+      std::vector<int>& globalIndex = (pass == 0) ? 
+        atomGlobalIndex_ : rigidBodyGlobalIndex_;
+      int n = globalIndex.size();
+
+      // first extract the property, then compare in a separate sweep
+      values.resize(n);
+      if (wrapped) {
+        for (int i = 0; i < n; ++i) {
+          Vector3d pos = positions[i];
+          snap->wrapVector(pos);
+          values[i] = pos[component];
+        }
+      } else if (component >= 0) {
+        for (int i = 0; i < n; ++i) 
+          values[i] = positions[i][component];
+      } else {
+        for (int i = 0; i < n; ++i) 
+          values[i] = positions[i].length();
+      }
+
+      for (int i = 0; i < n; ++i) {
+        if (compareValue(values[i], comparator, comparisonValue))
+          bs.bitsets_[STUNTDOUBLE].setBitOn(globalIndex[i]);
+      }
+    }
+  }
+  
   void SelectionEvaluator::withinInstruction(const Token& instruction, 
                                              SelectionSet& bs){
     
@@ -791,9 +925,12 @@ namespace OpenMD {
     assert(statement.size() >= 3);
     
     std::string variable = boost::any_cast<std::string>(statement[1].value);
-    
-    variables.insert(VariablesType::value_type(variable, 
-                                               expression(statement, 2)));
+
+    // definitions are fixed once made, so there is no need to
+    // evaluate them again on later passes through the script:
+    if (variables.find(variable) == variables.end())
+      variables.insert(VariablesType::value_type(variable, 
+                                                 expression(statement, 2)));
   }
   
 
@@ -829,11 +966,117 @@ namespace OpenMD {
   }
 
   void SelectionEvaluator::select(SelectionSet& bs){
-    bs = expression(statement, 1);
+    bs = expression(compiledStatement(), 0);
   }
 
   void SelectionEvaluator::select(SelectionSet& bs, int frame){
-    bs = expression(statement, 1, frame);
+    bs = expression(compiledStatement(), 0, frame);
+  }
+
+  std::vector<Token>& SelectionEvaluator::compiledStatement() {
+    // the dispatch loop has already advanced the program counter
+    unsigned int statementIndex = pc - 1;
+    std::map<unsigned int, std::vector<Token> >::iterator i;
+
+    i = compiled_.find(statementIndex);
+    if (i == compiled_.end()) {
+      i = compiled_.insert(std::make_pair(statementIndex,
+                                          compileExpression(statement, 1))).first;
+    }
+    return i->second;
+  }
+
+  std::vector<Token> SelectionEvaluator::compileExpression(const std::vector<Token>& code,
+                                                           int pcStart) {
+    std::vector<Token> program;
+
+    // For each operand on the (postfix) evaluation stack: where its
+    // tokens begin in program, and whether it is static.
+    std::vector<std::pair<std::size_t, bool> > operands;
+
+    for (unsigned int pc = pcStart; pc < code.size(); ++pc) {
+      const Token& instruction = code[pc];
+
+      switch (instruction.tok) {
+      case Token::expressionBegin:
+      case Token::expressionEnd:
+        break;
+      case Token::opOr:
+      case Token::opAnd:
+        if (operands.size() < 2) {
+          evalError("atom expression compiler error - stack underflow");
+          return program;
+        } else {
+          std::pair<std::size_t, bool> b = operands.back();
+          operands.pop_back();
+          std::pair<std::size_t, bool>& a = operands.back();
+          // a static operand combined with a dynamic one is as large
+          // as that static sub-expression gets, so evaluate it now:
+          if (b.second && !a.second) 
+            foldStatic(program, b.first, program.size());
+          else if (a.second && !b.second)
+            foldStatic(program, a.first, b.first);
+          a.second = a.second && b.second;
+          program.push_back(instruction);
+        }
+        break;
+      case Token::opNot:
+        program.push_back(instruction);
+        break;
+      case Token::within:
+        if (operands.empty()) {
+          evalError("atom expression compiler error - stack underflow");
+          return program;
+        }
+        if (operands.back().second) 
+          foldStatic(program, operands.back().first, program.size());
+        operands.back().second = false;
+        program.push_back(instruction);
+        break;
+      default:
+        operands.push_back(std::make_pair(program.size(), 
+                                          isStaticLeaf(instruction)));
+        program.push_back(instruction);
+      }
+    }
+
+    if (operands.size() == 1 && operands.back().second)
+      foldStatic(program, operands.back().first, program.size());
+
+    return program;
+  }
+
+  void SelectionEvaluator::foldStatic(std::vector<Token>& program, 
+                                      std::size_t begin, std::size_t end) {
+    if (end - begin == 1 && program[begin].tok == Token::precomputed) return;
+
+    std::vector<Token> sub(program.begin() + begin, program.begin() + end);
+    Token folded(Token::precomputed, boost::any(expression(sub, 0)));
+
+    program.erase(program.begin() + begin, program.begin() + end);
+    program.insert(program.begin() + begin, folded);
+  }
+
+  bool SelectionEvaluator::isStaticLeaf(const Token& token) {
+    switch (token.tok) {
+    case Token::all:
+    case Token::none:
+    case Token::name:
+    case Token::index:
+    case Token::identifier:
+    case Token::precomputed:
+      return true;
+    case Token::opLT:
+    case Token::opLE:
+    case Token::opGE:
+    case Token::opGT:
+    case Token::opEQ:
+    case Token::opNE:
+      // masses never change; charges and positions may
+      return token.intValue == Token::mass;
+    default:
+      return false;
+    }
   }
   
   SelectionSet SelectionEvaluator::lookupValue(const std::string& variable){
@@ -873,6 +1116,7 @@ namespace OpenMD {
 
   void SelectionEvaluator::clearDefinitionsAndLoadPredefined() {
     variables.clear();
+    compiled_.clear();
     //load predefine
     //predefine();
   }
@@ -884,6 +1128,8 @@ namespace OpenMD {
 
   SelectionSet SelectionEvaluator::evaluate() {
     SelectionSet bs = createSelectionSets();
+    // positions may have changed since the last evaluation:
+    distanceFinder.reset();
     if (isLoaded_) {
       pc = 0;
       instructionDispatchLoop(bs);
@@ -893,6 +1139,8 @@ namespace OpenMD {
 
   SelectionSet SelectionEvaluator::evaluate(int frame) {
     SelectionSet bs = createSelectionSets();
+    // positions may have changed since the last evaluation:
+    distanceFinder.reset();
     if (isLoaded_) {
       pc = 0;
       instructionDispatchLoop(bs, frame);
@@ -171,6 +171,28 @@ namespace OpenMD {
     SelectionSet expression(const std::vector<Token>& tokens, int pc);
     SelectionSet expression(const std::vector<Token>& tokens, int pc, int frame);
 
+    /**
+     * Returns the current select statement with its static
+     * sub-expressions (names, indices, masses, defined sets) folded
+     * into precomputed selection sets.  The folding is done the first
+     * time a statement is evaluated, so later evaluations only redo
+     * the dynamic leaves.
+     */
+    std::vector<Token>& compiledStatement();
+    std::vector<Token> compileExpression(const std::vector<Token>& code, 
+                                         int pcStart);
+    void foldStatic(std::vector<Token>& program, std::size_t begin, 
+                    std::size_t end);
+    bool isStaticLeaf(const Token& token);
+
+    /**
+     * Compares a position-derived property of every local atom and
+     * rigid body by scanning the DataStorage arrays of a snapshot.
+     */
+    void comparePositions(SelectionSet& bs, Snapshot* snap, int property, 
+                          int comparator, float comparisonValue);
+    void buildLocalToGlobal();
+
     SelectionSet lookupValue(const std::string& variable);
 
     SelectionSet hull();
@@ -249,6 +271,10 @@ namespace OpenMD {
     typedef std::map<std::string, boost::any > VariablesType;
     VariablesType variables;
 
+    std::map<unsigned int, std::vector<Token> > compiled_; /**< by statement */
+    std::vector<int> atomGlobalIndex_;       /**< by local atom index */
+    std::vector<int> rigidBodyGlobalIndex_;  /**< by local rigid body index */
+
     bool isDynamic_;
     bool isLoaded_;
     bool hasSurfaceArea_;
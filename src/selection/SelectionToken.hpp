@@ -143,6 +143,9 @@ namespace OpenMD {
     const static int name         = expression | 11;
     const static int hull         = expression | dynamic | 12;
     const static int alphahull    = expression | dynamic | 13;
+    // a static sub-expression that SelectionEvaluator has already
+    // evaluated; the value holds the resulting SelectionSet
+    const static int precomputed  = expression | 14;
 
     // miguel 2005 01 01
     // these are used to demark the beginning and end of expressions
@@ -80,6 +80,10 @@ namespace OpenMD {
     void setPolynomial(DoublePolynomial p) {
       polynomial_ = p;
     }
+
+    const DoublePolynomial& getPolynomial() {
+      return polynomial_;
+    }
     
     virtual void calcForce(RealType cosPhi, RealType& V, RealType& dVdCosPhi) {
       V = polynomial_.evaluate(cosPhi);
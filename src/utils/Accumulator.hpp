@@ -187,7 +187,7 @@ namespace OpenMD {
      *   x - c <= true mean <= x + c
      *
      */
-    void get95percentConfidenceInterval(ResultType &ret) {
+    virtual void get95percentConfidenceInterval(ResultType &ret) {
       assert(Count_ != 0);
       RealType sd;
       this->getStdDev(sd);
@@ -217,7 +217,7 @@ namespace OpenMD {
     /**
      * Accumulate another value
      */
-    void add(ElementType const& val) {
+    virtual void add(ElementType const& val) {
       Count_++;
       RealType len(0.0);
       for (unsigned int i =0; i < 3; i++) {
@@ -243,7 +243,7 @@ namespace OpenMD {
     /**
      * reset the Accumulator to the empty state
      */
-    void clear() {
+    virtual void clear() {
       Count_   = 0;
       Avg_     = V3Zero;
       Avg2_    = V3Zero;
@@ -313,7 +313,7 @@ namespace OpenMD {
      *   x - c <= true mean <= x + c
      *
      */
-    void get95percentConfidenceInterval(ResultType &ret) {
+    virtual void get95percentConfidenceInterval(ResultType &ret) {
       assert(Count_ != 0);
       ResultType sd;
       this->getStdDev(sd);
@@ -401,6 +401,136 @@ namespace OpenMD {
 
   };
 
+  /**
+   * Accumulator that also keeps running statistics of block averages
+   * over blockLength consecutive samples.  Samples taken close together
+   * in a time series are correlated, so the confidence interval is
+   * computed from the (nearly independent) block means once two or more
+   * blocks have been completed.  No individual samples are stored.
+   */
+  class BlockAccumulator : public Accumulator {
+
+  public:
+    BlockAccumulator(size_t blockLength = 10) : Accumulator(),
+                                                blockLength_(blockLength) {
+      this->clearBlocks();
+    }
+
+    virtual void add(RealType const& val) {
+      Accumulator::add(val);
+      blockSum_ += val;
+      if (++blockCount_ == blockLength_) {
+        RealType blockAvg = blockSum_ / RealType(blockLength_);
+        nBlocks_++;
+        BlockAvg_  += (blockAvg            - BlockAvg_ ) / nBlocks_;
+        BlockAvg2_ += (blockAvg * blockAvg - BlockAvg2_) / nBlocks_;
+        blockSum_ = 0.0;
+        blockCount_ = 0;
+      }
+    }
+
+    virtual void clear() {
+      Accumulator::clear();
+      this->clearBlocks();
+    }
+
+    /**
+     * return the 95% confidence interval of the mean estimated from
+     * the block averages (or from the raw samples when fewer than two
+     * blocks are complete).
+     */
+    virtual void get95percentConfidenceInterval(RealType &ret) {
+      if (nBlocks_ < 2) {
+        Accumulator::get95percentConfidenceInterval(ret);
+        return;
+      }
+      RealType var = (BlockAvg2_ - BlockAvg_ * BlockAvg_) * nBlocks_ /
+        RealType(nBlocks_ - 1);
+      if (var < 0) var = 0;
+      ret = 1.960 * sqrt(var / RealType(nBlocks_));
+      return;
+    }
+
+  private:
+    void clearBlocks() {
+      blockSum_ = 0.0;
+      blockCount_ = 0;
+      nBlocks_ = 0;
+      BlockAvg_ = 0.0;
+      BlockAvg2_ = 0.0;
+    }
+
+    size_t blockLength_;
+    size_t blockCount_;
+    size_t nBlocks_;
+    RealType blockSum_;
+    RealType BlockAvg_;
+    RealType BlockAvg2_;
+  };
+
+  /**
+   * VectorAccumulator that estimates its confidence intervals from
+   * block averages (see BlockAccumulator).
+   */
+  class VectorBlockAccumulator : public VectorAccumulator {
+
+  public:
+    VectorBlockAccumulator(size_t blockLength = 10) : VectorAccumulator(),
+                                                      blockLength_(blockLength) {
+      this->clearBlocks();
+    }
+
+    virtual void add(Vector3d const& val) {
+      VectorAccumulator::add(val);
+      blockSum_ += val;
+      if (++blockCount_ == blockLength_) {
+        Vector3d blockAvg = blockSum_ / RealType(blockLength_);
+        nBlocks_++;
+        for (unsigned int i = 0; i < 3; i++) {
+          BlockAvg_[i]  += (blockAvg[i]               - BlockAvg_[i] ) / nBlocks_;
+          BlockAvg2_[i] += (blockAvg[i] * blockAvg[i] - BlockAvg2_[i]) / nBlocks_;
+        }
+        blockSum_ = V3Zero;
+        blockCount_ = 0;
+      }
+    }
+
+    virtual void clear() {
+      VectorAccumulator::clear();
+      this->clearBlocks();
+    }
+
+    virtual void get95percentConfidenceInterval(Vector3d &ret) {
+      if (nBlocks_ < 2) {
+        VectorAccumulator::get95percentConfidenceInterval(ret);
+        return;
+      }
+      for (unsigned int i = 0; i < 3; i++) {
+        RealType var = (BlockAvg2_[i] - BlockAvg_[i] * BlockAvg_[i]) *
+          nBlocks_ / RealType(nBlocks_ - 1);
+        if (var < 0) var = 0;
+        ret[i] = 1.960 * sqrt(var / RealType(nBlocks_));
+      }
+      return;
+    }
+
+  private:
+    void clearBlocks() {
+      blockSum_ = V3Zero;
+      blockCount_ = 0;
+      nBlocks_ = 0;
+      BlockAvg_ = V3Zero;
+      BlockAvg2_ = V3Zero;
+    }
+
+    size_t blockLength_;
+    size_t blockCount_;
+    size_t nBlocks_;
+    Vector3d blockSum_;
+    Vector3d BlockAvg_;
+    Vector3d BlockAvg2_;
+  };
+
   class PotVecAccumulator : public BaseAccumulator {
 
     typedef potVec ElementType;
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2005 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+
+#include "utils/MemoryArena.hpp"
+
+namespace OpenMD {
+
+  // alignment suitable for any fundamental type (long double, SSE
+  // vectors of RealType)
+  static const std::size_t arenaAlignment = 16;
+
+  MemoryArena::MemoryArena(std::size_t chunkSize) : 
+    chunkSize_(chunkSize), current_(NULL), remaining_(0), bytesUsed_(0),
+    bytesReserved_(0) {
+  }
+
+  MemoryArena::~MemoryArena() {
+    clear();
+  }
+
+  void* MemoryArena::allocate(std::size_t bytes) {
+    std::size_t padded = (bytes + arenaAlignment - 1) & ~(arenaAlignment - 1);
+
+    if (padded > remaining_) {
+      // oversized requests get a chunk of their own
+      std::size_t size = padded > chunkSize_ ? padded : chunkSize_;
+      current_ = static_cast<char*>(::operator new(size));
+      chunks_.push_back(current_);
+      remaining_ = size;
+      bytesReserved_ += size;
+    }
+
+    void* p = current_;
+    current_ += padded;
+    remaining_ -= padded;
+    bytesUsed_ += padded;
+    return p;
+  }
+
+  void MemoryArena::clear() {
+    for (std::vector<char*>::iterator i = chunks_.begin(); 
+         i != chunks_.end(); ++i) {
+      ::operator delete(*i);
+    }
+    chunks_.clear();
+    current_ = NULL;
+    remaining_ = 0;
+    bytesUsed_ = 0;
+    bytesReserved_ = 0;
+  }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2005 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+/**
+ * @file MemoryArena.hpp
+ * @version 1.0
+ */ 
+
+#ifndef UTILS_MEMORYARENA_HPP
+#define UTILS_MEMORYARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenMD {
+
+  /**
+   * @class MemoryArena MemoryArena.hpp "utils/MemoryArena.hpp"
+   * A chunked bump allocator for long-lived objects that are created
+   * in bulk and released together.  Objects are placement-constructed
+   * in storage returned by allocate(), so consecutive allocations are
+   * contiguous in creation order.  The arena never runs destructors:
+   * the owner of an object must call its destructor explicitly before
+   * the arena goes away.
+   */
+  class MemoryArena {
+  public:
+    MemoryArena(std::size_t chunkSize = 1 << 20);
+    ~MemoryArena();
+
+    /**
+     * Returns storage for an object of the given size, aligned for
+     * any fundamental type.
+     */
+    void* allocate(std::size_t bytes);
+
+    /** Releases all chunks.  Objects in the arena become invalid. */
+    void clear();
+
+    /** Returns the number of bytes handed out by allocate() */
+    std::size_t getBytesUsed() { return bytesUsed_; }
+
+    /** Returns the number of bytes reserved from the heap */
+    std::size_t getBytesReserved() { return bytesReserved_; }
+
+  private:
+    MemoryArena(const MemoryArena&);
+    MemoryArena& operator=(const MemoryArena&);
+
+    std::size_t chunkSize_;
+    std::vector<char*> chunks_;
+    char* current_;
+    std::size_t remaining_;
+    std::size_t bytesUsed_;
+    std::size_t bytesReserved_;
+  };
+
+}
+#endif //UTILS_MEMORYARENA_HPP
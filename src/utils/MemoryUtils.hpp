@@ -64,6 +64,25 @@ namespace OpenMD {
       
       container.clear();
     }
+
+    /**
+     * Runs the destructors of objects whose storage is owned by
+     * something else (e.g. a MemoryArena), without freeing it.
+     */
+    template<typename ContainterType>
+    static void destroyPointers(ContainterType& container) {
+      for (typename ContainterType::iterator i = container.begin(); 
+           i != container.end(); ++i) {
+	destroy(*i);
+      }
+      
+      container.clear();
+    }
+
+    template<typename T>
+    static void destroy(T* p) {
+      p->~T();
+    }
   };
 }
 #endif //UTILS_MEMORYUTILS_HPP
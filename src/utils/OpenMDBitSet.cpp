@@ -47,50 +47,98 @@
 #include <algorithm>
 #include <cassert>
 #include <string>
-#include <iterator>
 
 #include "utils/OpenMDBitSet.hpp"
-#include "utils/Algorithm.hpp"
 
 namespace OpenMD {
-  int OpenMDBitSet::countBits() {
-#ifdef __RWSTD    
-    //For the compiler(Sun, MSVC6.0) binding with RougeWave STL Library, we need to use old-style
-    // std::count which is error-prone.
+
+  static inline int popCount(OpenMDBitSet::WordType w) {
+#ifdef __GNUC__
+    return __builtin_popcountll(w);
+#else
     int count = 0;
-    std::count(bitset_.begin(), bitset_.end(), true, count);
+    for (; w; ++count) w &= w - 1;
     return count;
+#endif
+  }
+
+  /** index of the lowest set bit of a non-zero word */
+  static inline int lowestBit(OpenMDBitSet::WordType w) {
+#ifdef __GNUC__
+    return __builtin_ctzll(w);
 #else
-    return std::count(bitset_.begin(), bitset_.end(), true);
+    int index = 0;
+    while (!(w & 1)) { w >>= 1; ++index; }
+    return index;
 #endif
   }
 
+  /** word with bits [from, to) on, 0 <= from < to <= 64 */
+  static inline OpenMDBitSet::WordType rangeMask(int from, int to) {
+    OpenMDBitSet::WordType all = ~OpenMDBitSet::WordType(0);
+    OpenMDBitSet::WordType high = (to == 64) ? all : ~(all << to);
+    return high & (all << from);
+  }
+
+  void OpenMDBitSet::clearUnusedBits() {
+    int used = nbits_ % bitsPerWord;
+    if (used != 0) 
+      words_.back() &= rangeMask(0, used);
+  }
+
+  int OpenMDBitSet::countBits() const {
+    int count = 0;
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      count += popCount(words_[i]);
+    return count;
+  }
+
   void OpenMDBitSet::flip(int fromIndex, int toIndex) {
     assert(fromIndex <= toIndex);
     assert(fromIndex >=0);
     assert(toIndex <= size());
-    std::vector<bool>::iterator first = bitset_.begin() + fromIndex;
-    std::vector<bool>::iterator last = bitset_.begin() + toIndex;
+    if (fromIndex == toIndex) return;
+
+    int first = wordIndex(fromIndex);
+    int last = wordIndex(toIndex - 1);
+    int lo = fromIndex % bitsPerWord;
+    int hi = (toIndex - 1) % bitsPerWord + 1;
 
-    std::transform(first, last, first, std::logical_not<bool>());
-        
+    if (first == last) {
+      words_[first] ^= rangeMask(lo, hi);
+      return;
+    }
+    words_[first] ^= rangeMask(lo, bitsPerWord);
+    for (int i = first + 1; i < last; ++i) 
+      words_[i] = ~words_[i];
+    words_[last] ^= rangeMask(0, hi);
   }
 
-  OpenMDBitSet OpenMDBitSet::get(int fromIndex, int toIndex) {
+  OpenMDBitSet OpenMDBitSet::get(int fromIndex, int toIndex) const {
     assert(fromIndex <= toIndex);
     assert(fromIndex >=0);
     assert(toIndex <= size());
-    std::vector<bool>::iterator first = bitset_.begin() + fromIndex;
-    std::vector<bool>::iterator last = bitset_.begin() + toIndex;
 
-    OpenMDBitSet result;
-    std::copy(first, last, std::back_inserter(result.bitset_));
+    OpenMDBitSet result(toIndex - fromIndex);
+    int shift = fromIndex % bitsPerWord;
+    int first = wordIndex(fromIndex);
+    int nw = words_.size();
+
+    for (std::size_t i = 0; i < result.words_.size(); ++i) {
+      int k = first + i;
+      WordType w = words_[k] >> shift;
+      if (shift != 0 && k + 1 < nw) 
+        w |= words_[k + 1] << (bitsPerWord - shift);
+      result.words_[i] = w;
+    }
+    result.clearUnusedBits();
     return result;
   }
 
-  bool OpenMDBitSet::none() {
-    std::vector<bool>::iterator i = std::find(bitset_.begin(), bitset_.end(), true);
-    return i == bitset_.end() ? true : false;
+  bool OpenMDBitSet::none() const {
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      if (words_[i]) return false;
+    return true;
   }
     
   int OpenMDBitSet::nextOffBit(int fromIndex) const {
@@ -100,14 +148,18 @@ namespace OpenMD {
     }
     
     ++fromIndex;
-    while (fromIndex < size()) {
-      if (!bitset_[fromIndex]) {
-	return fromIndex;
-      }
-      ++fromIndex;
+    if (fromIndex >= size()) return -1;
+
+    int k = wordIndex(fromIndex);
+    int nw = words_.size();
+    WordType w = ~words_[k] & (~WordType(0) << (fromIndex % bitsPerWord));
+    while (!w) {
+      if (++k == nw) return -1;
+      w = ~words_[k];
     }
-
-    return -1;
+    // the unused bits of the last word read as off, so check the range
+    int index = k * bitsPerWord + lowestBit(w);
+    return index < size() ? index : -1;
   }
 
   int OpenMDBitSet::nextOnBit(int fromIndex) const {
@@ -117,47 +169,71 @@ namespace OpenMD {
     }
 
     ++fromIndex;
-    while (fromIndex < size()) {
-      if (bitset_[fromIndex]) {
-	return fromIndex;
-      }
-      ++fromIndex;
+    if (fromIndex >= size()) return -1;
+
+    int k = wordIndex(fromIndex);
+    int nw = words_.size();
+    WordType w = words_[k] & (~WordType(0) << (fromIndex % bitsPerWord));
+    while (!w) {
+      if (++k == nw) return -1;
+      w = words_[k];
     }
-
-    return -1;
+    return k * bitsPerWord + lowestBit(w);
   }
 
   void OpenMDBitSet::andOperator (const OpenMDBitSet& bs) {
     assert(size() == bs.size());
-
-    std::transform(bs.bitset_.begin(), bs.bitset_.end(), bitset_.begin(), bitset_.begin(), std::logical_and<bool>());
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      words_[i] &= bs.words_[i];
   }
 
   void OpenMDBitSet::orOperator (const OpenMDBitSet& bs) {
     assert(size() == bs.size());
-    std::transform(bs.bitset_.begin(), bs.bitset_.end(), bitset_.begin(), bitset_.begin(), std::logical_or<bool>());    
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      words_[i] |= bs.words_[i];
   }
 
   void OpenMDBitSet::xorOperator (const OpenMDBitSet& bs) {
     assert(size() == bs.size());
-    std::transform(bs.bitset_.begin(), bs.bitset_.end(), bitset_.begin(), bitset_.begin(), OpenMD::logical_xor<bool>());        
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      words_[i] ^= bs.words_[i];
+  }
+
+  void OpenMDBitSet::andNotOperator (const OpenMDBitSet& bs) {
+    assert(size() == bs.size());
+    for (std::size_t i = 0; i < words_.size(); ++i) 
+      words_[i] &= ~bs.words_[i];
   }
    
   void OpenMDBitSet::setBits(int fromIndex, int toIndex, bool value) {
     assert(fromIndex <= toIndex);
     assert(fromIndex >=0);
     assert(toIndex <= size());
-    std::vector<bool>::iterator first = bitset_.begin() + fromIndex;
-    std::vector<bool>::iterator last = bitset_.begin() + toIndex;
-    std::fill(first, last, value);
+    if (fromIndex == toIndex) return;
+
+    int first = wordIndex(fromIndex);
+    int last = wordIndex(toIndex - 1);
+    int lo = fromIndex % bitsPerWord;
+    int hi = (toIndex - 1) % bitsPerWord + 1;
+    WordType fill = value ? ~WordType(0) : WordType(0);
+
+    if (first == last) {
+      WordType mask = rangeMask(lo, hi);
+      words_[first] = (words_[first] & ~mask) | (fill & mask);
+      return;
+    }
+
+    WordType mask = rangeMask(lo, bitsPerWord);
+    words_[first] = (words_[first] & ~mask) | (fill & mask);
+    std::fill(words_.begin() + first + 1, words_.begin() + last, fill);
+    mask = rangeMask(0, hi);
+    words_[last] = (words_[last] & ~mask) | (fill & mask);
   }
 
   void OpenMDBitSet::resize(int nbits) {
-    int oldSize = size();
-    bitset_.resize(nbits);
-    if (nbits > oldSize) {
-      std::fill(bitset_.begin()+oldSize, bitset_.end(), false);
-    }
+    words_.resize(nWords(nbits), 0);
+    nbits_ = nbits;
+    clearUnusedBits();
   }
 
   OpenMDBitSet operator| (const OpenMDBitSet& bs1, const OpenMDBitSet& bs2) {
@@ -194,32 +270,19 @@ namespace OpenMD {
 
   bool operator== (const OpenMDBitSet & bs1, const OpenMDBitSet &bs2) {
     assert(bs1.size() == bs2.size());
-    return std::equal(bs1.bitset_.begin(), bs1.bitset_.end(), bs2.bitset_.begin());
+    return bs1.words_ == bs2.words_;
   }  
 
   OpenMDBitSet OpenMDBitSet::parallelReduce() {
-    OpenMDBitSet result;
+    OpenMDBitSet result(*this);
 
 #ifdef IS_MPI
-
-    // This is necessary because std::vector<bool> isn't really a
-    // std::vector, so we can't pass the address of the first element
-    // to the MPI call that follows.  We first have to convert to a
-    // std::vector<int> to do the logical_or Allreduce call, then back
-    // convert it into the vector<bool>.
-
-    std::vector<int> bsInt(bitset_.begin(), bitset_.end());
-
-    MPI_Allreduce(MPI_IN_PLACE, &bsInt[0], 
-                  bsInt.size(), MPI_INT, MPI_LOR, MPI_COMM_WORLD);
-
-    std::transform(bsInt.begin(), bsInt.end(), 
-                   std::back_inserter( result.bitset_ ), to_bool<int>());
-#else
-
-    // Not in MPI?  Just return a copy of the current bitset:
-    std::copy(bitset_.begin(), bitset_.end(), 
-              std::back_inserter( result.bitset_ ));
+    // the words are reduced as they are; the unused bits are off on
+    // every processor, so they stay off in the result.
+    if (!result.words_.empty())
+      MPI_Allreduce(MPI_IN_PLACE, &result.words_[0], 
+                    result.words_.size(), MPI_UINT64_T, MPI_BOR, 
+                    MPI_COMM_WORLD);
 #endif
 
     return result;
@@ -231,7 +294,7 @@ namespace OpenMD {
   //}
 
   std::ostream& operator<< ( std::ostream& os, const OpenMDBitSet& bs) {
-    for (unsigned int i = 0; i < bs.bitset_.size(); ++i) {
+    for (int i = 0; i < bs.size(); ++i) {
       std::string val = bs[i] ? "true" : "false";
       os << "OpenMDBitSet[" << i <<"] = " << val << std::endl; 
     }
@@ -45,24 +45,32 @@
 
 #include <iostream>
 #include <vector>
+#include <stdint.h>
+
 namespace OpenMD {
 
   /**
    * @class OpenMDBitSet OpenMDBitSet.hpp "OpenMDBitSet.hpp"
-   * @brief OpenMDBitSet is a wrapper class of std::vector<bool> to act as a growable std::bitset 
+   * @brief OpenMDBitSet is a growable bitset packed into 64-bit words.
+   *
+   * Counting, searching and the logical operators work a word at a
+   * time.  Bits beyond size() in the last word are always kept off,
+   * so whole-word operations never need to mask them.
    */
   class OpenMDBitSet {
   public:
+    typedef uint64_t WordType;
+
     /** */
-    OpenMDBitSet() {}
+    OpenMDBitSet() : nbits_(0) {}
     /** */
-    OpenMDBitSet(int nbits) : bitset_(nbits) {clearAll(); }
+    OpenMDBitSet(int nbits) : nbits_(nbits), words_(nWords(nbits), 0) {}
 
     /** Returns the number of bits set to true in this OpenMDBitSet.  */
-    int countBits();
+    int countBits() const;
 
     /** Sets the bit at the specified index to to the complement of its current value. */
-    void flip(int bitIndex) {  bitset_[bitIndex] = !bitset_[bitIndex];  }
+    void flip(int bitIndex) {  words_[wordIndex(bitIndex)] ^= bitMask(bitIndex);  }
  
     /** Sets each bit from the specified fromIndex(inclusive) to the specified toIndex(exclusive) to the complement of its current value. */
     void flip(int fromIndex, int toIndex); 
@@ -71,25 +79,25 @@ namespace OpenMD {
     void flip() { flip(0, size()); }
         
     /** Returns the value of the bit with the specified index. */
-    bool get(int bitIndex) {  return bitset_[bitIndex];  }
+    bool get(int bitIndex) const {  return (words_[wordIndex(bitIndex)] & bitMask(bitIndex)) != 0;  }
         
     /** Returns a new OpenMDBitSet composed of bits from this OpenMDBitSet from fromIndex(inclusive) to toIndex(exclusive). */
-    OpenMDBitSet get(int fromIndex, int toIndex); 
+    OpenMDBitSet get(int fromIndex, int toIndex) const; 
         
     /** Returns true if any bits are set to true */
-    bool any() {return !none(); }
+    bool any() const {return !none(); }
 
     /** Returns true if no bits are set to true */
-    bool none();
+    bool none() const;
 
-    int firstOffBit() const { return !bitset_[0] ? 0 : nextOffBit(0); }
+    int firstOffBit() const { return (size() > 0 && !get(0)) ? 0 : nextOffBit(0); }
         
-    /** Returns the index of the first bit that is set to false that occurs on or after the specified starting index.*/
+    /** Returns the index of the first bit that is set to false that occurs after the specified starting index.*/
     int nextOffBit(int fromIndex) const; 
 
-    int firstOnBit() const { return bitset_[0] ? 0 : nextOnBit(0); }
+    int firstOnBit() const { return (size() > 0 && get(0)) ? 0 : nextOnBit(0); }
         
-    /** Returns the index of the first bit that is set to true that occurs on or after the specified starting index. */
+    /** Returns the index of the first bit that is set to true that occurs after the specified starting index. */
     int nextOnBit(int fromIndex) const; 
         
     /** Performs a logical AND of this target bit set with the argument bit set. */
@@ -100,6 +108,9 @@ namespace OpenMD {
         
     /** Performs a logical XOR of this bit set with the bit set argument. */
     void xorOperator (const OpenMDBitSet& bs);        
+
+    /** Clears the bits of this bit set that are set in the argument (AND NOT). */
+    void andNotOperator (const OpenMDBitSet& bs);        
                
     void setBitOn(int bitIndex) {  setBit(bitIndex, true);  }
 
@@ -115,7 +126,7 @@ namespace OpenMD {
     void setAll() {  setRangeOn(0, size());  }        
         
     /** Returns the number of bits of space actually in use by this OpenMDBitSet to represent bit values. */
-    int size() const {  return bitset_.size();  }
+    int size() const {  return nbits_;  }
 
     /** Changes the size of OpenMDBitSet*/
     void resize(int nbits);
@@ -123,15 +134,11 @@ namespace OpenMD {
     OpenMDBitSet& operator&= (const OpenMDBitSet &bs) {  andOperator (bs); return *this; }
     OpenMDBitSet& operator|= (const OpenMDBitSet &bs) { orOperator (bs); return *this; }
     OpenMDBitSet& operator^= (const OpenMDBitSet &bs) { xorOperator (bs); return *this; }
-    OpenMDBitSet& operator-= (const OpenMDBitSet &bs) { 
-      OpenMDBitSet tmp = *this ^ bs;
-      *this &= tmp;
-      return *this;
-    }
+    OpenMDBitSet& operator-= (const OpenMDBitSet &bs) { andNotOperator (bs); return *this; }
 
     OpenMDBitSet parallelReduce();
         
-    bool operator[] (int bitIndex)  const {  return bitset_[bitIndex];  }
+    bool operator[] (int bitIndex)  const {  return get(bitIndex);  }
     friend OpenMDBitSet operator| (const OpenMDBitSet& bs1, const OpenMDBitSet& bs2);
     friend OpenMDBitSet operator& (const OpenMDBitSet& bs1, const OpenMDBitSet& bs2);
     friend OpenMDBitSet operator^ (const OpenMDBitSet& bs1, const OpenMDBitSet& bs2);
@@ -144,13 +151,28 @@ namespace OpenMD {
 
   private:
 
+    static const int bitsPerWord = 64;
+
+    static int nWords(int nbits) { return (nbits + bitsPerWord - 1) / bitsPerWord; }
+    static int wordIndex(int bitIndex) { return bitIndex / bitsPerWord; }
+    static WordType bitMask(int bitIndex) { return WordType(1) << (bitIndex % bitsPerWord); }
+
+    /** Turns off the unused bits of the last word. */
+    void clearUnusedBits();
+
     /** Sets the bit at the specified index to the specified value. */
-    void setBit(int bitIndex, bool value) { bitset_[bitIndex] = value; }
+    void setBit(int bitIndex, bool value) { 
+      if (value) 
+        words_[wordIndex(bitIndex)] |= bitMask(bitIndex);
+      else
+        words_[wordIndex(bitIndex)] &= ~bitMask(bitIndex);
+    }
         
     /** Sets the bits from the specified fromIndex(inclusive) to the specified toIndex(exclusive) to the specified value. */
     void setBits(int fromIndex, int toIndex, bool value);
         
-    std::vector<bool> bitset_;
+    int nbits_;
+    std::vector<WordType> words_;
   }; 
 
 }
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2005 The University of Notre Dame. All Rights Reserved.
+ *
+ * The University of Notre Dame grants you ("Licensee") a
+ * non-exclusive, royalty free, license to use, modify and
+ * redistribute this software in source and binary code form, provided
+ * that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * This software is provided "AS IS," without a warranty of any
+ * kind. All express or implied conditions, representations and
+ * warranties, including any implied warranty of merchantability,
+ * fitness for a particular purpose or non-infringement, are hereby
+ * excluded.  The University of Notre Dame and its licensors shall not
+ * be liable for any damages suffered by licensee as a result of
+ * using, modifying or distributing the software or its
+ * derivatives. In no event will the University of Notre Dame or its
+ * licensors be liable for any lost revenue, profit or data, or for
+ * direct, indirect, special, consequential, incidental or punitive
+ * damages, however caused and regardless of the theory of liability,
+ * arising out of the use of or inability to use software, even if the
+ * University of Notre Dame has been advised of the possibility of
+ * such damages.
+ *
+ * SUPPORT OPEN SCIENCE!  If you use OpenMD or its source code in your
+ * research, please cite the appropriate papers when you publish your
+ * work.  Good starting points are:
+ *                                                                      
+ * [1]  Meineke, et al., J. Comp. Chem. 26, 252-271 (2005).             
+ * [2]  Fennell & Gezelter, J. Chem. Phys. 124, 234104 (2006).          
+ * [3]  Sun, Lin & Gezelter, J. Chem. Phys. 128, 234107 (2008).          
+ * [4]  Kuang & Gezelter,  J. Chem. Phys. 133, 164101 (2010).
+ * [5]  Vardeman, Stocker & Gezelter, J. Chem. Theory Comput. 7, 834 (2011).
+ */
+ 
+#include "visitors/AtomData.hpp"
+#include "brains/SimInfo.hpp"
+
+namespace OpenMD {
+
+  SiteData::SiteData(SimInfo* info) : GenericData("SITEDATA"), info_(info),
+                                      nAtoms_(0), nSites_(0) {
+    clear();
+  }
+
+  SiteData* SiteData::getSiteData(SimInfo* info) {
+    SiteData* siteData = dynamic_cast<SiteData*>(info->getPropertyByName("SITEDATA"));
+    if (siteData == NULL) {
+      siteData = new SiteData(info);
+      info->addProperty(siteData);
+    }
+    return siteData;
+  }
+
+  void SiteData::clear() {
+    nAtoms_ = info_->getNAtoms();
+    int nObjects = nAtoms_ + info_->getNRigidBodies();
+
+    head_.assign(nObjects, -1);
+    tail_.assign(nObjects, -1);
+    visited_.assign(nObjects, 0);
+    nSites_ = 0;
+  }
+
+  int SiteData::newRow(StuntDouble* sd) {
+    int row = nSites_++;
+
+    if (row == int(next_.size())) {
+      next_.push_back(-1);
+      attributes_.push_back(0);
+      typeName_.push_back(std::string());
+      globalID_.push_back(0);
+      pos_.push_back(V3Zero);
+      vec_.push_back(V3Zero);
+      vel_.push_back(V3Zero);
+      frc_.push_back(V3Zero);
+      eField_.push_back(V3Zero);
+      charge_.push_back(0.0);
+    } else {
+      next_[row] = -1;
+      attributes_[row] = 0;
+      globalID_[row] = 0;
+      pos_[row] = V3Zero;
+      vec_[row] = V3Zero;
+      vel_[row] = V3Zero;
+      frc_[row] = V3Zero;
+      eField_[row] = V3Zero;
+      charge_[row] = 0.0;
+    }
+
+    int obj = getObjectIndex(sd);
+    if (head_[obj] < 0) 
+      head_[obj] = row;
+    else
+      next_[tail_[obj]] = row;
+    tail_[obj] = row;
+
+    return row;
+  }
+
+  int SiteData::addSite(StuntDouble* sd, const std::string& name) {
+    int row = newRow(sd);
+    typeName_[row] = name;
+    return row;
+  }
+
+  int SiteData::copySite(StuntDouble* sd, int source) {
+    int row = newRow(sd);
+    attributes_[row] = attributes_[source];
+    typeName_[row] = typeName_[source];
+    globalID_[row] = globalID_[source];
+    pos_[row] = pos_[source];
+    vec_[row] = vec_[source];
+    vel_[row] = vel_[source];
+    frc_[row] = frc_[source];
+    eField_[row] = eField_[source];
+    charge_[row] = charge_[source];
+    return row;
+  }
+}
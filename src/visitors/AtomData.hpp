@@ -47,9 +47,17 @@
 
 #include "utils/GenericData.hpp"
 #include "math/Vector3.hpp"
+#include "primitives/StuntDouble.hpp"
 
 namespace OpenMD {
 
+  class SimInfo;
+
+  /**
+   * @struct AtomInfo 
+   * Describes a single site.  Visitors use it for reference
+   * structures; the sites produced for a frame live in SiteData.
+   */
   struct AtomInfo {
     AtomInfo() : pos(V3Zero), vec(V3Zero), vel(V3Zero), frc(V3Zero),
                  eField(V3Zero), charge(0.0),
@@ -72,42 +80,102 @@ namespace OpenMD {
     bool hasGlobalID;
   };
 
-  class AtomData : public GenericData{
+  /**
+   * @class SiteData
+   * Per-frame store for the sites the visitors attach to atoms and
+   * rigid bodies.  Each attribute of a site is kept in its own
+   * contiguous column, and the sites owned by one StuntDouble form a
+   * chain of rows.  clear() only resets the counters, so after the
+   * first frame no memory is allocated while visiting.
+   *
+   * All of the visitors working on one SimInfo share a single store,
+   * which is obtained with getSiteData().
+   */
+  class SiteData : public GenericData {
   public:
 
-    AtomData(const std::string& id = "ATOMDATA") : GenericData(id) {}
+    /** Attribute IDs, used as bits in the per-site attribute mask */
+    enum SiteAttribute {
+      saCharge        = 1,
+      saVector        = 2,
+      saVelocity      = 4,
+      saForce         = 8,
+      saElectricField = 16,
+      saGlobalID      = 32
+    };
+
+    /** Returns the store attached to info, creating it if needed */
+    static SiteData* getSiteData(SimInfo* info);
+
+    /** Forgets all sites and visited marks, keeping the storage */
+    void clear();
 
-    ~AtomData() {
-      std::vector<AtomInfo*>::iterator i;
-      AtomInfo* atomInfo;
+    /** Appends a new site named name to the chain of sd */
+    int addSite(StuntDouble* sd, const std::string& name);
 
-      for(atomInfo = beginAtomInfo(i); atomInfo; atomInfo  = nextAtomInfo(i)) {
-	delete atomInfo;
-      }
-      data.clear();
+    /** Appends a copy of the site in row source to the chain of sd */
+    int copySite(StuntDouble* sd, int source);
+
+    /** Returns the first site row of sd, or -1 if sd has none */
+    int beginSite(StuntDouble* sd) {
+      return head_[getObjectIndex(sd)];
     }
-        
-    void addAtomInfo(AtomInfo* info) {data.push_back(info);}
 
-    void clearAllAtomInfo();
+    /** Returns the site row following row, or -1 at the end */
+    int nextSite(int row) { return next_[row]; }
 
-    AtomInfo* beginAtomInfo(std::vector<AtomInfo*>::iterator& i){
-      i = data.begin();
-      return i != data.end()? *i : NULL;
+    bool isVisited(StuntDouble* sd) {
+      return visited_[getObjectIndex(sd)] != 0;
     }
+    void setVisited(StuntDouble* sd) { visited_[getObjectIndex(sd)] = 1; }
+
+    std::string& getTypeName(int row) { return typeName_[row]; }
+    int& getGlobalID(int row) { return globalID_[row]; }
+    Vector3d& getPos(int row) { return pos_[row]; }
+    Vector3d& getVec(int row) { return vec_[row]; }
+    Vector3d& getVel(int row) { return vel_[row]; }
+    Vector3d& getFrc(int row) { return frc_[row]; }
+    Vector3d& getElectricField(int row) { return eField_[row]; }
+    RealType& getCharge(int row) { return charge_[row]; }
 
-    AtomInfo* nextAtomInfo(std::vector<AtomInfo*>::iterator& i){
-      ++i;
-      return i != data.end()? *i: NULL;
+    bool hasAttribute(int row, SiteAttribute attr) {
+      return (attributes_[row] & attr) != 0;
     }
+    void setAttribute(int row, SiteAttribute attr) {
+      attributes_[row] |= attr;
+    }
+
+    int getNSites() { return nSites_; }
 
-    std::vector<AtomInfo*> getData() {return data;}
+  private:
+    SiteData(SimInfo* info);
+
+    int getObjectIndex(StuntDouble* sd) {
+      return sd->isRigidBody() ? nAtoms_ + sd->getLocalIndex() 
+        : sd->getLocalIndex();
+    }
+    int newRow(StuntDouble* sd);
 
-    int getSize() {return data.size();}
+    SimInfo* info_;
+    int nAtoms_;
+    int nSites_;
 
-  protected:
+    // per StuntDouble (atoms first, then rigid bodies by local index)
+    std::vector<int> head_;
+    std::vector<int> tail_;
+    std::vector<char> visited_;
 
-    std::vector<AtomInfo*> data;
+    // per site
+    std::vector<int> next_;
+    std::vector<int> attributes_;
+    std::vector<std::string> typeName_;
+    std::vector<int> globalID_;
+    std::vector<Vector3d> pos_;
+    std::vector<Vector3d> vec_;
+    std::vector<Vector3d> vel_;
+    std::vector<Vector3d> frc_;
+    std::vector<Vector3d> eField_;
+    std::vector<RealType> charge_;
   };
 }
 #endif //VISITOR_ATOMDATA_HPP
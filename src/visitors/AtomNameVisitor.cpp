@@ -51,40 +51,21 @@ namespace OpenMD {
                                                     info_(info) {
     visitorName = "AtomNameVisitor";
     ff_ = info_->getForceField();
+    sites_ = SiteData::getSiteData(info_);
   }
   
   
   void AtomNameVisitor::visitAtom(Atom* atom) {
-    AtomData* atomData;
-    GenericData* data;    
-    
-    data = atom->getPropertyByName("ATOMDATA");
-    if(data != NULL){
-      atomData = dynamic_cast<AtomData*>(data);  
-      if(atomData == NULL){
-	std::cerr << "can not get Atom Data from " << atom->getType() 
-                  << std::endl;
-	atomData = new AtomData; 
-      } else {
-      }
-    } else {
-      atomData = new AtomData;
-    }
-    
-    std::vector<AtomInfo*>::iterator i;
-    for (AtomInfo* atomInfo = atomData->beginAtomInfo(i); 
-         atomInfo != NULL; 
-         atomInfo = atomData->nextAtomInfo(i)) {
+    for (int row = sites_->beginSite(atom); row != -1; 
+         row = sites_->nextSite(row)) {
       
       // query the force field for the AtomType associated with this
       // atomTypeName:
-      AtomType* at = ff_->getAtomType(atomInfo->atomTypeName);
+      AtomType* at = ff_->getAtomType(sites_->getTypeName(row));
       // get the chain of base types for this atom type:
       std::vector<AtomType*> ayb = at->allYourBase();
       // use the last type in the chain of base types for the name:
-      std::string bn = ayb[ayb.size()-1]->getName();
-      
-      atomInfo->atomTypeName = bn;      
+      sites_->getTypeName(row) = ayb[ayb.size()-1]->getName();
     }
   }
   
@@ -66,6 +66,7 @@ namespace OpenMD {
   private:
     void visitAtom(Atom* atom);
     SimInfo* info_;
+    SiteData* sites_;
     ForceField* ff_;
   };
 }
@@ -51,8 +51,10 @@
 
 namespace OpenMD {
 
-  BaseAtomVisitor::BaseAtomVisitor(SimInfo* info) : BaseVisitor() {
+  BaseAtomVisitor::BaseAtomVisitor(SimInfo* info) : BaseVisitor(), 
+                                                    info(info) {
     storageLayout_ = info->getStorageLayout(); 
+    sites_ = SiteData::getSiteData(info);
   }    
   
   void BaseAtomVisitor::visit(RigidBody *rb) {
@@ -66,130 +68,79 @@ namespace OpenMD {
   }
 
   void BaseAtomVisitor::setVisited(Atom *atom) {
-    GenericData *data;
-    data = atom->getPropertyByName("VISITED");
-
-    //if visited property is not existed, add it as new property
-    if (data == NULL) {
-      data = new GenericData();
-      data->setID("VISITED");
-      atom->addProperty(data);
-    }
+    sites_->setVisited(atom);
   }
 
   bool BaseAtomVisitor::isVisited(Atom *atom) {
-    GenericData *data;
-    data = atom->getPropertyByName("VISITED");
-    return data == NULL ? false : true;
+    return sites_->isVisited(atom);
   }
 
   //------------------------------------------------------------------------//
 	
   void DefaultAtomVisitor::visit(Atom *atom) {
-    AtomData *atomData;
-    AtomInfo *atomInfo;
-    AtomType* atype = atom->getAtomType();
-              
     if (isVisited(atom))
       return;
     
-    atomInfo = new AtomInfo;
-    atomInfo->atomTypeName = atom->getType();
-    atomInfo->globalID = atom->getGlobalIndex();
-    atomInfo->pos = atom->getPos();
-    atomInfo->vel = atom->getVel();
-    atomInfo->frc = atom->getFrc();
-    atomInfo->vec = V3Zero;
-    atomInfo->hasVelocity = true;
-    atomInfo->hasForce = true;
-    atomInfo->hasGlobalID = true;
-
-        
-    FixedChargeAdapter fca = FixedChargeAdapter(atype);
-    if ( fca.isFixedCharge() ) {
-      atomInfo->hasCharge = true;
-      atomInfo->charge = fca.getCharge();
-    }
-          
-    FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atype);
-    if ( fqa.isFluctuatingCharge() ) {
-      atomInfo->hasCharge = true;
-      atomInfo->charge += atom->getFlucQPos();
-    }
-    
-    if ((storageLayout_ & DataStorage::dslElectricField) && 
-        (atype->isElectrostatic())) {
-      atomInfo->hasElectricField = true;
-      atomInfo->eField = atom->getElectricField();
-    }
-
-    atomData = new AtomData;
-    atomData->setID("ATOMDATA");   
-    atomData->addAtomInfo(atomInfo);
-    
-    atom->addProperty(atomData);
-    
+    addAtomSite(atom);
     setVisited(atom);
   }
   
   void DefaultAtomVisitor::visit(DirectionalAtom *datom) {
-    AtomData *atomData;
-    AtomInfo *atomInfo;
     AtomType* atype = datom->getAtomType();
 
     if (isVisited(datom))
       return;
     
-    atomInfo = new AtomInfo;
-    atomInfo->atomTypeName = datom->getType();
-    atomInfo->globalID = datom->getGlobalIndex();
-    atomInfo->pos = datom->getPos();
-    atomInfo->vel = datom->getVel();
-    atomInfo->frc = datom->getFrc();
-    atomInfo->hasVelocity = true;
-    atomInfo->hasForce = true;
-    atomInfo->hasGlobalID = true;
+    int row = addAtomSite(datom);
 
+    GayBerneAdapter gba = GayBerneAdapter(atype);
+    MultipoleAdapter ma = MultipoleAdapter(atype);
+    
+    if (gba.isGayBerne()) {
+      sites_->setAttribute(row, SiteData::saVector);
+      sites_->getVec(row) = datom->getA().transpose()*V3Z;
+    } else if (ma.isDipole()) {
+      sites_->setAttribute(row, SiteData::saVector);
+      sites_->getVec(row) = datom->getDipole();
+    } else if (ma.isQuadrupole()) {
+      sites_->setAttribute(row, SiteData::saVector);
+      sites_->getVec(row) = datom->getA().transpose()*V3Z;
+    }
+
+    setVisited(datom);
+  }
 
+  int DefaultAtomVisitor::addAtomSite(Atom *atom) {
+    AtomType* atype = atom->getAtomType();
+    int row = sites_->addSite(atom, atom->getType());
+
+    sites_->getGlobalID(row) = atom->getGlobalIndex();
+    sites_->getPos(row) = atom->getPos();
+    sites_->getVel(row) = atom->getVel();
+    sites_->getFrc(row) = atom->getFrc();
+    sites_->setAttribute(row, SiteData::saVelocity);
+    sites_->setAttribute(row, SiteData::saForce);
+    sites_->setAttribute(row, SiteData::saGlobalID);
+        
     FixedChargeAdapter fca = FixedChargeAdapter(atype);
     if ( fca.isFixedCharge() ) {
-      atomInfo->hasCharge = true;
-      atomInfo->charge = fca.getCharge();
+      sites_->setAttribute(row, SiteData::saCharge);
+      sites_->getCharge(row) = fca.getCharge();
     }
           
     FluctuatingChargeAdapter fqa = FluctuatingChargeAdapter(atype);
     if ( fqa.isFluctuatingCharge() ) {
-      atomInfo->hasCharge = true;
-      atomInfo->charge += datom->getFlucQPos();
+      sites_->setAttribute(row, SiteData::saCharge);
+      sites_->getCharge(row) += atom->getFlucQPos();
     }
-
+    
     if ((storageLayout_ & DataStorage::dslElectricField) && 
         (atype->isElectrostatic())) {
-      atomInfo->hasElectricField = true;
-      atomInfo->eField = datom->getElectricField();
+      sites_->setAttribute(row, SiteData::saElectricField);
+      sites_->getElectricField(row) = atom->getElectricField();
     }
 
-    GayBerneAdapter gba = GayBerneAdapter(atype);
-    MultipoleAdapter ma = MultipoleAdapter(atype);
-    
-    if (gba.isGayBerne()) {
-      atomInfo->hasVector = true;
-      atomInfo->vec = datom->getA().transpose()*V3Z;
-    } else if (ma.isDipole()) {
-      atomInfo->hasVector = true;
-      atomInfo->vec = datom->getDipole();
-    } else if (ma.isQuadrupole()) {
-      atomInfo->hasVector = true;
-      atomInfo->vec = datom->getA().transpose()*V3Z;
-    }
-
-    atomData = new AtomData;
-    atomData->setID("ATOMDATA");   
-    atomData->addAtomInfo(atomInfo);
-
-    datom->addProperty(atomData);
-
-    setVisited(datom);
+    return row;
   }
 
   const std::string DefaultAtomVisitor::toString() {
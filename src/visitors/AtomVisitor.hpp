@@ -66,6 +66,7 @@ namespace OpenMD {
   protected:
     BaseAtomVisitor(SimInfo* info);
     SimInfo* info;
+    SiteData* sites_;
     int storageLayout_;
   };
 
@@ -79,7 +80,9 @@ namespace OpenMD {
     virtual void visit(RigidBody* rb) {}
     
     virtual const std::string toString();
-    
+
+  private:
+    int addAtomSite(Atom* atom);
   };
 
 }//namespace OpenMD
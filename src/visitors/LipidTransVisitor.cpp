@@ -50,6 +50,7 @@ namespace OpenMD {
 
  
       visitorName = "LipidTransVisitor";
+      sites_ = SiteData::getSiteData(info_);
     
       originEvaluator_.loadScriptString(originSeleScript);            
       if (!originEvaluator_.isDynamic()) {  
@@ -115,29 +116,15 @@ namespace OpenMD {
   }
 
   void LipidTransVisitor::internalVisit(StuntDouble *sd) {
-    GenericData *                     data;
-    AtomData *                        atomData;
-    AtomInfo *                        atomInfo;
-    std::vector<AtomInfo *>::iterator i;
-
-    data = sd->getPropertyByName("ATOMDATA");
-
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-
-      if (atomData == NULL)
-	return;
-    } else
-      return;
-
     Snapshot* currSnapshot = info_->getSnapshotManager()->getCurrentSnapshot();
     
-    for( atomInfo = atomData->beginAtomInfo(i); atomInfo; atomInfo = atomData->nextAtomInfo(i) ) {
+    for (int row = sites_->beginSite(sd); row != -1; 
+         row = sites_->nextSite(row)) {
 
-      Vector3d tmp= atomInfo->pos - origin_;
+      Vector3d tmp= sites_->getPos(row) - origin_;
       currSnapshot->wrapVector(tmp);
-      atomInfo->pos = rotMat_ * tmp;;
-      atomInfo->vec = rotMat_ * atomInfo->vec;
+      sites_->getPos(row) = rotMat_ * tmp;
+      sites_->getVec(row) = rotMat_ * sites_->getVec(row);
     }
   }
 
@@ -68,6 +68,7 @@ namespace OpenMD {
   protected:
     void internalVisit(StuntDouble* sd);
     SimInfo* info_;
+    SiteData* sites_;
     SelectionEvaluator originEvaluator_;
     SelectionManager originSeleMan_;
     DirectionalAtom* originDatom_;
@@ -62,29 +62,14 @@ namespace OpenMD {
   }
 
   void WrappingVisitor::internalVisit(StuntDouble *sd) {
-    GenericData *                     data;
-    AtomData *                        atomData;
-    AtomInfo *                        atomInfo;
-    std::vector<AtomInfo *>::iterator i;
-
-    data = sd->getPropertyByName("ATOMDATA");
-
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-
-      if (atomData == NULL)
-	return;
-    } else
-      return;
-
     Snapshot* currSnapshot = info->getSnapshotManager()->getCurrentSnapshot();
     
-    for( atomInfo = atomData->beginAtomInfo(i); atomInfo; 
-         atomInfo = atomData->nextAtomInfo(i) ) {
+    for (int row = sites_->beginSite(sd); row != -1; 
+         row = sites_->nextSite(row)) {
 
-      Vector3d newPos = atomInfo->pos - origin_;
+      Vector3d newPos = sites_->getPos(row) - origin_;
       currSnapshot->wrapVector(newPos);
-      atomInfo->pos = newPos;
+      sites_->getPos(row) = newPos;
 
     }
   }
@@ -123,6 +108,7 @@ namespace OpenMD {
   ReplicateVisitor::ReplicateVisitor(SimInfo *info, Vector3i opt) :
     BaseVisitor(), replicateOpt(opt) {
       this->info = info;
+      sites_ = SiteData::getSiteData(info);
       visitorName = "ReplicateVisitor";
 
       //generate the replicate directions
@@ -154,42 +140,31 @@ namespace OpenMD {
   }
 
   void ReplicateVisitor::internalVisit(StuntDouble *sd) {
-    GenericData *          data;
-    AtomData *             atomData;
-
     //if there is not atom data, just skip it
-    data = sd->getPropertyByName("ATOMDATA");
-
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-
-      if (atomData == NULL) {
-	return;
-      }
-    } else {
+    if (sites_->beginSite(sd) == -1)
       return;
-    }
 
     Snapshot* currSnapshot = info->getSnapshotManager()->getCurrentSnapshot();
     Mat3x3d box = currSnapshot->getHmat();
 
-    std::vector<AtomInfo *> atomInfoList = atomData->getData();
-
-    replicate(atomInfoList, atomData, box);
+    replicate(sd, box);
   }
 
-  void ReplicateVisitor::replicate(std::vector<AtomInfo *>&infoList,
-                                   AtomData *data, const Mat3x3d& box) {
-    AtomInfo* newAtomInfo;
+  void ReplicateVisitor::replicate(StuntDouble* sd, const Mat3x3d& box) {
     std::vector<Vector3d>::iterator dirIter;
-    std::vector<AtomInfo *>::iterator i;
+    std::vector<int>::iterator i;
+
+    // the copies are appended to the same chain, so remember where the
+    // original sites are before adding any
+    rows_.clear();
+    for (int row = sites_->beginSite(sd); row != -1; 
+         row = sites_->nextSite(row))
+      rows_.push_back(row);
 
     for( dirIter = dir.begin(); dirIter != dir.end(); ++dirIter ) {
-      for( i = infoList.begin(); i != infoList.end(); ++i ) {
-	newAtomInfo = new AtomInfo();
-	*newAtomInfo = *(*i);
-        newAtomInfo->pos += box * (*dirIter);
-	data->addAtomInfo(newAtomInfo);
+      for( i = rows_.begin(); i != rows_.end(); ++i ) {
+        int newRow = sites_->copySite(sd, *i);
+        sites_->getPos(newRow) += box * (*dirIter);
       }
     }
   }
@@ -234,8 +209,10 @@ namespace OpenMD {
                                           doVelocities_(false), 
                                           doForces_(false), doVectors_(false),
                                           doCharges_(false), 
-                                          doElectricFields_(false), doGlobalIDs_(false) {
+                                          doElectricFields_(false), doGlobalIDs_(false),
+                                          nFrameSites_(0) {
     this->info = info;
+    sites_ = SiteData::getSiteData(info);
     visitorName = "XYZVisitor";
     
     evaluator.loadScriptString("select all");
@@ -248,9 +225,11 @@ namespace OpenMD {
   XYZVisitor::XYZVisitor(SimInfo *info, const std::string& script) :
     BaseVisitor(), seleMan(info), evaluator(info), doPositions_(true),
     doVelocities_(false), doForces_(false), doVectors_(false),
-    doCharges_(false), doElectricFields_(false), doGlobalIDs_(false) {
+    doCharges_(false), doElectricFields_(false), doGlobalIDs_(false),
+    nFrameSites_(0) {
     
     this->info = info;
+    sites_ = SiteData::getSiteData(info);
     visitorName = "XYZVisitor";
 
     evaluator.loadScriptString(script);
@@ -283,65 +262,51 @@ namespace OpenMD {
   }
   
   void XYZVisitor::internalVisit(StuntDouble *sd) {
-    GenericData *                     data;
-    AtomData *                        atomData;
-    AtomInfo *                        atomInfo;
-    std::vector<AtomInfo *>::iterator i;
-    char                              buffer[1024];
-    
-    //if there is not atom data, just skip it
-    data = sd->getPropertyByName("ATOMDATA");
+    char buffer[1024];
     
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-      
-      if (atomData == NULL)
-	return;
-    } else
-      return;
-
-    for( atomInfo = atomData->beginAtomInfo(i); atomInfo;
-         atomInfo = atomData->nextAtomInfo(i) ) {
+    for (int row = sites_->beginSite(sd); row != -1; 
+         row = sites_->nextSite(row)) {
      
-      std::string line;
-      sprintf(buffer, "%s", atomInfo->atomTypeName.c_str());
-      line += buffer;
+      frame_ += sites_->getTypeName(row);
       
       if (doPositions_){
-        sprintf(buffer, "%15.8f%15.8f%15.8f", atomInfo->pos[0], 
-                atomInfo->pos[1], atomInfo->pos[2]);
-        line += buffer;
+        const Vector3d& pos = sites_->getPos(row);
+        sprintf(buffer, "%15.8f%15.8f%15.8f", pos[0], pos[1], pos[2]);
+        frame_ += buffer;
       }      
-      if (doCharges_ && atomInfo->hasCharge) {
-        sprintf(buffer, "%15.8f", atomInfo->charge);
-        line += buffer;
+      if (doCharges_ && sites_->hasAttribute(row, SiteData::saCharge)) {
+        sprintf(buffer, "%15.8f", sites_->getCharge(row));
+        frame_ += buffer;
       }
-      if (doVectors_ && atomInfo->hasVector) {
-        sprintf(buffer, "%15.8f%15.8f%15.8f", atomInfo->vec[0], 
-                atomInfo->vec[1], atomInfo->vec[2]);
-        line += buffer;
+      if (doVectors_ && sites_->hasAttribute(row, SiteData::saVector)) {
+        const Vector3d& vec = sites_->getVec(row);
+        sprintf(buffer, "%15.8f%15.8f%15.8f", vec[0], vec[1], vec[2]);
+        frame_ += buffer;
       }
-      if (doVelocities_ && atomInfo->hasVelocity) {
-        sprintf(buffer, "%15.8f%15.8f%15.8f", atomInfo->vel[0], 
-                atomInfo->vel[1], atomInfo->vel[2]);
-        line += buffer;
+      if (doVelocities_ && sites_->hasAttribute(row, SiteData::saVelocity)) {
+        const Vector3d& vel = sites_->getVel(row);
+        sprintf(buffer, "%15.8f%15.8f%15.8f", vel[0], vel[1], vel[2]);
+        frame_ += buffer;
       }
-      if (doForces_ && atomInfo->hasForce) {
-        sprintf(buffer, "%15.8f%15.8f%15.8f", atomInfo->frc[0], 
-                atomInfo->frc[1], atomInfo->frc[2]);
-        line += buffer;
+      if (doForces_ && sites_->hasAttribute(row, SiteData::saForce)) {
+        const Vector3d& frc = sites_->getFrc(row);
+        sprintf(buffer, "%15.8f%15.8f%15.8f", frc[0], frc[1], frc[2]);
+        frame_ += buffer;
       }      
-      if (doElectricFields_ && atomInfo->hasElectricField) {
-        sprintf(buffer, "%15.8f%15.8f%15.8f", atomInfo->eField[0], 
-                atomInfo->eField[1], atomInfo->eField[2]);
-        line += buffer;
+      if (doElectricFields_ && 
+          sites_->hasAttribute(row, SiteData::saElectricField)) {
+        const Vector3d& eField = sites_->getElectricField(row);
+        sprintf(buffer, "%15.8f%15.8f%15.8f", eField[0], eField[1], 
+                eField[2]);
+        frame_ += buffer;
       }
       if (doGlobalIDs_) {
-        sprintf(buffer, "%10d", atomInfo->globalID);
-        line += buffer;
+        sprintf(buffer, "%10d", sites_->getGlobalID(row));
+        frame_ += buffer;
       }
 
-      frame.push_back(line);
+      frame_ += '\n';
+      nFrameSites_++;
     }    
   }
 
@@ -350,14 +315,13 @@ namespace OpenMD {
   }
 
   void XYZVisitor::writeFrame(std::ostream &outStream) {
-    std::vector<std::string>::iterator i;
     char buffer[1024];
     
-    if (frame.empty())
+    if (nFrameSites_ == 0)
       std::cerr << "Current Frame does not contain any atoms" << std::endl;
     
     //total number of atoms  
-    outStream << frame.size() << std::endl;
+    outStream << nFrameSites_ << std::endl;
     
     //write comment line
     Snapshot* currSnapshot = info->getSnapshotManager()->getCurrentSnapshot();
@@ -372,8 +336,7 @@ namespace OpenMD {
     
     outStream << buffer << std::endl;
     
-    for( i = frame.begin(); i != frame.end(); ++i )
-      outStream << *i << std::endl;
+    outStream << frame_;
   }
   
   std::string XYZVisitor::trimmedName(const std::string&atomTypeName) {    
@@ -404,54 +367,13 @@ namespace OpenMD {
   
   //----------------------------------------------------------------------------//
   
-  void PrepareVisitor::internalVisit(Atom *atom) {
-    GenericData *data;
-    
-    //if visited property is  existed, remove it
-    data = atom->getPropertyByName("VISITED");
-    
-    if (data != NULL) {
-      atom->removeProperty("VISITED");
-    }
-    
-    //remove atomdata
-    data = atom->getPropertyByName("ATOMDATA");
-
-    if (data != NULL) {
-      AtomData* atomData = dynamic_cast<AtomData *>(data);
-
-      if (atomData != NULL)
-	atom->removeProperty("ATOMDATA");
-    }
+  PrepareVisitor::PrepareVisitor(SimInfo* info) : BaseVisitor() {
+    visitorName = "prepareVisitor";
+    sites_ = SiteData::getSiteData(info);
   }
 
-  void PrepareVisitor::internalVisit(RigidBody *rb) {
-    GenericData* data;
-    AtomData* atomData;
-    std::vector<Atom *> myAtoms;
-    std::vector<Atom *>::iterator atomIter;
-
-    //if visited property is  existed, remove it
-    data = rb->getPropertyByName("VISITED");
-
-    if (data != NULL) {
-      rb->removeProperty("VISITED");
-    }
-
-    //remove atomdata
-    data = rb->getPropertyByName("ATOMDATA");
-
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-
-      if (atomData != NULL)
-	rb->removeProperty("ATOMDATA");
-    }
-
-    myAtoms = rb->getAtoms();
-
-    for( atomIter = myAtoms.begin(); atomIter != myAtoms.end(); ++atomIter )
-      internalVisit(*atomIter);
+  void PrepareVisitor::update() {
+    sites_->clear();
   }
 
   const std::string PrepareVisitor::toString() {
@@ -478,8 +400,9 @@ namespace OpenMD {
 
   //----------------------------------------------------------------------------//
 
-  WaterTypeVisitor::WaterTypeVisitor() {
+  WaterTypeVisitor::WaterTypeVisitor(SimInfo* info) {
     visitorName = "WaterTypeVisitor";
+    sites_ = SiteData::getSiteData(info);
     waterTypeList.insert("TIP3P_RB_0");
     waterTypeList.insert("TIP4P_RB_0");
     waterTypeList.insert("TIP4P-Ice_RB_0");
@@ -497,8 +420,6 @@ namespace OpenMD {
     std::string rbName;
     std::vector<Atom *> myAtoms;
     std::vector<Atom *>::iterator atomIter;
-    std::vector<AtomInfo *>::iterator i;
-    AtomData* atomData;
 
     rbName = rb->getType();
     
@@ -507,19 +428,9 @@ namespace OpenMD {
       
       for( atomIter = myAtoms.begin(); atomIter != myAtoms.end();
 	   ++atomIter ) {
-	GenericData* data = (*atomIter)->getPropertyByName("ATOMDATA");
-        
-	if (data != NULL) {
-	  atomData = dynamic_cast<AtomData *>(data);
-          
-	  if (atomData == NULL)
-	    continue;
-	} else
-	  continue;
-        
-	for( AtomInfo* atomInfo = atomData->beginAtomInfo(i); atomInfo;
-	     atomInfo = atomData->nextAtomInfo(i) ) {
-	  atomInfo->atomTypeName = trimmedName(atomInfo->atomTypeName);
+	for (int row = sites_->beginSite(*atomIter); row != -1; 
+             row = sites_->nextSite(row)) {
+	  sites_->getTypeName(row) = trimmedName(sites_->getTypeName(row));
 	} 
       }
     } 
@@ -62,6 +62,7 @@ namespace OpenMD {
     using BaseVisitor::visit; 
     WrappingVisitor(SimInfo* info, bool useCom = true) : BaseVisitor(), useCom_(useCom) {
       this->info = info;
+      sites_ = SiteData::getSiteData(info);
       visitorName = "WrappingVisitor";
     }
     virtual void visit(Atom* atom);
@@ -75,6 +76,7 @@ namespace OpenMD {
   private:
     void internalVisit(StuntDouble* sd);
     SimInfo* info;    
+    SiteData* sites_;
     Vector3d origin_;
     bool useCom_;
   };
@@ -91,12 +93,13 @@ namespace OpenMD {
     virtual const std::string toString();
   protected:
     void internalVisit(StuntDouble* sd);
-    void replicate(std::vector<AtomInfo*>& infoList, AtomData* data,
-                   const Mat3x3d& box);
+    void replicate(StuntDouble* sd, const Mat3x3d& box);
     
   private:
     std::vector<Vector3d> dir;
+    std::vector<int> rows_;
     SimInfo* info;
+    SiteData* sites_;
     Vector3i replicateOpt;
   };
 
@@ -117,7 +120,7 @@ namespace OpenMD {
     virtual const std::string toString();
     
     void writeFrame(std::ostream& outStream);    
-    void clear() {frame.clear();}
+    void clear() {frame_.clear(); nFrameSites_ = 0;}
     void doPositions(bool pos) {doPositions_ = pos;}
     void doVelocities(bool vel) {doVelocities_ = vel;}
     void doForces(bool frc) {doForces_ = frc;}
@@ -134,9 +137,10 @@ namespace OpenMD {
     std::string trimmedName(const std::string& atomType);
 
     SimInfo* info;
+    SiteData* sites_;
     SelectionManager seleMan;
     SelectionEvaluator evaluator; 
-    std::vector<std::string> frame;
+    std::string frame_;
     bool doPositions_;
     bool doVelocities_;
     bool doForces_;
@@ -144,29 +148,33 @@ namespace OpenMD {
     bool doCharges_;
     bool doElectricFields_;
     bool doGlobalIDs_;
+    int nFrameSites_;
   };
 
 
+  /**
+   * @class PrepareVisitor
+   * Discards the sites left over from the previous frame.  The sites
+   * of all objects share one SiteData store, so this is done once per
+   * frame in update() rather than by visiting each object.
+   */
   class PrepareVisitor : public BaseVisitor{
   public:
     using BaseVisitor::visit; 
-    PrepareVisitor() : BaseVisitor() {visitorName = "prepareVisitor";}
+    PrepareVisitor(SimInfo* info);
 
-    virtual void visit(Atom* atom) {internalVisit(atom);}
-    virtual void visit(DirectionalAtom* datom) {internalVisit(reinterpret_cast<Atom*>(datom));}
-    virtual void visit(RigidBody* rb) {internalVisit(rb);}
+    virtual void update();
 
     virtual const std::string toString();
 
-  protected:
-    void internalVisit(Atom* atom);
-    void internalVisit(RigidBody* rb);
+  private:
+    SiteData* sites_;
   };
 
   class WaterTypeVisitor : public BaseVisitor{
   public:
     using BaseVisitor::visit; 
-    WaterTypeVisitor() ;
+    WaterTypeVisitor(SimInfo* info);
     virtual void visit(Atom* atom) {}
     virtual void visit(DirectionalAtom* datom) {}
     virtual void visit(RigidBody* rb);
@@ -177,6 +185,7 @@ namespace OpenMD {
     std::string trimmedName(const std::string& atomType);
     
     std::set<std::string> waterTypeList;
+    SiteData* sites_;
   };
 
 
@@ -52,7 +52,6 @@ namespace OpenMD {
   }
 
   ReplacementVisitor::~ReplacementVisitor(){
-    delete sites_;
     myTypes_.clear();
   }
    
@@ -64,20 +63,20 @@ namespace OpenMD {
 
   void ReplacementVisitor::addSite(const std::string &name, 
                                    const Vector3d &refPos) {
-    AtomInfo* atomInfo = new AtomInfo();
-    atomInfo->atomTypeName = name;
-    atomInfo->pos = refPos;
-    sites_->addAtomInfo(atomInfo);
+    AtomInfo atomInfo;
+    atomInfo.atomTypeName = name;
+    atomInfo.pos = refPos;
+    refSites_.push_back(atomInfo);
   }
   void ReplacementVisitor::addSite(const std::string &name, 
                                    const Vector3d &refPos, 
                                    const Vector3d &refVec) {
-    AtomInfo* atomInfo = new AtomInfo();
-    atomInfo->atomTypeName = name;
-    atomInfo->pos = refPos;
-    atomInfo->vec = refVec;
-    atomInfo->hasVector = true;
-    sites_->addAtomInfo(atomInfo);
+    AtomInfo atomInfo;
+    atomInfo.atomTypeName = name;
+    atomInfo.pos = refPos;
+    atomInfo.vec = refVec;
+    atomInfo.hasVector = true;
+    refSites_.push_back(atomInfo);
   }
   
   void ReplacementVisitor::visit(DirectionalAtom *datom) {
@@ -93,30 +92,10 @@ namespace OpenMD {
     Mat3x3d      skewMat;
 
     Vector3d     newVec;
-    AtomInfo *   atomInfo;
-    AtomData *   atomData;
-    GenericData *data;
-    bool         haveAtomData;
     
     //if atom is not one of our recognized atom types, just skip it
     if (!isReplacedAtom(datom->getType())) 
       return;
-    
-    data = datom->getPropertyByName("ATOMDATA");
-    
-    if (data != NULL) {
-      atomData = dynamic_cast<AtomData *>(data);
-      
-      if (atomData == NULL) {
-        std::cerr << "can not get Atom Data from " << datom->getType() << std::endl;
-        atomData = new AtomData;
-        haveAtomData = false;
-      } else
-        haveAtomData = true;
-    } else {
-      atomData = new AtomData;
-      haveAtomData = false;
-    }
         
     pos = datom->getPos();
     vel = datom->getVel();
@@ -139,33 +118,23 @@ namespace OpenMD {
     // We need A^T to convert from body-fixed to space-fixed:
     Atrans = A.transpose();
     
-    AtomInfo* siteInfo;
-    std::vector<AtomInfo*>::iterator iter;
+    std::vector<AtomInfo>::iterator siteInfo;
     
-    for( siteInfo = sites_->beginAtomInfo(iter); siteInfo; 
-         siteInfo = sites_->nextAtomInfo(iter) ) {
+    for( siteInfo = refSites_.begin(); siteInfo != refSites_.end(); 
+         ++siteInfo ) {
 
       newVec = Atrans * siteInfo->pos;    
       
-      atomInfo = new AtomInfo;
-      atomInfo->atomTypeName = siteInfo->atomTypeName;
-      atomInfo->pos = pos + newVec;
+      int row = sites_->addSite(datom, siteInfo->atomTypeName);
+      sites_->getPos(row) = pos + newVec;
       
       if (siteInfo->hasVector) {
         newVec = Atrans * siteInfo->vec;
-        atomInfo->vec = newVec;
-      } else {
-        atomInfo->vec = V3Zero;
+        sites_->getVec(row) = newVec;
       }
 
-      atomInfo->vel = vel + mat * siteInfo->pos;
-      atomInfo->hasVelocity = true;
-            
-      atomData->addAtomInfo(atomInfo);
-    }
-    if (!haveAtomData) {
-      atomData->setID("ATOMDATA");
-      datom->addProperty(atomData);
+      sites_->getVel(row) = vel + mat * siteInfo->pos;
+      sites_->setAttribute(row, SiteData::saVelocity);
     }
     
     setVisited(datom);
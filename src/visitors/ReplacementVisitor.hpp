@@ -61,7 +61,6 @@ namespace OpenMD {
     using BaseVisitor::visit;
     ReplacementVisitor(SimInfo* info) : BaseAtomVisitor(info) {
       visitorName = "ReplacementVisitor";   
-      sites_ = new AtomData; 
     }
     ~ReplacementVisitor();
     
@@ -77,7 +76,7 @@ namespace OpenMD {
   private:
     inline bool isReplacedAtom(const std::string& atomType);
     std::set<std::string> myTypes_;
-    AtomData* sites_;
+    std::vector<AtomInfo> refSites_;
   };
   
   class SSDAtomVisitor : public ReplacementVisitor{
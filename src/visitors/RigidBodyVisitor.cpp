@@ -47,62 +47,18 @@
 namespace OpenMD {
 
   void LipidHeadVisitor::visit(RigidBody* rb){
-    int globalID;
-    Vector3d pos;
     Vector3d u(0, 0, 1);
-    Vector3d newVec;
-    GenericData* data;
-    AtomData* atomData;
-    AtomInfo* atomInfo;
-    bool haveAtomData;
     RotMat3x3d rotMatrix;
 
     if(!canVisit(rb->getType()))
       return;
 
-    globalID = rb->getGlobalIndex();
-    pos = rb->getPos();
     rotMatrix = rb->getA();
-    //matVecMul3(rotMatrix, u, newVec);
-    newVec = rotMatrix * u;
-
-    data = rb->getPropertyByName("ATOMDATA");
-
-    if(data != NULL){
-      atomData = dynamic_cast<AtomData*>(data);  
-      
-      if(atomData == NULL){
-	std::cerr << "can not get Atom Data from " << rb->getType() << std::endl;
-	
-	atomData = new AtomData; 
-	haveAtomData = false;      
-	
-      } else
-	haveAtomData = true;
-      
-    } else {
-      atomData = new AtomData;
-      haveAtomData = false;
-      
-    }
-
-    atomInfo = new AtomInfo;
-    atomInfo->atomTypeName = "X";
-    atomInfo->globalID = globalID;
-    atomInfo->pos[0] = pos[0];
-    atomInfo->pos[1] = pos[1];
-    atomInfo->pos[2] = pos[2];
-    atomInfo->vec[0] = newVec[0];
-    atomInfo->vec[1] = newVec[1];
-    atomInfo->vec[2] = newVec[2];
-
-    atomData->addAtomInfo(atomInfo);
-
-    if(!haveAtomData){
-      atomData->setID("ATOMDATA");
-      rb->addProperty(atomData);
-    }
 
+    int row = sites_->addSite(rb, "X");
+    sites_->getGlobalID(row) = rb->getGlobalIndex();
+    sites_->getPos(row) = rb->getPos();
+    sites_->getVec(row) = rotMatrix * u;
   }
 
 
@@ -149,26 +105,8 @@ namespace OpenMD {
 
 
   void RBCOMVisitor::visit(RigidBody* rb){
-    AtomData* atomData;
-    AtomInfo* atomInfo;
-    Vector3d pos;
-    pos = rb->getPos();
-
-    atomInfo = new AtomInfo;
-    atomInfo->atomTypeName = "X";
-    atomInfo->pos[0] = pos[0];
-    atomInfo->pos[1] = pos[1];
-    atomInfo->pos[2] = pos[2];
-    atomInfo->vec[0] = 0;
-    atomInfo->vec[1] = 0;
-    atomInfo->vec[2] = 0;
-
-    atomData = new AtomData; 
-    atomData->setID("ATOMDATA");
-    atomData->addAtomInfo(atomInfo);
-
-    rb->addProperty(atomData);
-
+    int row = sites_->addSite(rb, "X");
+    sites_->getPos(row) = rb->getPos();
   }
 
 
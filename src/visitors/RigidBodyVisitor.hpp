@@ -57,9 +57,13 @@ namespace OpenMD {
     using BaseVisitor::visit;
 
   protected:
-    BaseRigidBodyVisitor(SimInfo* info) : BaseVisitor(){ this->info = info;}
+    BaseRigidBodyVisitor(SimInfo* info) : BaseVisitor(){ 
+      this->info = info;
+      sites_ = SiteData::getSiteData(info);
+    }
 
     SimInfo* info;
+    SiteData* sites_;
   };
 
 
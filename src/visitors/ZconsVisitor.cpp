@@ -51,6 +51,7 @@ namespace OpenMD {
 					      zconsReader_(NULL), info_(info){
     
     visitorName = "ZConsVisitor";
+    sites_ = SiteData::getSiteData(info_);
     currSnapshot_ = info_->getSnapshotManager()->getCurrentSnapshot();
     Globals* simParam = info_->getSimParams();
 
@@ -168,23 +169,9 @@ namespace OpenMD {
   }
 
   void ZConsVisitor::internalVisit(StuntDouble* sd, const std::string& prefix){
-    GenericData* data;
-    AtomData* atomData;
-    AtomInfo* atomInfo;
-    std::vector<AtomInfo*>::iterator iter;
-
-    //if there is not atom data, just skip it
-    data = sd->getPropertyByName("ATOMDATA");
-    if(data != NULL){
-      atomData = dynamic_cast<AtomData*>(data);  
-      if(atomData == NULL)
-	return;
-    }
-    else
-      return;
-
-    for(atomInfo  = atomData->beginAtomInfo(iter); atomInfo; atomInfo = atomData->nextAtomInfo(iter))
-      (atomInfo->atomTypeName).insert(0, prefix);
+    for (int row = sites_->beginSite(sd); row != -1; 
+         row = sites_->nextSite(row))
+      sites_->getTypeName(row).insert(0, prefix);
   }
 
 
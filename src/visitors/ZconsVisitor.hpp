@@ -86,6 +86,7 @@ namespace OpenMD {
     std::string zconsFilename_;
     ZConsReader* zconsReader_;
     SimInfo* info_;
+    SiteData* sites_;
     Snapshot* currSnapshot_;
     std::map<int, int> zatomToZmol_;
   };